@@ -54,7 +54,17 @@ static const char* measureToName[] = {
 		/*[TIREX_VERSION_MEASURE] =*/"version",
 		/*[TIREX_INVOCATION] =*/"invocation",
 		/*[TIREX_DEVCONTAINER_CONF_PATHS] =*/"devcontainer configuration paths",
-		/*[TIREX_CPU_TEMPERATURE_CELSIUS] =*/"cpu temperature celsius"
+		/*[TIREX_CPU_TEMPERATURE_CELSIUS] =*/"cpu temperature celsius",
+		/*[TIREX_TRACKER_JITTER_US] =*/"tracker jitter us",
+		/*[TIREX_TRACKER_MISSED_DEADLINES] =*/"tracker missed deadlines",
+		/*[TIREX_TRACKER_STEP_OVERRUNS] =*/"tracker step overruns",
+		/*[TIREX_TRACKER_DROPPED_SAMPLES] =*/"tracker dropped samples",
+		/*[TIREX_TRACKER_SPANS] =*/"tracker spans",
+		/*[TIREX_TRACKER_CPU_TIME_US] =*/"tracker cpu time",
+		/*[TIREX_TRACKER_STEP_LATENCY_US] =*/"tracker step latency",
+		/*[TIREX_TRACKER_SYSCALLS_PER_TICK] =*/"tracker syscalls per tick",
+		/*[TIREX_TRACKER_MEMORY_KB] =*/"tracker memory",
+		/*[TIREX_TRACKER_ISOLATION] =*/"tracker isolation"
 };
 static_assert((sizeof(measureToName) / sizeof(*measureToName)) == TIREX_MEASURE_COUNT);
 
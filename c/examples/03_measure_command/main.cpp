@@ -68,7 +68,18 @@ static std::map<std::string, std::vector<tirexMeasureConf>> confGroups = {
 		  {TIREX_GPU_VRAM_USED_SYSTEM_MB, TIREX_AGG_NO},
 		  {TIREX_GPU_VRAM_AVAILABLE_SYSTEM_MB, TIREX_AGG_NO}}},
 		{"devcontainer", {{TIREX_DEVCONTAINER_CONF_PATHS, TIREX_AGG_NO}}},
-		{"temperature", {{TIREX_CPU_TEMPERATURE_CELSIUS, TIREX_AGG_MEAN}}}
+		{"temperature", {{TIREX_CPU_TEMPERATURE_CELSIUS, TIREX_AGG_MEAN}}},
+		{"tracker",
+		 {{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX},
+		  {TIREX_TRACKER_MISSED_DEADLINES, TIREX_AGG_NO},
+		  {TIREX_TRACKER_STEP_OVERRUNS, TIREX_AGG_NO},
+		  {TIREX_TRACKER_DROPPED_SAMPLES, TIREX_AGG_NO},
+		  {TIREX_TRACKER_SPANS, TIREX_AGG_NO},
+		  {TIREX_TRACKER_CPU_TIME_US, TIREX_AGG_NO},
+		  {TIREX_TRACKER_STEP_LATENCY_US, TIREX_AGG_NO},
+		  {TIREX_TRACKER_SYSCALLS_PER_TICK, TIREX_AGG_NO},
+		  {TIREX_TRACKER_MEMORY_KB, TIREX_AGG_NO},
+		  {TIREX_TRACKER_ISOLATION, TIREX_AGG_NO}}}
 };
 
 static void logCallback(tirexLogLevel level, const char* component, const char* message) {
@@ -112,14 +123,17 @@ static int runMeasureCmd(const MeasureCmdArgs& args) {
 	}
 	measures.emplace_back(tirexNullConf);
 
-	// Fetch info
-	tirexResult* info;
-	tirexError err = tirexFetchInfo(measures.data(), &info);
+	// Fetch info and start tracking with the same providers
+	tirexTrackingConf* conf;
+	tirexError err = tirexTrackingConfCreate(&conf);
 	assert(err == TIREX_SUCCESS);
-
+	err = tirexTrackingConfSetPollInterval(conf, args.pollIntervalMs * 1000);
+	assert(err == TIREX_SUCCESS);
+	tirexResult* info;
 	tirexMeasureHandle* handle;
-	err = tirexStartTracking(measures.data(), args.pollIntervalMs, &handle);
+	err = tirexStartTrackingWithInfo(measures.data(), conf, &info, &handle);
 	assert(err == TIREX_SUCCESS);
+	tirexTrackingConfFree(conf);
 
 	// Run the command
 	auto exitcode = runCommand(args.command);
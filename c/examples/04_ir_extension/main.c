@@ -88,12 +88,8 @@ int main(int argc, char* argv[]) {
 	};
 	tirexSetLogCallback(logcallback);
 
-	// Print information about the system (e.g., OS Information, HW Specs, ...)
-	if (tirexFetchInfo(providers, &info) != TIREX_SUCCESS)
-		abort();
-
-	// Track metadata
-	if (tirexStartTracking(providers, 100, &measure) != TIREX_SUCCESS)
+	// Collect information about the system (e.g., OS Information, HW Specs, ...) and track metadata
+	if (tirexStartTrackingWithInfo(providers, NULL, &info, &measure) != TIREX_SUCCESS)
 		abort();
 	{
 		char* data = calloc(24 * 1000 * 1000, 1);	  // allocate 24 MB
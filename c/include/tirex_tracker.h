@@ -173,6 +173,58 @@ typedef enum tirexMeasure_enum {
 	 */
 	TIREX_CPU_TEMPERATURE_CELSIUS = 51,
 
+	/**
+	 * @brief How late (in microseconds) the tracker woke up to take samples with respect to its schedule, tracked as
+	 * a time series (with minimum, maximum, and average) over the tracked period (Measurement).
+	 */
+	TIREX_TRACKER_JITTER_US = 52,
+	/**
+	 * @brief The number of sampling deadlines that the tracker skipped because taking the previous sample took longer
+	 * than the poll interval (Measurement).
+	 */
+	TIREX_TRACKER_MISSED_DEADLINES = 53,
+	/**
+	 * @brief The number of steps per data provider that were dropped because the provider was still busy with its
+	 * previous step (Measurement).
+	 */
+	TIREX_TRACKER_STEP_OVERRUNS = 54,
+	/**
+	 * @brief The number of samples that were not delivered to the sample callback since it did not keep up with the
+	 * sampling (Measurement).
+	 */
+	TIREX_TRACKER_DROPPED_SAMPLES = 55,
+	/**
+	 * @brief The tree of spans (see tirexSpanBegin) with the measures collected within each span as a JSON array
+	 * (Measurement).
+	 */
+	TIREX_TRACKER_SPANS = 56,
+	/**
+	 * @brief The CPU time (user and system, in microseconds) that the tracker's own threads, i.e., the monitor thread
+	 * and the threads polling the data providers, spent during the tracked period (Measurement).
+	 */
+	TIREX_TRACKER_CPU_TIME_US = 57,
+	/**
+	 * @brief The distribution of the time (in microseconds) each data provider took to take a sample during the tracked
+	 * period as a JSON object mapping the provider's name to the count, mean, min, max, and quantiles (Measurement).
+	 */
+	TIREX_TRACKER_STEP_LATENCY_US = 58,
+	/**
+	 * @brief The average number of reading and writing system calls that the data providers issued per sampling tick
+	 * during the tracked period (Measurement). Only available on Linux.
+	 */
+	TIREX_TRACKER_SYSCALLS_PER_TICK = 59,
+	/**
+	 * @brief The memory (in KiB) that the tracker held for the samples of the measurement (i.e., its time series)
+	 * when it was stopped (Measurement).
+	 */
+	TIREX_TRACKER_MEMORY_KB = 60,
+	/**
+	 * @brief The isolation settings of the tracker's threads (see tirexTrackingConfSetCpuAffinity) that were in effect
+	 * when the measurement was stopped, together with the settings that could not be applied, as a JSON object
+	 * (Measurement).
+	 */
+	TIREX_TRACKER_ISOLATION = 61,
+
 	/**
 	 * @brief The total number of supported measures.
 	 * @details It can be assumed that every number in the range `[0, TIREX_MEASURE_COUNT]` is a valid enum value.
@@ -288,8 +340,13 @@ TIREX_TRACKER_EXPORT void tirexResultFree(tirexResult* result);
  * @brief 
  */
 typedef struct tirexMeasureConf_st {
-	tirexMeasure source;		/**< @brief The measurement to be configured. **/
-	tirexAggregateFn aggregate; /**< @brief The type of aggregation to use. **/
+	tirexMeasure source; /**< @brief The measurement to be configured. **/
+	/**
+	 * @brief How the samples of a time series are merged once it is batched: TIREX_AGG_MAX, TIREX_AGG_MIN, or
+	 * TIREX_AGG_MEAN. Any other value (e.g., TIREX_AGG_NO) keeps the measure's default aggregation. The batching
+	 * itself is configured via tirexTrackingConfSetSeries.
+	 */
+	tirexAggregateFn aggregate;
 } tirexMeasureConf;
 
 /**
@@ -325,6 +382,411 @@ TIREX_TRACKER_EXPORT tirexError tirexFetchInfo(const tirexMeasureConf* measures,
 TIREX_TRACKER_EXPORT tirexError
 tirexStartTracking(const tirexMeasureConf* measures, size_t pollIntervalMs, tirexMeasureHandle** handle);
 
+/**
+ * @brief Like tirexStartTracking but takes the poll interval in microseconds.
+ * @details Samples are taken at absolute deadlines (i.e., the i-th sample is scheduled for `start + i * interval`)
+ * such that the time needed to take a sample does not add up. This allows for poll intervals below one millisecond,
+ * e.g., for short running workloads.
+ *
+ * @param measures
+ * @param pollIntervalUs The interval in microseconds at which samples should be taken.
+ * @param[out] handle a handle to the running measurement.
+ * @return TIREX_SUCCESS on success or an error code.
+ *
+ * @see tirexStartTracking
+ * @see tirexStopTracking
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexStartTrackingUs(const tirexMeasureConf* measures, size_t pollIntervalUs, tirexMeasureHandle** handle);
+
+/**
+ * @brief Holds the configuration of how a measurement is carried out (e.g., the poll intervals).
+ * @details A tracking configuration is created with tirexTrackingConfCreate, modified through the
+ * `tirexTrackingConfSet*` functions and must be freed by the caller using tirexTrackingConfFree. It is only read by
+ * tirexStartTrackingWithConf and may thus be freed (or reused) once the tracking was started.
+ *
+ * @see tirexStartTrackingWithConf
+ */
+typedef struct tirexTrackingConf_st tirexTrackingConf;
+
+/**
+ * @brief Creates a new tracking configuration with default settings (i.e., a poll interval of 100 milliseconds for
+ * all providers).
+ *
+ * @param[out] conf The newly created configuration. Must be freed using tirexTrackingConfFree.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfCreate(tirexTrackingConf** conf);
+
+/**
+ * @brief Frees the tracking configuration pointed at by \p conf.
+ *
+ * @param conf The configuration to be freed.
+ */
+TIREX_TRACKER_EXPORT void tirexTrackingConfFree(tirexTrackingConf* conf);
+
+/**
+ * @brief Sets the poll interval of all providers that are not configured individually.
+ *
+ * @param conf The configuration to modify.
+ * @param pollIntervalUs The poll interval in microseconds. Must be greater than zero.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetPollInterval(tirexTrackingConf* conf, size_t pollIntervalUs);
+
+/**
+ * @brief Sets an individual poll interval for the data provider with the given name.
+ * @details This allows to sample cheap data sources densely and expensive ones (e.g., GPU queries) sparsely. The
+ * provider is scheduled independently of the others, i.e., it only wakes up at its own deadlines. If the interval is
+ * zero, the provider is not polled at all during the measurement and only reports what it collects on start and stop.
+ *
+ * @param conf The configuration to modify.
+ * @param provider The name of the provider as reported by tirexDataProviderGetAll.
+ * @param pollIntervalUs The poll interval in microseconds.
+ * @return TIREX_SUCCESS on success or TIREX_INVALID_ARGUMENT if \p provider does not name a data provider.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexTrackingConfSetProviderInterval(tirexTrackingConf* conf, const char* provider, size_t pollIntervalUs);
+
+/**
+ * @brief The scheduling policy of the tracker's threads (see tirexTrackingConfSetSchedPolicy).
+ */
+typedef enum tirexSchedPolicy_enum {
+	/** @brief Keep the scheduling policy that the threads inherited from the process. */
+	TIREX_SCHED_DEFAULT = 0,
+	/** @brief Only run the tracker on cores that would otherwise be idle (`SCHED_IDLE` on Linux). */
+	TIREX_SCHED_IDLE = 1,
+	/** @brief Run the tracker with real-time priority for more precise sampling (`SCHED_FIFO` on Linux). */
+	TIREX_SCHED_FIFO = 2,
+} tirexSchedPolicy;
+static_assert(sizeof(tirexSchedPolicy) == 4);
+
+/**
+ * @brief Pins the tracker's threads (i.e., the monitor thread and the threads polling the data providers) to the
+ * given cores.
+ * @details By default, the tracker's threads may run on any core and thus wake up on cores that the tracked workload
+ * is using, which adds noise to, e.g., latency benchmarks. Pinning them to a set of housekeeping cores that the
+ * workload does not use avoids this. The tracker's threads are shared between all running measurements, so the
+ * isolation settings (this function, tirexTrackingConfSetSchedPolicy, and tirexTrackingConfSetTimerSlack) of the most
+ * recently started measurement that sets any of them apply to all measurements. The settings in effect are reported
+ * as TIREX_TRACKER_ISOLATION.
+ *
+ * @param conf The configuration to modify.
+ * @param cpus The indices of the cores the tracker may run on.
+ * @param numCpus The number of entries in \p cpus. If zero, the tracker's threads are not pinned.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexTrackingConfSetCpuAffinity(tirexTrackingConf* conf, const size_t* cpus, size_t numCpus);
+
+/**
+ * @brief Sets the scheduling policy of the tracker's threads (see tirexTrackingConfSetCpuAffinity).
+ * @details TIREX_SCHED_FIFO usually requires elevated privileges (e.g., `CAP_SYS_NICE` on Linux). If the policy can
+ * not be applied, a warning is logged and the threads keep their previous policy.
+ *
+ * @param conf The configuration to modify.
+ * @param policy The scheduling policy to use.
+ * @param priority The real-time priority to use with TIREX_SCHED_FIFO (1 to 99 on Linux). Must be 0 otherwise.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexTrackingConfSetSchedPolicy(tirexTrackingConf* conf, tirexSchedPolicy policy, int priority);
+
+/**
+ * @brief Sets by how much the kernel may delay the wakeups of the tracker's threads to coalesce them with other
+ * timers (`PR_SET_TIMERSLACK`, Linux only; see tirexTrackingConfSetCpuAffinity).
+ * @details A small slack makes the sampling more precise while a large slack reduces the number of wakeups.
+ *
+ * @param conf The configuration to modify.
+ * @param timerSlackNs The timer slack in nanoseconds. Must be greater than zero.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetTimerSlack(tirexTrackingConf* conf, size_t timerSlackNs);
+
+/**
+ * @brief Lets the poll interval of every provider adapt to the samples it collects.
+ * @details While a provider's samples are stable (i.e., none of its measures changed by more than \p tolerance
+ * relative to the previous sample), its poll interval is doubled after every sample up to \p maxIntervalUs. As soon as
+ * a sample changes, the provider falls back to its regular poll interval (see tirexTrackingConfSetPollInterval and
+ * tirexTrackingConfSetProviderInterval). Triggers (see tirexTrackingConfAddTrigger) switch it to \p minIntervalUs for
+ * a while. This spends few samples on long steady phases but still resolves short spikes. The regular interval is
+ * clamped to the bounds as well. If concurrent measurements configure a provider differently, their configurations
+ * are merged such that the bounds of each hold (the shortest minimum and maximum interval, the smallest tolerance,
+ * and the triggers of all of them) until they are stopped.
+ *
+ * @param conf The configuration to modify.
+ * @param minIntervalUs The shortest poll interval in microseconds (used while a trigger fired). Must be greater than
+ * zero.
+ * @param maxIntervalUs The longest poll interval in microseconds. Must not be smaller than \p minIntervalUs.
+ * @param tolerance The relative change (e.g., 0.05 for 5%) up to which consecutive samples are considered stable.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetAdaptive(
+		tirexTrackingConf* conf, size_t minIntervalUs, size_t maxIntervalUs, double tolerance
+);
+
+/**
+ * @brief The conditions under which a trigger fires (see tirexTrackingConfAddTrigger).
+ */
+typedef enum tirexTriggerCondition_enum {
+	/** @brief The value of the measure exceeds the threshold. */
+	TIREX_TRIGGER_ABOVE = 0,
+	/** @brief The value of the measure falls below the threshold (e.g., the CPU utilization drops). */
+	TIREX_TRIGGER_BELOW = 1,
+	/** @brief The value of the measure grows faster than the threshold per second (e.g., the RSS jumps). */
+	TIREX_TRIGGER_RISE = 2,
+} tirexTriggerCondition;
+static_assert(sizeof(tirexTriggerCondition) == 4);
+
+/**
+ * @brief Adds a trigger that switches the provider of \p measure to the minimum poll interval of the adaptive sampling
+ * (see tirexTrackingConfSetAdaptive) whenever it fires.
+ * @details The provider is polled at the minimum interval until the trigger did not fire for \p holdUs and returns
+ * to its regular interval afterwards. Triggers only take effect if adaptive sampling is enabled.
+ *
+ * @param conf The configuration to modify.
+ * @param measure The sampled measure to watch (e.g., TIREX_RAM_USED_PROCESS_KB).
+ * @param condition When the trigger fires.
+ * @param threshold The threshold in the unit of \p measure (per second for TIREX_TRIGGER_RISE).
+ * @param holdUs For how long (in microseconds) the minimum interval is kept after the trigger fired.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfAddTrigger(
+		tirexTrackingConf* conf, tirexMeasure measure, tirexTriggerCondition condition, double threshold, size_t holdUs
+);
+
+/**
+ * @brief How the time series of a measure is stored (see tirexTrackingConfSetSeries).
+ */
+typedef enum tirexSeriesStorage_enum {
+	/** @brief Keep the points compressed, which takes a fraction of the memory (the default). */
+	TIREX_SERIES_COMPRESSED = 0,
+	/** @brief Keep the points uncompressed, which is faster to read but takes more memory. */
+	TIREX_SERIES_PLAIN = 1,
+	/** @brief Keep the points in rings of decreasing resolution, which take constant memory however long the
+	 * measurement runs. The point limit does not apply. */
+	TIREX_SERIES_ROLLUP = 2,
+	/** @brief Keep no points but only report the maximum, minimum, and average of the measure. */
+	TIREX_SERIES_NONE = 3,
+} tirexSeriesStorage;
+static_assert(sizeof(tirexSeriesStorage) == 4);
+
+/**
+ * @brief Configures how the time series of \p measure is recorded by the measurements started with \p conf.
+ * @details By default, samples that are taken within 100ms of each other are merged into a single point (using the
+ * aggregation of tirexMeasureConf::aggregate) once the time series holds 4096 points, and the points are downsampled
+ * to stay within these 4096 points. The points are stored compressed. Regardless of these settings, at most 300
+ * points are exported to the result.
+ *
+ * @param conf The configuration to modify.
+ * @param measure The sampled measure to configure (e.g., TIREX_RAM_USED_PROCESS_KB).
+ * @param batchIntervalMs The interval in milliseconds within which samples are merged into one point. If zero, every
+ * sample is kept (up to the point limit).
+ * @param maxPoints The number of points that are kept at most before the time series is downsampled. Must be at least
+ * 8.
+ * @param storage How the points are stored.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetSeries(
+		tirexTrackingConf* conf, tirexMeasure measure, size_t batchIntervalMs, size_t maxPoints,
+		tirexSeriesStorage storage
+);
+
+/**
+ * @brief Sets which time series are reduced first once the memory budget is exceeded (see
+ * tirexTrackingConfSetMemoryBudget).
+ *
+ * @param conf The configuration to modify.
+ * @param measure The sampled measure to configure (e.g., TIREX_RAM_USED_PROCESS_KB).
+ * @param priority The priority of the measure's time series. Series of a lower priority are reduced first. All
+ * series have priority 0 by default.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexTrackingConfSetSeriesPriority(tirexTrackingConf* conf, tirexMeasure measure, unsigned priority);
+
+/**
+ * @brief Bounds the memory that the time series of each measurement started with \p conf take in total.
+ * @details Once the time series exceed the budget, the largest series of the lowest priority (see
+ * tirexTrackingConfSetSeriesPriority) is halved: every two neighboring buckets of its downsampled points are merged
+ * into one, which keeps the smallest and the largest point of each, and the series keeps at most half as many points
+ * from then on. A series that can not shrink any further (e.g., a rollup series, whose memory is fixed) is dropped and
+ * only its maximum, minimum, and average are reported. Series of a higher priority are only reduced once all series of
+ * a lower priority were dropped. Series are reduced by the thread that records their samples, so a series may exceed
+ * the budget briefly until its next sample. Use tirexTrackingConfSetSampleLog to additionally keep every sample on
+ * disk.
+ *
+ * @param conf The configuration to modify.
+ * @param maxBytes The number of bytes that the time series of a measurement may take in total or 0 to not bound
+ * them.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetMemoryBudget(tirexTrackingConf* conf, size_t maxBytes);
+
+/**
+ * @brief Writes every sample of the measurements started with \p conf to an append-only log file at \p path.
+ * @details Unlike the time series in the result, which are downsampled once they grow large, the log keeps every sample
+ * at full resolution without occupying memory. Each sample is written into a memory-mapped file as soon as it is taken
+ * and committed with the next tick of the sampler, such that every sample but those of the last tick stays readable
+ * even if the process is killed (e.g., by the OOM killer) before tirexStopTracking is called. Unlike the samples
+ * streamed to tirexSetSampleCallback, the log never drops samples (unless the disk is full), regardless of how fast the
+ * callback is or how often it is replaced. Use tirexSampleLogReplay to read the log. The file is truncated when a
+ * measurement starts, so concurrent measurements should log to different files. If the file can not be created, the
+ * measurement runs without a log.
+ *
+ * @param conf The configuration to modify.
+ * @param path The file to write the samples to or NULL to not write a log.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetSampleLog(tirexTrackingConf* conf, const char* path);
+
+/**
+ * @brief Writes the samples of the measurements started with \p conf to a CSV table at \p path, with one row per tick
+ * and one column per sampled measure.
+ * @details All providers that are polled in the same tick stamp their samples with the same time (the tick's
+ * deadline, relative to the start of the measurement), such that, e.g., the CPU and RAM utilization of a tick end up
+ * in the same row. The first column (`timestamp_us`) holds that time in microseconds, the other columns are named by
+ * the numeric value of their tirexMeasure. Cells of measures that were not sampled in a tick (e.g., since their
+ * provider is polled less often) are left empty. The rows are written by the measurement's streaming thread (see
+ * tirexSetSampleCallback) while the measurement is running. If the file can not be created, the measurement runs
+ * without a table.
+ *
+ * @param conf The configuration to modify.
+ * @param path The file to write the table to or NULL to not write a table.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexTrackingConfSetSampleTable(tirexTrackingConf* conf, const char* path);
+
+/**
+ * @brief Like tirexStartTracking but takes a tracking configuration that, e.g., sets individual poll intervals.
+ *
+ * @param measures
+ * @param conf The tracking configuration to use or NULL to use the defaults.
+ * @param[out] handle a handle to the running measurement.
+ * @return TIREX_SUCCESS on success or an error code.
+ *
+ * @see tirexTrackingConfCreate
+ * @see tirexStopTracking
+ */
+TIREX_TRACKER_EXPORT tirexError tirexStartTrackingWithConf(
+		const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexMeasureHandle** handle
+);
+
+/**
+ * @brief Combines tirexFetchInfo and tirexStartTrackingWithConf such that the data providers are only initialized
+ * once.
+ * @details Calling tirexFetchInfo before tirexStartTracking initializes every data provider twice (e.g., opening the
+ * git repository or initializing NVML), which delays the start of the measurement. This function collects the
+ * information with the same provider instances that are then used for the measurement. The information is collected
+ * before the measurement is started, since the providers must not be queried for it while they are sampling.
+ *
+ * @param measures
+ * @param conf The tracking configuration to use or NULL to use the defaults.
+ * @param[out] info a handle to the result tree of the information (see tirexFetchInfo). Must be freed by the caller
+ * using tirexResultFree(tirexResult*)
+ * @param[out] handle a handle to the running measurement.
+ * @return TIREX_SUCCESS on success or an error code.
+ *
+ * @see tirexFetchInfo
+ * @see tirexStartTrackingWithConf
+ */
+TIREX_TRACKER_EXPORT tirexError tirexStartTrackingWithInfo(
+		const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexResult** info, tirexMeasureHandle** handle
+);
+
+/**
+ * @brief Returns the measurements collected so far without stopping the measurement.
+ * @details Sampling continues undisturbed while the snapshot is taken: sampled measures are read from running
+ * aggregates that the data providers publish without locking, i.e., they are reported as their max, min, and avg so
+ * far but without the time series. Measures that are only known once the measurement is stopped (e.g., the stop time
+ * or energy that can only be read at the end) are omitted. This may be called any number of times but not
+ * concurrently to tirexStopTracking on the same handle.
+ *
+ * @param handle The handle of the running measurement.
+ * @param[out] result a handle to the result tree of the snapshot. Must be freed by the caller using
+ * tirexResultFree(tirexResult*)
+ * @return TIREX_SUCCESS on success or an error code.
+ *
+ * @see tirexStopTracking
+ */
+TIREX_TRACKER_EXPORT tirexError tirexPeekTracking(const tirexMeasureHandle* handle, tirexResult** result);
+
+/**
+ * @brief A single sample as it is passed to a tirexSampleCallback.
+ */
+typedef struct tirexSample_st {
+	tirexMeasure source;  /**< The measure that was sampled. */
+	uint64_t timestampUs; /**< When the sample was taken, in microseconds since the measurement started. */
+	tirexResultType type; /**< TIREX_FLOATING if the sample is stored in floating and TIREX_INTEGER otherwise. */
+	union {
+		uint64_t value;	 /**< The sampled value of an integer measure. */
+		double floating; /**< The sampled value of a fractional measure (e.g., the CPU temperature). */
+	};
+} tirexSample;
+
+/**
+ * @brief Receives the samples of a running measurement.
+ * @details The callback is invoked on a thread that is owned by the measurement. The \p sample is only valid for the
+ * duration of the call.
+ */
+typedef void (*tirexSampleCallback)(const tirexSample* sample, void* userdata);
+
+/**
+ * @brief Streams every sample of a running measurement to \p callback as soon as it is taken.
+ * @details The samples are buffered in lock-free ring buffers and delivered in batches by a dedicated thread such that
+ * the sampling is never delayed by the callback. If the callback does not keep up and the buffers run full, samples
+ * are dropped instead and counted as TIREX_TRACKER_DROPPED_SAMPLES. Only the sampled (time series) measures that were
+ * requested for the measurement are streamed. Setting a new callback replaces the previous one after delivering its
+ * remaining samples. This must not be called concurrently to tirexStopTracking on the same handle.
+ *
+ * @param handle The handle of the running measurement.
+ * @param callback The callback to invoke for every sample or NULL to stop streaming.
+ * @param userdata Passed to \p callback as is.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexSetSampleCallback(tirexMeasureHandle* handle, tirexSampleCallback callback, void* userdata);
+
+/**
+ * @brief Reads a sample log (see tirexTrackingConfSetSampleLog) and invokes \p callback for every sample in it.
+ * @details The log may still be written to or may have been left behind by a measurement that crashed, in which case
+ * all samples up to the crash are read. The timestamps are relative to the start of the measurement.
+ *
+ * @param path The log file to read.
+ * @param callback The callback to invoke for every sample (on the calling thread).
+ * @param userdata Passed to \p callback as is.
+ * @return TIREX_SUCCESS on success or TIREX_INVALID_ARGUMENT if \p path is not a sample log.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexSampleLogReplay(const char* path, tirexSampleCallback callback, void* userdata);
+
+/**
+ * @brief Begins a new span, i.e., a named phase of the measurement (e.g., "retrieve"), that is nested into the span
+ * that is currently open (if any).
+ * @details A span collects the measures of the measurement (e.g., elapsed time, energy, and the max/min/avg of sampled
+ * measures) from tirexSpanBegin to the matching tirexSpanEnd. Spans reuse the data providers of the measurement, i.e.,
+ * they neither start new providers nor threads. Sampled measures are only reported as aggregates (without their time
+ * series). The resulting tree of spans is reported as TIREX_TRACKER_SPANS if it was requested. Spans that are still
+ * open when the measurement is stopped are ended implicitly. This must not be called concurrently to other functions
+ * on the same handle.
+ *
+ * @param handle The handle of the running measurement.
+ * @param name The name of the span.
+ * @return TIREX_SUCCESS on success or an error code.
+ *
+ * @see tirexSpanEnd
+ */
+TIREX_TRACKER_EXPORT tirexError tirexSpanBegin(tirexMeasureHandle* handle, const char* name);
+
+/**
+ * @brief Ends the innermost open span of the measurement.
+ *
+ * @param handle The handle of the running measurement.
+ * @return TIREX_SUCCESS on success or TIREX_INVALID_ARGUMENT if there is no open span.
+ *
+ * @see tirexSpanBegin
+ */
+TIREX_TRACKER_EXPORT tirexError tirexSpanEnd(tirexMeasureHandle* handle);
+
 /**
  * @brief Stops the measurement and deinitializes the data providers.
  * @details This function **must** be called **exactly once** for each measurement job.
@@ -337,8 +799,140 @@ tirexStartTracking(const tirexMeasureConf* measures, size_t pollIntervalMs, tire
  * @see tirexStartTracking
  */
 TIREX_TRACKER_EXPORT tirexError tirexStopTracking(tirexMeasureHandle* handle, tirexResult** result);
+
+/**
+ * @brief A reusable setup for many measurements of the same measures.
+ * @details Initializing the data providers (e.g., opening the git repository or initializing NVML) and collecting
+ * their static information is expensive compared to tracking short sections of code. A context does both once: its
+ * providers stay initialized for the context's lifetime and are shared by all measurements started from it, and the
+ * information returned by tirexContextFetchInfo is collected once and cached.
+ */
+typedef struct tirexContext_st tirexContext;
+
+/**
+ * @brief Initializes the data providers for \p measures and collects their static information.
+ *
+ * @param measures The measures that should be tracked by the measurements of the context.
+ * @param conf The tracking configuration that is used for the measurements or NULL to use the defaults.
+ * @param[out] context a handle to the context. Must be freed by the caller using tirexContextFree(tirexContext*)
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError
+tirexContextCreate(const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexContext** context);
+
+/**
+ * @brief Like tirexFetchInfo but returns the information that was cached when the context was created.
+ *
+ * @param context The context to fetch the information of.
+ * @param[out] result a handle to the result tree. Must be freed by the caller using tirexResultFree(tirexResult*)
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexContextFetchInfo(const tirexContext* context, tirexResult** result);
+
+/**
+ * @brief Like tirexStartTrackingWithConf but reuses the providers, measures, and configuration of \p context.
+ * @details The measurement must be stopped with tirexStopTracking before the context is freed. Any number of
+ * measurements may be started from the same context, also concurrently.
+ *
+ * @param context The context to start the measurement in.
+ * @param[out] handle a handle to the running measurement.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexContextStartTracking(const tirexContext* context, tirexMeasureHandle** handle);
+
+/**
+ * @brief Frees the context and deinitializes its data providers unless a measurement still uses them.
+ */
+TIREX_TRACKER_EXPORT void tirexContextFree(tirexContext* context);
 /** @} */ // end of measure
 
+/**
+ * @defgroup region Region Timing
+ * @brief A lightweight alternative to tirexStartTracking for code regions that are entered very often.
+ * @details A region only reads a handful of counters when it is entered and exited: the monotonic clock, the CPU time
+ * of the calling thread and, optionally, the RAPL energy counter. No data providers or threads are started. Instead of
+ * one result per call, the deltas of all calls are accumulated into a fixed-size histogram per measure such that
+ * millions of calls still produce one compact result with the count, mean, min, max and percentiles. Only the
+ * following measures are supported: TIREX_TIME_ELAPSED_WALL_CLOCK_MS, TIREX_TIME_ELAPSED_USER_MS,
+ * TIREX_TIME_ELAPSED_SYSTEM_MS, and TIREX_CPU_ENERGY_SYSTEM_JOULES (Linux with RAPL only).
+ *
+ * A region may be entered concurrently from any number of threads. The CPU time is always that of the thread that
+ * entered the region, so a region must be exited on the same thread.
+ * ```c
+ * tirexRegion* region;
+ * tirexRegionCreate(measures, &region);
+ * for (...) {
+ *     tirexRegionScope scope;
+ *     tirexRegionEnter(region, &scope);
+ *     // hot code
+ *     tirexRegionExit(region, &scope);
+ * }
+ * tirexResult* result;
+ * tirexRegionGetResult(region, &result);
+ * // ...
+ * tirexResultFree(result);
+ * tirexRegionFree(region);
+ * ```
+ * @{
+ */
+typedef struct tirexRegion_st tirexRegion;
+
+/**
+ * @brief The counters read when a region is entered. Owned by the caller such that entering a region never allocates.
+ * @details The fields are an implementation detail and should not be modified.
+ */
+typedef struct tirexRegionScope_st {
+	uint64_t wallNs;
+	uint64_t userNs;
+	uint64_t systemNs;
+	uint64_t energyUj;
+} tirexRegionScope;
+
+/**
+ * @brief Creates a region that accumulates \p measures over all of its calls.
+ *
+ * @param measures The measures to accumulate. Terminated by an entry whose source is TIREX_MEASURE_INVALID.
+ * @param[out] region a handle to the region. Must be freed by the caller using tirexRegionFree(tirexRegion*)
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexRegionCreate(const tirexMeasureConf* measures, tirexRegion** region);
+
+/**
+ * @brief Reads the counters at the start of a call of the region into \p scope.
+ *
+ * @param region The region that is entered.
+ * @param[out] scope Must be passed to tirexRegionExit once the call is done.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexRegionEnter(const tirexRegion* region, tirexRegionScope* scope);
+
+/**
+ * @brief Reads the counters at the end of a call of the region and adds the deltas to \p scope to its histograms.
+ *
+ * @param region The region that is exited.
+ * @param scope The scope that was populated by tirexRegionEnter on the same thread.
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexRegionExit(tirexRegion* region, const tirexRegionScope* scope);
+
+/**
+ * @brief Summarizes all calls of the region so far.
+ * @details Each measure is reported as a JSON object with the number of calls (\c count ) and the \c mean , \c min ,
+ * \c max , \c p50 , \c p90 , and \c p99 of the per-call deltas in the unit of the measure. Percentiles are accurate
+ * to within about 6%. This may be called while other threads are still using the region.
+ *
+ * @param region The region to summarize.
+ * @param[out] result a handle to the result tree. Must be freed by the caller using tirexResultFree(tirexResult*)
+ * @return TIREX_SUCCESS on success or an error code.
+ */
+TIREX_TRACKER_EXPORT tirexError tirexRegionGetResult(const tirexRegion* region, tirexResult** result);
+
+/**
+ * @brief Frees the region. It must not be used (or be entered by any thread) anymore.
+ */
+TIREX_TRACKER_EXPORT void tirexRegionFree(tirexRegion* region);
+/** @} */ // end of region
+
 /**
  * @defgroup dataprovider Data Providers
  * @details Methods and definitions necessary to fetch information about the underlying data sources.
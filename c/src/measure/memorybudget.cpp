@@ -0,0 +1,69 @@
+#include "memorybudget.hpp"
+
+using tirex::MemoryBudget;
+
+MemoryBudget::Entry& MemoryBudget::add(unsigned priority) {
+	std::lock_guard lock(mutex);
+	return entries.emplace_back(priority);
+}
+
+void MemoryBudget::remove(Entry& entry) {
+	std::lock_guard lock(mutex);
+	total.fetch_sub(entry.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	entries.remove_if([&entry](const Entry& other) { return &other == &entry; });
+}
+
+void MemoryBudget::update(Entry& entry, size_t bytes) noexcept {
+	auto previous = entry.bytes.exchange(bytes, std::memory_order_relaxed);
+	// Wraps around if the series shrank, which the addition reverses
+	auto used = total.fetch_add(bytes - previous, std::memory_order_relaxed) + (bytes - previous);
+	if (used > limit)
+		pickVictim();
+}
+
+void MemoryBudget::pickVictim() {
+	std::unique_lock lock(mutex, std::try_to_lock);
+	if (!lock.owns_lock()) // Another thread is picking one already
+		return;
+	// Victims that were picked before but did not act yet will free memory soon (about half of a series that shrinks)
+	size_t pending = 0;
+	for (const auto& entry : entries) {
+		auto bytes = entry.bytes.load(std::memory_order_relaxed);
+		switch (entry.request.load(std::memory_order_relaxed)) {
+		case Request::Shrink:
+			pending += bytes / 2;
+			break;
+		case Request::Drop:
+			pending += bytes;
+			break;
+		case Request::None:
+			break;
+		}
+	}
+	if (used() <= limit + pending)
+		return;
+
+	const Entry* lowest = nullptr;
+	for (const auto& entry : entries) {
+		if (entry.bytes.load(std::memory_order_relaxed) > 0 && (lowest == nullptr || entry.priority < lowest->priority))
+			lowest = &entry;
+	}
+	if (lowest == nullptr)
+		return;
+	// The largest series of the lowest priority is shrunk, or dropped if none of them can shrink any further. If all
+	// of them were picked already, higher priorities are spared until they acted.
+	Entry* shrink = nullptr;
+	Entry* drop = nullptr;
+	for (auto& entry : entries) {
+		if (entry.priority != lowest->priority || entry.request.load(std::memory_order_relaxed) != Request::None)
+			continue;
+		auto bytes = entry.bytes.load(std::memory_order_relaxed);
+		auto& candidate = entry.exhausted.load(std::memory_order_relaxed) ? drop : shrink;
+		if (bytes > 0 && (candidate == nullptr || bytes > candidate->bytes.load(std::memory_order_relaxed)))
+			candidate = &entry;
+	}
+	if (shrink != nullptr)
+		shrink->request.store(Request::Shrink, std::memory_order_relaxed);
+	else if (drop != nullptr)
+		drop->request.store(Request::Drop, std::memory_order_relaxed);
+}
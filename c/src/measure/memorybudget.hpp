@@ -0,0 +1,81 @@
+#ifndef MEASURE_MEMORYBUDGET_HPP
+#define MEASURE_MEMORYBUDGET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+
+namespace tirex {
+	/**
+	 * @brief Bounds the number of bytes that the time series of a measurement occupy in total (see
+	 * tirexTrackingConfSetMemoryBudget).
+	 * @details Every time series registers an entry with the budget and reports its size after each sample (see
+	 * MemoryBudget::update). Once the total exceeds the budget, the budget picks a victim among the series of the
+	 * lowest priority: the largest series that can still shrink is asked to halve its points, and if none of them can,
+	 * the largest is asked to drop its points altogether (keeping only its aggregates). Only series of a higher
+	 * priority are picked once the lower ones are empty.
+	 *
+	 * The series of a measurement are recorded by different threads, each holding only the lock of its own provider.
+	 * Hence, the budget does not modify a series itself but posts the request to the victim's entry, which its owner
+	 * carries out the next time it records a sample (see MemoryBudget::Entry::request). Reporting sizes is lock-free
+	 * and picking a victim never blocks: if another thread is picking one already, the budget is checked again with
+	 * the next sample.
+	 */
+	class MemoryBudget final {
+	public:
+		enum class Request { None, Shrink, Drop };
+
+		/**
+		 * @brief The budget's view on a single time series.
+		 */
+		struct Entry final {
+			const unsigned priority; /**< Series of a lower priority are reduced first. **/
+			std::atomic<size_t> bytes{0};
+			/** @brief What the budget asks the owner to do. The owner resets it once it carried it out. **/
+			std::atomic<Request> request{Request::None};
+			/** @brief Set by the owner once shrinking did not free any memory. **/
+			std::atomic<bool> exhausted{false};
+
+			explicit Entry(unsigned priority) noexcept : priority(priority) {}
+		};
+
+	private:
+		const size_t limit;
+		std::atomic<size_t> total{0};
+		/** @brief Guards MemoryBudget::entries (but not their members, which are atomic). **/
+		std::mutex mutex;
+		std::list<Entry> entries; /**< A list such that the entries do not move. **/
+
+		void pickVictim();
+
+	public:
+		/**
+		 * @param limit The number of bytes that the time series may occupy in total.
+		 */
+		explicit MemoryBudget(size_t limit) noexcept : limit(limit) {}
+		MemoryBudget(const MemoryBudget&) = delete;
+		MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+		/**
+		 * @brief Registers a new (yet empty) time series with the given priority. The entry stays valid until it is
+		 * removed via MemoryBudget::remove.
+		 */
+		Entry& add(unsigned priority);
+		/**
+		 * @brief Unregisters the time series of \p entry, whose bytes no longer count towards the budget.
+		 */
+		void remove(Entry& entry);
+
+		/**
+		 * @brief Reports that the time series of \p entry now occupies \p bytes and picks a victim if the budget is
+		 * exceeded.
+		 */
+		void update(Entry& entry, size_t bytes) noexcept;
+
+		/** @brief The number of bytes that the registered time series occupy in total. */
+		size_t used() const noexcept { return total.load(std::memory_order_relaxed); }
+	};
+} // namespace tirex
+
+#endif
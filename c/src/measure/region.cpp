@@ -0,0 +1,120 @@
+#include "region.hpp"
+
+#include "../logging.hpp"
+#include "utils/threadusage.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#if __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using tirex::Region;
+
+const std::set<tirexMeasure> Region::supportedMeasures{
+		TIREX_TIME_ELAPSED_WALL_CLOCK_MS, TIREX_TIME_ELAPSED_USER_MS, TIREX_TIME_ELAPSED_SYSTEM_MS,
+		TIREX_CPU_ENERGY_SYSTEM_JOULES
+};
+
+/**
+ * @brief Reads the package energy counter of the RAPL powercap interface (Linux only).
+ * @details The file is kept open and re-read with pread, which is considerably cheaper than reopening it on every
+ * call.
+ */
+class Region::RaplCounter final {
+private:
+#if __linux__
+	int fd = -1;
+	uint64_t range = 0; /**< The value at which the counter wraps around. **/
+
+	static uint64_t readValue(int fd) noexcept {
+		char buf[32];
+		auto len = pread(fd, buf, sizeof(buf) - 1, 0);
+		if (len <= 0)
+			return 0;
+		buf[len] = '\0';
+		return std::strtoull(buf, nullptr, 10);
+	}
+
+public:
+	RaplCounter() {
+		static constexpr const char* dir = "/sys/class/powercap/intel-rapl:0/";
+		fd = open((std::string(dir) + "energy_uj").c_str(), O_RDONLY | O_CLOEXEC);
+		if (auto rangefd = open((std::string(dir) + "max_energy_range_uj").c_str(), O_RDONLY | O_CLOEXEC);
+			rangefd >= 0) {
+			range = readValue(rangefd);
+			close(rangefd);
+		}
+	}
+	~RaplCounter() {
+		if (fd >= 0)
+			close(fd);
+	}
+
+	bool available() const noexcept { return fd >= 0; }
+	uint64_t read() const noexcept { return readValue(fd); }
+	uint64_t delta(uint64_t from, uint64_t to) const noexcept { return (to >= from) ? to - from : to + range - from; }
+#else
+public:
+	bool available() const noexcept { return false; }
+	uint64_t read() const noexcept { return 0; }
+	uint64_t delta(uint64_t, uint64_t) const noexcept { return 0; }
+#endif
+};
+
+static uint64_t nowNs() noexcept {
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+Region::Region(std::set<tirexMeasure> requested)
+		: measures(std::move(requested)),
+		  threadTimes(
+				  measures.contains(TIREX_TIME_ELAPSED_USER_MS) || measures.contains(TIREX_TIME_ELAPSED_SYSTEM_MS)
+		  ) {
+	if (measures.contains(TIREX_CPU_ENERGY_SYSTEM_JOULES)) {
+		rapl = std::make_unique<RaplCounter>();
+		if (!rapl->available()) {
+			tirex::log::warn("region", "The RAPL energy counter can not be read, energy will not be reported");
+			rapl.reset();
+		}
+	}
+}
+
+Region::~Region() = default;
+
+void Region::read(tirexRegionScope& scope) const noexcept {
+	if (threadTimes)
+		utils::readThreadTimes(scope.userNs, scope.systemNs);
+	scope.energyUj = (rapl != nullptr) ? rapl->read() : 0;
+	// Read the clock last on enter (and first on exit) such that the other reads are not part of the wall time
+	scope.wallNs = nowNs();
+}
+
+void Region::exit(const tirexRegionScope& scope) noexcept {
+	wallNs.record(nowNs() - scope.wallNs);
+	if (threadTimes) {
+		uint64_t user, system;
+		utils::readThreadTimes(user, system);
+		userNs.record(user - scope.userNs);
+		systemNs.record(system - scope.systemNs);
+	}
+	if (rapl != nullptr)
+		energyUj.record(rapl->delta(scope.energyUj, rapl->read()));
+}
+
+tirex::Stats Region::getStats() const {
+	Stats stats{};
+	if (measures.contains(TIREX_TIME_ELAPSED_WALL_CLOCK_MS))
+		stats.insert_or_assign(TIREX_TIME_ELAPSED_WALL_CLOCK_MS, utils::summarize(wallNs.snapshot(), 1e-6));
+	if (measures.contains(TIREX_TIME_ELAPSED_USER_MS))
+		stats.insert_or_assign(TIREX_TIME_ELAPSED_USER_MS, utils::summarize(userNs.snapshot(), 1e-6));
+	if (measures.contains(TIREX_TIME_ELAPSED_SYSTEM_MS))
+		stats.insert_or_assign(TIREX_TIME_ELAPSED_SYSTEM_MS, utils::summarize(systemNs.snapshot(), 1e-6));
+	if (rapl != nullptr)
+		stats.insert_or_assign(TIREX_CPU_ENERGY_SYSTEM_JOULES, utils::summarize(energyUj.snapshot(), 1e-6));
+	return stats;
+}
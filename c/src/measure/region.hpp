@@ -0,0 +1,55 @@
+#ifndef MEASURE_REGION_HPP
+#define MEASURE_REGION_HPP
+
+#include "stats/provider.hpp"
+#include "utils/histogram.hpp"
+
+#include <tirex_tracker.h>
+
+#include <memory>
+#include <set>
+
+namespace tirex {
+	/**
+	 * @brief Accumulates per-call deltas of a few cheap counters for a code region that is entered very often.
+	 * @details In contrast to a measurement started with tirexStartTracking, a region does not use any data provider
+	 * or thread: entering and exiting only reads the monotonic clock, the calling thread's CPU time, and (if requested)
+	 * the RAPL package energy counter. The deltas are recorded into one utils::LogHistogram per measure.
+	 */
+	class Region final {
+	private:
+		class RaplCounter;
+
+		const std::set<tirexMeasure> measures;
+		const bool threadTimes; /**< Whether the thread's CPU time must be read on enter and exit. **/
+		std::unique_ptr<RaplCounter> rapl;
+		utils::LogHistogram<> wallNs;
+		utils::LogHistogram<> userNs;
+		utils::LogHistogram<> systemNs;
+		utils::LogHistogram<> energyUj;
+
+		void read(tirexRegionScope& scope) const noexcept;
+
+	public:
+		/** @brief The measures a region can accumulate. **/
+		static const std::set<tirexMeasure> supportedMeasures;
+
+		/**
+		 * @param measures The measures to accumulate. Must be a subset of Region::supportedMeasures.
+		 */
+		explicit Region(std::set<tirexMeasure> measures);
+		Region(const Region&) = delete;
+		~Region();
+		Region& operator=(const Region&) = delete;
+
+		void enter(tirexRegionScope& scope) const noexcept { read(scope); }
+		void exit(const tirexRegionScope& scope) noexcept;
+
+		/**
+		 * @brief Summarizes the histograms as one JSON object per measure.
+		 */
+		Stats getStats() const;
+	};
+} // namespace tirex
+
+#endif
@@ -0,0 +1,172 @@
+#include "samplelog.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if __unix__ || __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using tirex::SampleLog;
+
+static SampleLog::Header makeHeader(std::chrono::system_clock::time_point epoch) noexcept {
+	SampleLog::Header header{
+			.magic = {},
+			.version = SampleLog::version,
+			.recordSize = sizeof(SampleLog::Record),
+			.epochUs = static_cast<uint64_t>(
+					std::chrono::duration_cast<std::chrono::microseconds>(epoch.time_since_epoch()).count()
+			),
+			.count = 0,
+			.flags = 0
+	};
+	std::memcpy(header.magic, SampleLog::magic, sizeof(header.magic));
+	return header;
+}
+
+static SampleLog::Record makeRecord(const tirexSample& sample) noexcept {
+	auto floating = sample.type == TIREX_FLOATING;
+	return {.timestampUs = sample.timestampUs,
+			.measure = static_cast<uint32_t>(sample.source),
+			.type = static_cast<uint32_t>(floating ? TIREX_FLOATING : TIREX_INTEGER),
+			.value = floating ? std::bit_cast<uint64_t>(sample.floating) : sample.value};
+}
+
+#if __unix__ || __APPLE__
+std::unique_ptr<SampleLog>
+SampleLog::create(const std::filesystem::path& path, std::chrono::system_clock::time_point epoch) {
+	std::unique_ptr<SampleLog> log{new SampleLog()};
+	log->fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (log->fd < 0 || !log->grow())
+		return nullptr;
+	log->header() = makeHeader(epoch);
+	return log;
+}
+
+SampleLog::~SampleLog() {
+	if (data != nullptr) {
+		commit();
+		header().flags |= closedFlag;
+		munmap(data, sizeof(Header) + capacity * sizeof(Record));
+		// Drop the preallocated but unused tail of the last chunk
+		[[maybe_unused]] auto ret = ftruncate(fd, sizeof(Header) + count * sizeof(Record));
+	}
+	if (fd >= 0)
+		close(fd);
+}
+
+bool SampleLog::grow() noexcept {
+	auto newCapacity = capacity + chunkRecords;
+	auto bytes = sizeof(Header) + newCapacity * sizeof(Record);
+	// The space must be allocated up front since writing to a sparse mapping on a full disk raises SIGBUS
+#if __linux__
+	if (posix_fallocate(fd, 0, bytes) != 0)
+		return false;
+#else
+	if (ftruncate(fd, bytes) != 0)
+		return false;
+#endif
+	auto mapped = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (mapped == MAP_FAILED)
+		return false;
+	if (data != nullptr)
+		munmap(data, sizeof(Header) + capacity * sizeof(Record));
+	data = static_cast<std::byte*>(mapped);
+	capacity = newCapacity;
+	return true;
+}
+
+bool SampleLog::append(const tirexSample& sample) noexcept {
+	std::lock_guard lock(mutex);
+	if (count == capacity && !grow())
+		return false;
+	auto record = makeRecord(sample);
+	std::memcpy(data + sizeof(Header) + count * sizeof(Record), &record, sizeof(Record));
+	++count;
+	return true;
+}
+
+void SampleLog::commit() noexcept {
+	std::lock_guard lock(mutex);
+	// The records must be in place before they are counted
+	std::atomic_ref(header().count).store(count, std::memory_order_release);
+}
+#else
+std::unique_ptr<SampleLog>
+SampleLog::create(const std::filesystem::path& path, std::chrono::system_clock::time_point epoch) {
+	std::unique_ptr<SampleLog> log{new SampleLog()};
+	log->file = std::fopen(path.string().c_str(), "w+b");
+	if (log->file == nullptr)
+		return nullptr;
+	log->header = makeHeader(epoch);
+	log->writeHeader();
+	return log->failed ? nullptr : std::move(log);
+}
+
+SampleLog::~SampleLog() {
+	if (file != nullptr) {
+		header.flags |= closedFlag;
+		commit();
+		std::fclose(file);
+	}
+}
+
+void SampleLog::writeHeader() noexcept {
+	failed |= std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&header, sizeof(Header), 1, file) != 1 ||
+			  std::fseek(file, 0, SEEK_END) != 0;
+}
+
+bool SampleLog::append(const tirexSample& sample) noexcept {
+	std::lock_guard lock(mutex);
+	auto record = makeRecord(sample);
+	if (failed || std::fwrite(&record, sizeof(Record), 1, file) != 1)
+		return false;
+	++count;
+	return true;
+}
+
+void SampleLog::commit() noexcept {
+	std::lock_guard lock(mutex);
+	header.count = count;
+	writeHeader();
+	std::fflush(file);
+}
+#endif
+
+bool SampleLog::replay(const std::filesystem::path& path, tirexSampleCallback callback, void* userdata) {
+	std::ifstream in(path, std::ios::binary);
+	Header header;
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(Header)) ||
+		std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+		header.recordSize != sizeof(Record))
+		return false;
+	// A crashed writer may have committed records whose pages never made it to the file (e.g., on power loss)
+	std::error_code ec;
+	auto available = (std::filesystem::file_size(path, ec) - sizeof(Header)) / sizeof(Record);
+	auto remaining = ec ? 0 : std::min<uint64_t>(header.count, available);
+	std::vector<Record> records(std::min<uint64_t>(remaining, 4096));
+	while (remaining > 0) {
+		auto batch = std::min<uint64_t>(remaining, records.size());
+		if (!in.read(reinterpret_cast<char*>(records.data()), batch * sizeof(Record)))
+			break;
+		for (size_t i = 0; i < batch; ++i) {
+			tirexSample sample{
+					.source = static_cast<tirexMeasure>(records[i].measure),
+					.timestampUs = records[i].timestampUs,
+					.type = static_cast<tirexResultType>(records[i].type),
+					.value = records[i].value
+			};
+			if (sample.type == TIREX_FLOATING)
+				sample.floating = std::bit_cast<double>(records[i].value);
+			callback(&sample, userdata);
+		}
+		remaining -= batch;
+	}
+	return true;
+}
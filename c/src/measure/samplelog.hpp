@@ -0,0 +1,119 @@
+#ifndef MEASURE_SAMPLELOG_HPP
+#define MEASURE_SAMPLELOG_HPP
+
+#include <tirex_tracker.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace tirex {
+	/**
+	 * @brief An append-only file that receives every sample of a measurement at full resolution.
+	 * @details The file starts with a SampleLog::Header followed by fixed-size SampleLog::Record entries. On POSIX
+	 * systems, the file is memory-mapped and grown in chunks of SampleLog::chunkRecords records, such that appending a
+	 * sample is a plain memory store and the log does not occupy the heap regardless of how long the measurement runs.
+	 * Records are only counted in the header once they are committed (see SampleLog::commit). Since the mapping is
+	 * shared with the page cache, everything that was committed survives the process being killed (e.g., by the OOM
+	 * killer) and can be read with SampleLog::replay. The header's SampleLog::closedFlag tells whether the log was
+	 * closed properly. Other platforms write the records through a regular (buffered) file instead.
+	 *
+	 * Appending is thread-safe: the windows of a measurement append their samples right when they are recorded (see
+	 * Window::record), i.e., from the threads of different providers. The sampler's monitor thread commits them once
+	 * per tick.
+	 */
+	class SampleLog final {
+	public:
+		struct Header final {
+			char magic[8];		/**< Always SampleLog::magic. **/
+			uint32_t version;	/**< The version of the format (SampleLog::version). **/
+			uint32_t recordSize; /**< The size of a record in bytes. **/
+			uint64_t epochUs;	/**< Microseconds since the UNIX epoch that timestamps are relative to. **/
+			uint64_t count;		/**< The number of committed records. **/
+			uint64_t flags;
+		};
+		struct Record final {
+			uint64_t timestampUs; /**< Microseconds since Header::epochUs. **/
+			uint32_t measure;
+			uint32_t type; /**< The tirexSample::type of the sample. **/
+			uint64_t value; /**< The value or, for TIREX_FLOATING samples, the bits of the double. **/
+		};
+		static_assert(sizeof(Header) == 40 && sizeof(Record) == 24);
+
+		static constexpr char magic[8]{'T', 'I', 'R', 'E', 'X', 'L', 'O', 'G'};
+		/** @brief Version 1 stored the values as 32-bit integers. **/
+		static constexpr uint32_t version = 2;
+		static constexpr uint64_t closedFlag = 1; /**< Set once the log was closed properly. **/
+		static constexpr size_t chunkRecords = size_t{1} << 16; /**< By how many records the file grows at once. **/
+
+	private:
+		mutable std::mutex mutex; /**< Guards the records and the count of appended records. **/
+		uint64_t count = 0;
+#if __unix__ || __APPLE__
+		int fd = -1;
+		std::byte* data = nullptr;
+		size_t capacity = 0; /**< The number of records that fit into the mapping. **/
+
+		Header& header() noexcept { return *reinterpret_cast<Header*>(data); }
+		bool grow() noexcept;
+#else
+		std::FILE* file = nullptr;
+		Header header{};
+		bool failed = false;
+
+		void writeHeader() noexcept;
+#endif
+
+		SampleLog() = default;
+
+	public:
+		SampleLog(const SampleLog&) = delete;
+		/**
+		 * @brief Commits the remaining records, marks the log as closed, and trims the file to its contents.
+		 */
+		~SampleLog();
+		SampleLog& operator=(const SampleLog&) = delete;
+
+		/**
+		 * @brief Creates (or truncates) the log file at \p path.
+		 *
+		 * @param path The file to write the samples to.
+		 * @param epoch The point in time that the timestamps of the appended samples are relative to.
+		 * @return The log or nullptr if the file could not be created.
+		 */
+		static std::unique_ptr<SampleLog>
+		create(const std::filesystem::path& path, std::chrono::system_clock::time_point epoch);
+
+		/**
+		 * @brief Appends \p sample to the log. It becomes visible to readers once it is committed.
+		 * @details If the file can not be grown anymore (e.g., since the disk is full), the sample is dropped.
+		 *
+		 * @return false if the sample was dropped.
+		 */
+		bool append(const tirexSample& sample) noexcept;
+		/**
+		 * @brief Publishes all records that were appended so far in the header.
+		 */
+		void commit() noexcept;
+
+		/** @brief The number of records that were appended. */
+		uint64_t size() const noexcept {
+			std::lock_guard lock(mutex);
+			return count;
+		}
+
+		/**
+		 * @brief Reads the log at \p path (which may still be written to or may have been left behind by a crashed
+		 * process) and invokes \p callback for every committed record.
+		 *
+		 * @return false if \p path is not a sample log of a supported version.
+		 */
+		static bool replay(const std::filesystem::path& path, tirexSampleCallback callback, void* userdata);
+	};
+} // namespace tirex
+
+#endif
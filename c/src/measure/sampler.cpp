@@ -0,0 +1,317 @@
+#include "sampler.hpp"
+
+#include "../logging.hpp"
+#include "utils/rangeutils.hpp"
+#include "stats/trackerstats.hpp"
+#include "utils/threadusage.hpp"
+
+#include <algorithm>
+
+using tirex::Sampler;
+
+using namespace std::chrono_literals;
+
+Sampler::Sampler() : monitorthread(&Sampler::monitor, this) {}
+
+Sampler::~Sampler() {
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+	cv.notify_one();
+	monitorthread.join();
+	// All subscriptions should be gone by now but stop the remaining providers just in case
+	for (auto& [_, state] : providers) {
+		state.worker.reset();
+		state.provider->stop();
+	}
+}
+
+std::shared_ptr<Sampler> Sampler::acquire() {
+	static std::mutex mutex;
+	static std::weak_ptr<Sampler> instance;
+	std::lock_guard lock(mutex);
+	auto sampler = instance.lock();
+	if (sampler == nullptr) {
+		tirex::log::debug("sampler", "Starting the sampler");
+		sampler = std::make_shared<Sampler>();
+		instance = sampler;
+	}
+	return sampler;
+}
+
+void Sampler::monitor() {
+	auto cpuNs = utils::threadCpuNs();
+	std::unique_lock lock(mutex);
+	auto waitUntil = [&](utils::DeadlineScheduler::clock::time_point deadline) {
+		cv.wait_until(lock, deadline, [this] { return stopping || changed; });
+		changed = false;
+		return !stopping;
+	};
+	std::vector<size_t> due;
+	while (scheduler.wait(waitUntil, due)) {
+		if (isolate)
+			applyIsolation();
+		if (due.empty()) // Woken up since the schedule changed
+			continue;
+		if (trackerStats != nullptr)
+			trackerStats->recordTick(scheduler.tick(), scheduler.lateness(), scheduler.missedDeadlines());
+		for (auto id : due) {
+			auto& state = providers.at(id);
+			// All providers that are due in this tick stamp their samples with the same time
+			state.worker->trigger(scheduler.tick());
+			// The worker updates the adaptive rate after each step, which takes effect from the next deadline on
+			if (state.rate->enabled() && state.rate->interval() != state.period) {
+				state.period = state.rate->interval();
+				scheduler.setPeriod(id, state.period);
+			}
+		}
+		// Publishes the samples up to the previous tick. Committing once per tick instead of after each sample keeps
+		// the file I/O of a log that is not memory-mapped off the providers' steps.
+		for (auto [_, log] : logs)
+			log->commit();
+		++ticks;
+		auto now = utils::threadCpuNs();
+		monitorCpuNs += now - cpuNs;
+		cpuNs = now;
+	}
+}
+
+void Sampler::applyIsolation() {
+	isolate = false;
+	isolationFailures = isolation.apply();
+	if (!isolationFailures.empty())
+		tirex::log::warn("sampler", "Could not apply the isolation settings {}", tirex::utils::join(isolationFailures));
+}
+
+nlohmann::json Sampler::isolationInfo() {
+	std::lock_guard lock(mutex);
+	auto json = isolation.toJson();
+	json["failed"] = isolationFailures;
+	return json;
+}
+
+void Sampler::reschedule(size_t id, ProviderState& state) {
+	scheduler.unschedule(id);
+	if (state.intervals.empty()) {
+		state.worker.reset();
+		state.rate->setBase(0us);
+		return;
+	}
+	if (state.worker == nullptr) {
+		auto provider = state.provider.get();
+		auto task = [provider, rate = state.rate.get()](utils::StepWorker::clock::time_point tick) {
+			provider->stepAt(tick);
+			if (rate->enabled())
+				rate->observe(provider->latestSamples());
+		};
+		state.worker = std::make_unique<utils::StepWorker>(std::move(task), isolation);
+	}
+	state.rate->setBase(*state.intervals.begin());
+	state.period = state.rate->enabled() ? state.rate->interval() : *state.intervals.begin();
+	tirex::log::debug("sampler", "Polling {} every {}us", state.name, state.period.count());
+	scheduler.schedule(id, state.period, utils::DeadlineScheduler::clock::now());
+	changed = true;
+}
+
+void Sampler::configureRate(ProviderState& state) {
+	if (state.adaptive.empty()) {
+		state.rate->disable();
+		return;
+	}
+	std::vector<utils::AdaptiveRate::Config> configs;
+	for (const auto& [_, config] : state.adaptive)
+		configs.push_back(config);
+	state.rate->configure(utils::AdaptiveRate::merge(configs));
+}
+
+void Sampler::requestMeasures(ProviderState& state) {
+	std::set<tirexMeasure> measures;
+	for (const auto& [_, requested] : state.requested)
+		measures.insert(requested.begin(), requested.end());
+	state.provider->requestMeasures(measures);
+}
+
+void Sampler::updateOverhead() {
+	if (trackerStats == nullptr)
+		return;
+	trackerStats->recordMonitor(ticks, monitorCpuNs);
+	for (auto& [_, state] : providers) {
+		if (state.worker != nullptr) {
+			auto usage = state.worker->usage();
+			trackerStats->recordProvider(
+					state.name, {.overruns = state.worker->overruns(),
+								 .cpuNs = usage.cpuNs,
+								 .syscalls = usage.syscalls,
+								 .latencyNs = state.worker->latency()}
+			);
+		}
+	}
+}
+
+std::set<tirexMeasure> Sampler::withoutProvider(const std::set<tirexMeasure>& measures) {
+	std::lock_guard lock(mutex);
+	std::set<tirexMeasure> missing;
+	auto unmatched = measures;
+	for (auto& [name, info] : tirex::providers) {
+		std::set<tirexMeasure> diff;
+		std::set_difference(
+				unmatched.begin(), unmatched.end(), info.measures.begin(), info.measures.end(),
+				std::inserter(diff, diff.begin())
+		);
+		auto running = std::any_of(providers.begin(), providers.end(), [&name](const auto& entry) {
+			return entry.second.name == name;
+		});
+		if (!running) // The measures that this provider is responsible for
+			std::set_difference(
+					unmatched.begin(), unmatched.end(), diff.begin(), diff.end(), std::inserter(missing, missing.end())
+			);
+		unmatched = std::move(diff);
+	}
+	return missing;
+}
+
+std::map<size_t, Sampler::ProviderState>::iterator
+Sampler::adopt(std::string_view name, std::unique_ptr<StatsProvider>&& provider) {
+	auto it = std::find_if(providers.begin(), providers.end(), [name](const auto& entry) {
+		return entry.second.name == name;
+	});
+	if (it != providers.end())
+		return it;
+	provider->start();
+	if (auto tracker = dynamic_cast<TrackerStats*>(provider.get()); tracker != nullptr)
+		trackerStats = tracker;
+	return providers.emplace(nextId++, ProviderState{.name = name, .provider = std::move(provider)}).first;
+}
+
+std::set<tirexMeasure> Sampler::subscribe(
+		const std::set<tirexMeasure>& measures, const tirexTrackingConf& conf, Subscription& subscription
+) {
+	// Initializing a provider may take a while (e.g., NVML), so the missing ones are initialized in parallel and
+	// without holding the lock, which would stall the monitor thread and all other subscriptions in the meantime
+	ProviderList initialized;
+	tirex::initProviders(withoutProvider(measures), initialized);
+	std::lock_guard lock(mutex);
+	for (auto& [name, provider] : initialized)
+		adopt(name, std::move(provider));
+
+	if (!conf.isolation.empty() && conf.isolation != isolation) {
+		isolation = conf.isolation;
+		isolate = changed = true; // The monitor thread applies the settings to itself once it is notified
+		for (auto& [_, state] : providers) {
+			if (state.worker != nullptr)
+				state.worker->isolate(isolation);
+		}
+	}
+
+	// Make sure that all providers responsible for the measures are running
+	auto unmatched = measures;
+	auto first = subscription.windows.size();
+	std::vector<bool> rescheduled; // Whether the i-th needed provider was rescheduled (and is thus due immediately)
+	for (auto& [name, info] : tirex::providers) {
+		std::set<tirexMeasure> diff;
+		std::set_difference(
+				unmatched.begin(), unmatched.end(), info.measures.begin(), info.measures.end(),
+				std::inserter(diff, diff.begin())
+		);
+		if (diff.size() == unmatched.size()) // The provider is not responsible for any of the requested measures
+			continue;
+		unmatched = std::move(diff);
+
+		auto it = std::find_if(providers.begin(), providers.end(), [&name](const auto& entry) {
+			return entry.second.name == name;
+		});
+		// Only initialized here if the running instance was stopped since the missing ones were determined
+		if (it == providers.end())
+			it = adopt(name, info.constructor());
+		auto& [id, state] = *it;
+		state.requested[&subscription].insert(measures.begin(), measures.end());
+		requestMeasures(state);
+		if (conf.adaptive) {
+			state.adaptive.insert_or_assign(&subscription, *conf.adaptive);
+			configureRate(state);
+		}
+		auto interval = conf.intervalFor(name);
+		auto previous = state.intervals.empty() ? 0us : *state.intervals.begin();
+		if (interval.count() > 0)
+			state.intervals.insert(interval);
+		rescheduled.push_back(!state.intervals.empty() && *state.intervals.begin() != previous);
+		if (rescheduled.back())
+			reschedule(id, state);
+		++state.subscribers;
+		subscription.windows.push_back(
+				{.providerId = id, .provider = state.provider.get(), .interval = interval, .window = nullptr}
+		);
+	}
+	updateOverhead();
+
+	if (subscription.log != nullptr)
+		logs.insert_or_assign(&subscription, subscription.log);
+
+	// Open the windows, whose time series share the measurement's memory budget
+	auto budget = (conf.memoryBudget > 0) ? std::make_shared<MemoryBudget>(conf.memoryBudget) : nullptr;
+	for (size_t i = 0; i < rescheduled.size(); ++i) {
+		auto& entry = subscription.windows[first + i];
+		auto& state = providers.at(entry.providerId);
+		entry.window = state.provider->openWindow(
+				measures, subscription.epoch, true, conf.series, budget, subscription.log
+		);
+		// Take a first sample for the new window right away (rescheduled providers are due immediately anyway)
+		if (!rescheduled[i] && state.worker != nullptr)
+			state.worker->trigger();
+	}
+	if (changed)
+		cv.notify_one();
+	return unmatched;
+}
+
+void Sampler::retain(ProviderList&& adopted, Subscription& subscription) {
+	std::lock_guard lock(mutex);
+	for (auto& [name, provider] : adopted) {
+		auto& [id, state] = *adopt(name, std::move(provider));
+		++state.subscribers;
+		subscription.windows.push_back(
+				{.providerId = id, .provider = state.provider.get(), .interval = 0us, .window = nullptr}
+		);
+	}
+}
+
+void Sampler::unsubscribe(Subscription& subscription) {
+	std::vector<ProviderState> retired;
+	{
+		std::lock_guard lock(mutex);
+		updateOverhead();
+		logs.erase(&subscription); // The remaining samples are committed once the log is closed
+		for (auto& [id, provider, interval, window] : subscription.windows) {
+			auto it = providers.find(id);
+			auto& state = it->second;
+			if (window != nullptr)
+				provider->closeWindow(*window);
+			if (--state.subscribers == 0) {
+				scheduler.unschedule(id);
+				if (state.provider.get() == trackerStats)
+					trackerStats = nullptr;
+				retired.emplace_back(std::move(state));
+				providers.erase(it);
+			} else {
+				auto previous = state.intervals.empty() ? 0us : *state.intervals.begin();
+				if (interval.count() > 0)
+					state.intervals.erase(state.intervals.find(interval));
+				if (state.requested.erase(&subscription) > 0)
+					requestMeasures(state);
+				auto reconfigured = state.adaptive.erase(&subscription) > 0;
+				if (reconfigured)
+					configureRate(state);
+				auto current = state.intervals.empty() ? 0us : *state.intervals.begin();
+				if (current != previous || (reconfigured && current.count() > 0))
+					reschedule(id, state);
+			}
+		}
+	}
+	cv.notify_one();
+	// Stop the providers outside of the lock since waiting for their last step may take a while
+	for (auto& state : retired) {
+		state.worker.reset();
+		state.provider->stop();
+	}
+}
@@ -0,0 +1,166 @@
+#ifndef MEASURE_SAMPLER_HPP
+#define MEASURE_SAMPLER_HPP
+
+#include "../trackingconf.hpp"
+#include "stats/provider.hpp"
+#include "utils/adaptiverate.hpp"
+#include "utils/deadlinescheduler.hpp"
+#include "utils/threadisolation.hpp"
+#include "utils/stepworker.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tirex {
+	class TrackerStats;
+
+	/**
+	 * @brief The process-wide sampler that polls the providers for all measurements that are currently running.
+	 * @details Concurrent measurements (e.g., nested or overlapping tracking regions) share a single sampler, such that
+	 * every provider is instantiated and polled only once regardless of the number of measurements. Each measurement
+	 * subscribes to the sampler, which opens a Window on each provider the measurement needs. A provider is started
+	 * when the first subscription needs it and stopped when the last one that needed it is gone. If multiple
+	 * subscriptions request different poll intervals for a provider, it is polled at the shortest one. Likewise, their
+	 * adaptive sampling configurations are merged such that the bounds of each of them hold.
+	 *
+	 * The sampler itself is reference counted and obtained via Sampler::acquire. It is destroyed (and its monitor
+	 * thread is joined) once no measurement holds a reference anymore.
+	 */
+	class Sampler final {
+	public:
+		/**
+		 * @brief A single measurement's subscription to the sampler, i.e., its windows on the providers it needs.
+		 */
+		struct Subscription final {
+			/** @brief The timestamps of all windows are relative to this (e.g., the start of the measurement). **/
+			std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+			struct Entry {
+				size_t providerId;
+				StatsProvider* provider; /**< Valid until the subscription is unsubscribed. **/
+				std::chrono::microseconds interval;
+				std::unique_ptr<Window> window;
+			};
+			std::vector<Entry> windows;
+			/**
+			 * @brief Receives every sample of the windows (if set), which is committed with the next tick. It must
+			 * outlive the subscription.
+			 */
+			SampleLog* log = nullptr;
+		};
+
+	private:
+		struct ProviderState {
+			std::string_view name;
+			std::unique_ptr<StatsProvider> provider;
+			std::unique_ptr<utils::StepWorker> worker;
+			/** @brief The intervals requested by the subscriptions. The provider is polled at the shortest one. **/
+			std::multiset<std::chrono::microseconds> intervals;
+			size_t subscribers = 0;
+			/** @brief Adapts the poll interval to the samples if a subscription enabled adaptive sampling. **/
+			std::unique_ptr<utils::AdaptiveRate> rate = std::make_unique<utils::AdaptiveRate>();
+			/** @brief The adaptive sampling configured by each subscription, which ProviderState::rate merges. **/
+			std::map<const Subscription*, utils::AdaptiveRate::Config> adaptive;
+			/** @brief The measures requested by each subscription. The provider is only enabled for their union. **/
+			std::map<const Subscription*, std::set<tirexMeasure>> requested;
+			std::chrono::microseconds period{0}; /**< The period at which the provider is currently scheduled. **/
+		};
+
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool stopping = false;
+		bool changed = false; /**< Set if the schedule was changed while the monitor thread was waiting. **/
+		size_t nextId = 0;
+		std::map<size_t, ProviderState> providers;
+		/** @brief The logs of the current subscriptions, which the monitor thread commits once per tick. **/
+		std::map<const Subscription*, SampleLog*> logs;
+		TrackerStats* trackerStats = nullptr; /**< Receives the monitor thread's ticks if it was requested. **/
+		size_t ticks = 0;		   /**< The number of ticks the monitor thread took. **/
+		uint64_t monitorCpuNs = 0; /**< The CPU time the monitor thread spent. **/
+		/** @brief The isolation settings of the monitor thread and the workers. **/
+		utils::ThreadIsolation isolation;
+		bool isolate = false; /**< Set if the monitor thread still needs to apply the isolation settings. **/
+		std::vector<std::string> isolationFailures; /**< The settings the monitor thread failed to apply. **/
+		utils::DeadlineScheduler scheduler;
+		std::thread monitorthread;
+
+		void monitor();
+		/**
+		 * @brief Returns those of \p measures whose providers are not running yet.
+		 */
+		std::set<tirexMeasure> withoutProvider(const std::set<tirexMeasure>& measures);
+		/**
+		 * @brief Starts the (already initialized) \p provider with the given name unless an instance is running
+		 * already, in which case \p provider is destroyed. Must be called with the mutex held.
+		 *
+		 * @return The entry of the running instance.
+		 */
+		std::map<size_t, ProviderState>::iterator
+		adopt(std::string_view name, std::unique_ptr<StatsProvider>&& provider);
+		void reschedule(size_t id, ProviderState& state);
+		/** @brief Configures the provider's adaptive rate from the configurations of all its subscriptions. */
+		void configureRate(ProviderState& state);
+		/** @brief Enables the provider for the measures requested by its subscriptions, such that it skips the rest. */
+		void requestMeasures(ProviderState& state);
+		void updateOverhead();
+		void applyIsolation();
+
+	public:
+		Sampler();
+		Sampler(const Sampler&) = delete;
+		~Sampler();
+		Sampler& operator=(const Sampler&) = delete;
+
+		/**
+		 * @brief Returns the process-wide sampler and creates it if it does not exist.
+		 */
+		static std::shared_ptr<Sampler> acquire();
+
+		/**
+		 * @brief Starts (if necessary) the providers responsible for \p measures and opens a window on each of them.
+		 *
+		 * @param[in] measures The measures that are requested.
+		 * @param[in] conf The configuration to use for providers (e.g., their poll interval) and the windows (e.g.,
+		 * how their time series are recorded).
+		 * @param[in,out] subscription Populated with the opened windows, which append every sample to the
+		 * subscription's log (if set).
+		 * @return A set of tirexMeasure which are not provided by any of the providers.
+		 */
+		std::set<tirexMeasure>
+		subscribe(const std::set<tirexMeasure>& measures, const tirexTrackingConf& conf, Subscription& subscription);
+
+		/**
+		 * @brief Keeps the given (already initialized) providers running until \p subscription is unsubscribed, even if
+		 * no measurement needs them in the meantime.
+		 * @details This does not open windows or poll the providers, it only saves subsequent subscriptions from having
+		 * to instantiate them again. Providers that are already running are kept and the surplus instances in
+		 * \p providers are destroyed.
+		 *
+		 * @param[in] providers The providers to adopt (e.g., as initialized by tirex::initProviders).
+		 * @param[out] subscription Populated with window-less entries for the providers.
+		 */
+		void retain(ProviderList&& providers, Subscription& subscription);
+
+		/**
+		 * @brief Returns the isolation settings that are in effect (see tirexTrackingConfSetCpuAffinity) and the ones
+		 * that could not be applied as a JSON object.
+		 */
+		nlohmann::json isolationInfo();
+
+		/**
+		 * @brief Closes the windows of \p subscription and stops the providers that are no longer needed.
+		 * @details The windows stay valid (such that their statistics can be collected) until the subscription is
+		 * destroyed.
+		 */
+		void unsubscribe(Subscription& subscription);
+	};
+} // namespace tirex
+
+#endif
@@ -0,0 +1,57 @@
+#include "samplestream.hpp"
+
+#include <numeric>
+
+using tirex::SampleStream;
+
+SampleStream::SampleStream(
+		tirexSampleCallback callback, void* userdata, SampleTable* table, std::chrono::steady_clock::time_point epoch,
+		size_t numRings
+)
+		: callback(callback), userdata(userdata), table(table), epoch(epoch) {
+	for (size_t i = 0; i < numRings; ++i)
+		rings.emplace_back(std::make_unique<SampleRing>(ringCapacity));
+	consumer = std::thread(&SampleStream::run, this);
+}
+
+SampleStream::~SampleStream() {
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+	cv.notify_one();
+	consumer.join();
+}
+
+void SampleStream::run() {
+	std::unique_lock lock(mutex);
+	while (!cv.wait_for(lock, drainInterval, [this] { return stopping; })) {
+		lock.unlock();
+		drain();
+		lock.lock();
+	}
+	lock.unlock();
+	drain(); // Deliver what was recorded before the stream was stopped
+}
+
+void SampleStream::drain() {
+	Sample sample;
+	for (size_t i = 0; i < rings.size(); ++i) {
+		while (rings[i]->pop(sample)) {
+			auto offset = std::chrono::duration_cast<std::chrono::microseconds>(sample.timestamp - epoch);
+			auto entry = makeSample(sample.measure, static_cast<uint64_t>(offset.count()), sample.value);
+			if (table != nullptr)
+				table->add(i, entry);
+			if (callback != nullptr)
+				callback(&entry, userdata);
+		}
+	}
+	if (table != nullptr)
+		table->commit();
+}
+
+size_t SampleStream::dropped() const noexcept {
+	return std::accumulate(rings.begin(), rings.end(), size_t{0}, [](size_t sum, const auto& ring) {
+		return sum + ring->dropped();
+	});
+}
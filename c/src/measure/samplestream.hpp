@@ -0,0 +1,72 @@
+#ifndef MEASURE_SAMPLESTREAM_HPP
+#define MEASURE_SAMPLESTREAM_HPP
+
+#include <tirex_tracker.h>
+
+#include "sampletable.hpp"
+#include "stats/provider.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tirex {
+	/**
+	 * @brief Delivers the samples of a measurement to a user supplied callback and/or a SampleTable while the
+	 * measurement is running.
+	 * @details Every window of the measurement pushes its samples into its own SampleRing, i.e., each ring has exactly
+	 * one producer (the provider's worker) and one consumer (the stream's thread). The consumer thread periodically
+	 * drains all rings, invokes the callback, and adds the samples to the table. If the callback does not keep up and a
+	 * ring runs full, the provider drops the sample (and counts it) instead of waiting, such that a slow callback never
+	 * delays the sampling. The SampleLog must not lose samples, so the windows append to it directly instead (see
+	 * Window::log).
+	 */
+	class SampleStream final {
+	public:
+		static constexpr size_t ringCapacity = 4096; /**< The number of samples each ring can buffer. **/
+		static constexpr std::chrono::milliseconds drainInterval{10};
+
+	private:
+		tirexSampleCallback callback;
+		void* userdata;
+		SampleTable* table;
+		std::chrono::steady_clock::time_point epoch; /**< Sample timestamps are reported relative to this. **/
+		std::vector<std::unique_ptr<SampleRing>> rings;
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool stopping = false;
+		std::thread consumer;
+
+		void run();
+		void drain();
+
+	public:
+		/**
+		 * @param callback The callback that is invoked (on the stream's thread) for every sample or nullptr.
+		 * @param userdata Passed to \p callback as is.
+		 * @param table The table to add every sample to or nullptr. It must outlive the stream.
+		 * @param epoch The point in time that the timestamps passed to \p callback are relative to.
+		 * @param numRings The number of rings (i.e., producers) to create.
+		 */
+		SampleStream(
+				tirexSampleCallback callback, void* userdata, SampleTable* table,
+				std::chrono::steady_clock::time_point epoch, size_t numRings
+		);
+		SampleStream(const SampleStream&) = delete;
+		/**
+		 * @brief Delivers the remaining samples and joins the stream's thread.
+		 * @details The producers must be detached from the rings before the stream is destroyed.
+		 */
+		~SampleStream();
+		SampleStream& operator=(const SampleStream&) = delete;
+
+		SampleRing& ring(size_t idx) noexcept { return *rings[idx]; }
+		/** @brief The total number of samples that were dropped since a ring was full. */
+		size_t dropped() const noexcept;
+	};
+} // namespace tirex
+
+#endif
@@ -0,0 +1,67 @@
+#include "sampletable.hpp"
+
+#include <algorithm>
+
+using tirex::SampleTable;
+
+SampleTable::SampleTable(std::ofstream&& out, const std::vector<tirexMeasure>& measures, size_t numRings)
+		: out(std::move(out)), lastSeen(numRings) {
+	for (auto measure : measures)
+		columns.try_emplace(measure, columns.size());
+	this->out << "timestamp_us";
+	for (const auto& [measure, _] : columns)
+		this->out << ',' << static_cast<int>(measure);
+	this->out << '\n';
+}
+
+SampleTable::~SampleTable() {
+	for (const auto& [timestampUs, row] : pending)
+		write(timestampUs, row);
+}
+
+std::unique_ptr<SampleTable>
+SampleTable::create(const std::filesystem::path& path, const std::vector<tirexMeasure>& measures, size_t numRings) {
+	std::ofstream out(path, std::ios::trunc);
+	if (!out)
+		return nullptr;
+	return std::unique_ptr<SampleTable>{new SampleTable(std::move(out), measures, numRings)};
+}
+
+void SampleTable::write(uint64_t timestampUs, const Row& row) {
+	out << timestampUs;
+	for (const auto& [_, column] : columns) {
+		out << ',';
+		if (row[column])
+			std::visit([this](auto value) { out << value; }, *row[column]);
+	}
+	out << '\n';
+}
+
+void SampleTable::add(size_t ring, const tirexSample& sample) {
+	lastSeen[ring] = sample.timestampUs;
+	auto it = columns.find(sample.source);
+	if (it == columns.end())
+		return;
+	auto& row = pending.try_emplace(sample.timestampUs, columns.size()).first->second;
+	if (sample.type == TIREX_FLOATING)
+		row[it->second] = sample.floating;
+	else
+		row[it->second] = sample.value;
+}
+
+void SampleTable::commit() {
+	// Each ring delivers its samples in order, so no ring can add to rows before the oldest sample of the latest ones
+	std::optional<uint64_t> watermark;
+	for (const auto& last : lastSeen) {
+		if (last)
+			watermark = std::min(watermark.value_or(*last), *last);
+	}
+	auto excess = (pending.size() > maxPending) ? pending.size() - maxPending : 0;
+	auto it = pending.begin();
+	for (; it != pending.end() && (excess > 0 || (watermark && it->first < *watermark)); ++it) {
+		write(it->first, it->second);
+		excess -= (excess > 0) ? 1 : 0;
+	}
+	pending.erase(pending.begin(), it);
+	out.flush();
+}
@@ -0,0 +1,75 @@
+#ifndef MEASURE_SAMPLETABLE_HPP
+#define MEASURE_SAMPLETABLE_HPP
+
+#include <tirex_tracker.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace tirex {
+	/**
+	 * @brief Writes the samples of a measurement as a CSV table with one row per tick and one column per measure.
+	 * @details Since all providers that are due in the same tick stamp their samples with the same time, the samples of
+	 * a row share a single timestamp (the first column, in microseconds since the start of the measurement). Cells of
+	 * measures that were not sampled in a tick (e.g., since their provider is polled less often) are left empty.
+	 *
+	 * The samples arrive through one ring per provider, each of which is ordered by time. A row is written once every
+	 * provider that delivered samples so far has moved past it, such that no sample of the tick can arrive anymore. To
+	 * bound the memory if a provider stops delivering, at most SampleTable::maxPending rows are held back.
+	 *
+	 * A table has a single writer (the measurement's SampleStream thread).
+	 */
+	class SampleTable final {
+	public:
+		static constexpr size_t maxPending = 1024;
+
+	private:
+		/** @brief The cells of a row, which hold the values of integer and fractional measures as they are. **/
+		using Row = std::vector<std::optional<std::variant<uint64_t, double>>>;
+
+		std::ofstream out;
+		std::map<tirexMeasure, size_t> columns;
+		/** @brief The timestamp of the last sample that was received from each ring. **/
+		std::vector<std::optional<uint64_t>> lastSeen;
+		std::map<uint64_t, Row> pending; /**< The rows that may still receive samples, by timestamp. **/
+
+		SampleTable(std::ofstream&& out, const std::vector<tirexMeasure>& measures, size_t numRings);
+
+		void write(uint64_t timestampUs, const Row& row);
+
+	public:
+		SampleTable(const SampleTable&) = delete;
+		/** @brief Writes the rows that were held back. */
+		~SampleTable();
+		SampleTable& operator=(const SampleTable&) = delete;
+
+		/**
+		 * @brief Creates (or truncates) the table at \p path and writes its header.
+		 *
+		 * @param path The file to write the table to.
+		 * @param measures The measures to create columns for. Samples of other measures are ignored.
+		 * @param numRings The number of rings the samples arrive through.
+		 * @return The table or nullptr if the file could not be created.
+		 */
+		static std::unique_ptr<SampleTable>
+		create(const std::filesystem::path& path, const std::vector<tirexMeasure>& measures, size_t numRings);
+
+		/**
+		 * @brief Adds \p sample, which was received from the ring with index \p ring, to its row.
+		 */
+		void add(size_t ring, const tirexSample& sample);
+		/**
+		 * @brief Writes all rows that can not receive samples anymore.
+		 */
+		void commit();
+	};
+} // namespace tirex
+
+#endif
@@ -59,9 +59,9 @@ DevContainerStats::DevContainerStats() {
 
 std::set<tirexMeasure> DevContainerStats::providedMeasures() noexcept { return measures; }
 
-Stats DevContainerStats::getInfo() {
+Stats DevContainerStats::getInfo(const std::set<tirexMeasure>& measures) {
 	return makeFilteredStats(
-			enabled,
+			enabledOf(measures),
 			std::pair{
 					TIREX_DEVCONTAINER_CONF_PATHS,
 					"["s + utils::join(searchDevcontainerFiles(fs::current_path()), ", ") + "]"
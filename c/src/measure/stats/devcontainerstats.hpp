@@ -10,7 +10,7 @@ namespace tirex {
 		DevContainerStats();
 
 		std::set<tirexMeasure> providedMeasures() noexcept override;
-		Stats getInfo() override;
+		Stats getInfo(const std::set<tirexMeasure>& measures) override;
 
 		static constexpr const char* description = "Reads metainformation from the devcontainer.json";
 		static const char* version;
@@ -85,20 +85,45 @@ std::set<tirexMeasure> EnergyStats::providedMeasures() noexcept {
 }
 
 void EnergyStats::start() {
-	tracker.start();
 	if (usePmic)
 		pmic.start();
 }
 void EnergyStats::stop() {
-	tracker.stop();
 	if (usePmic)
 		pmic.stop();
 }
 void EnergyStats::step() {
-	if (usePmic)
-		pmic.step();
+	if (usePmic) {
+		std::lock_guard lock(windowsMutex);
+		stepPmic();
+	}
 }
-Stats EnergyStats::getStats() {
+void EnergyStats::stepPmic() {
+	pmic.step();
+	pmicJoules.store({.core = pmic.coreJoules(), .ram = pmic.ramJoules()});
+}
+
+std::unique_ptr<tirex::Window> EnergyStats::makeWindow(std::set<tirexMeasure> measures) {
+	return std::make_unique<EnergyWindow>(*this, std::move(measures));
+}
+
+void EnergyStats::EnergyWindow::start() {
+	tracker.start();
+	if (provider.usePmic) {
+		provider.stepPmic(); // Take a sample such that the energy up to now is accounted for
+		startCoreJoules = provider.pmic.coreJoules();
+		startRamJoules = provider.pmic.ramJoules();
+	}
+}
+void EnergyStats::EnergyWindow::stop() {
+	tracker.stop();
+	if (provider.usePmic) {
+		provider.stepPmic();
+		stopCoreJoules = provider.pmic.coreJoules();
+		stopRamJoules = provider.pmic.ramJoules();
+	}
+}
+Stats EnergyStats::EnergyWindow::getStats() {
 	using json = nlohmann::json;
 	auto results = tracker.calculate_energy().energy;
 	for (auto& [device, result] : results)
@@ -111,13 +136,23 @@ Stats EnergyStats::getStats() {
 			std::pair{TIREX_RAM_ENERGY_SYSTEM_JOULES, json(transform(tryget(results, "dram-0"), divide(1000'000)))},
 			std::pair{TIREX_GPU_ENERGY_SYSTEM_JOULES, json(transform(tryget(results, "nvidia_gpu_0"), divide(1000)))}
 	);
-	if (usePmic) {
+	if (provider.usePmic) {
 		// Override CPU/RAM with the PMIC measurements (joules already); any GPU energy reported by
 		// cppjoules is left intact, so both sources coexist on a hypothetical RAPL+PMIC machine.
 		if (enabled.contains(TIREX_CPU_ENERGY_SYSTEM_JOULES))
-			stats[TIREX_CPU_ENERGY_SYSTEM_JOULES] = json(pmic.coreJoules());
+			stats[TIREX_CPU_ENERGY_SYSTEM_JOULES] = json(stopCoreJoules - startCoreJoules);
 		if (enabled.contains(TIREX_RAM_ENERGY_SYSTEM_JOULES))
-			stats[TIREX_RAM_ENERGY_SYSTEM_JOULES] = json(pmic.ramJoules());
+			stats[TIREX_RAM_ENERGY_SYSTEM_JOULES] = json(stopRamJoules - startRamJoules);
 	}
 	return stats;
-}
\ No newline at end of file
+}
+Stats EnergyStats::EnergyWindow::peekStats() const {
+	// CPPJoules only reports the energy once its tracker is stopped, so only the PMIC's measurements are available
+	if (!provider.usePmic)
+		return {};
+	auto [coreJoules, ramJoules] = provider.pmicJoules.load();
+	return makeFilteredStats(
+			enabled, std::pair{TIREX_CPU_ENERGY_SYSTEM_JOULES, nlohmann::json(coreJoules - startCoreJoules)},
+			std::pair{TIREX_RAM_ENERGY_SYSTEM_JOULES, nlohmann::json(ramJoules - startRamJoules)}
+	);
+}
@@ -9,9 +9,45 @@
 namespace tirex {
 	class EnergyStats final : public StatsProvider {
 	private:
-		cppjoules::EnergyTracker tracker;
-		PmicReader pmic;
+		cppjoules::EnergyTracker tracker; /**< Only used to query the capabilities. Windows own their tracker. **/
+		PmicReader pmic; /**< Guarded by StatsProvider::windowsMutex since windows read it on start and stop. **/
 		bool usePmic = false;
+		struct PmicJoules {
+			double core;
+			double ram;
+		};
+		/** @brief The energy integrated by the PMIC so far, published for EnergyWindow::peekStats. **/
+		utils::SeqLock<PmicJoules> pmicJoules;
+
+		void stepPmic();
+
+		/**
+		 * @brief Measures the energy consumed between the start and end of a measurement.
+		 * @details Each window owns an energy tracker such that concurrent measurements do not interfere. The PMIC,
+		 * in contrast, is integrated continuously by the provider and the window reports the difference between the
+		 * energy accumulated at its start and at its end.
+		 */
+		class EnergyWindow final : public Window {
+		private:
+			EnergyStats& provider;
+			cppjoules::EnergyTracker tracker;
+			double startCoreJoules = 0;
+			double startRamJoules = 0;
+			double stopCoreJoules = 0;
+			double stopRamJoules = 0;
+
+		public:
+			EnergyWindow(EnergyStats& provider, std::set<tirexMeasure> measures)
+					: Window(std::move(measures)), provider(provider) {}
+
+			void start() override;
+			void stop() override;
+			Stats getStats() override;
+			Stats peekStats() const override;
+		};
+
+	protected:
+		std::unique_ptr<Window> makeWindow(std::set<tirexMeasure> measures) override;
 
 	public:
 		EnergyStats();
@@ -20,7 +56,6 @@ namespace tirex {
 		void start() override;
 		void stop() override;
 		void step() override;
-		Stats getStats() override;
 
 		static constexpr const char* description = "Collects the energy consumption of various components.";
 		static const char* version;
@@ -329,7 +329,8 @@ bool GitStats::isRepository() const noexcept { return repo != nullptr; }
 
 std::set<tirexMeasure> GitStats::providedMeasures() noexcept { return measures; }
 
-Stats GitStats::getInfo() {
+Stats GitStats::getInfo(const std::set<tirexMeasure>& measures) {
+	auto requested = enabledOf(measures);
 	if (isRepository()) {
 		auto status = getStatusStats(repo);
 		tirex::log::info(
@@ -352,12 +353,12 @@ Stats GitStats::getInfo() {
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
 		std::filesystem::path tmpfile{std::tmpnam(nullptr)};
 #pragma clang diagnostic pop
-		if (enabled.contains(TIREX_GIT_ARCHIVE_PATH)) {
+		if (requested.contains(TIREX_GIT_ARCHIVE_PATH)) {
 			repoToArchive(repo, tmpfile, archivalSizeLimit);
 		}
 		auto [local, remote] = getBranchName(repo);
 		return makeFilteredStats(
-				enabled, std::pair{TIREX_GIT_IS_REPO, "1"s}, std::pair{TIREX_GIT_HASH, hashAllFiles(repo)},
+				requested, std::pair{TIREX_GIT_IS_REPO, "1"s}, std::pair{TIREX_GIT_HASH, hashAllFiles(repo)},
 				std::pair{TIREX_GIT_LAST_COMMIT_HASH, getLastCommitHash(repo)}, std::pair{TIREX_GIT_BRANCH, local},
 				std::pair{TIREX_GIT_BRANCH_UPSTREAM, remote},
 				std::pair{TIREX_GIT_TAGS, "["s + tirex::utils::join(getTags(repo), ", ") + "]"s},
@@ -369,6 +370,6 @@ Stats GitStats::getInfo() {
 				std::pair{TIREX_GIT_ARCHIVE_PATH, TmpFile{tmpfile}}
 		);
 	} else {
-		return makeFilteredStats(enabled, std::pair{TIREX_GIT_IS_REPO, "0"s});
+		return makeFilteredStats(requested, std::pair{TIREX_GIT_IS_REPO, "0"s});
 	}
 }
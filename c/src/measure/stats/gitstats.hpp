@@ -21,7 +21,7 @@ namespace tirex {
 		bool isRepository() const noexcept;
 
 		std::set<tirexMeasure> providedMeasures() noexcept override;
-		Stats getInfo() override;
+		Stats getInfo(const std::set<tirexMeasure>& measures) override;
 
 		static constexpr const char* description = "Collects git related metrics.";
 		static const char* version;
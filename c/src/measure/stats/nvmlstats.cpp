@@ -67,7 +67,17 @@ public:
 #else
 #error "Unsupported OS"
 #endif
-} nvml;
+};
+
+/**
+ * @brief Returns the process-wide NVML library, which is loaded upon first use.
+ * @details Loading happens at most once and is thread-safe (in contrast to a global object, this also avoids loading
+ * the library during static initialization if no GPU measures are requested).
+ */
+static NVMLLib& getNVML() {
+	static NVMLLib lib;
+	return lib;
+}
 
 static const char* nvmlArchToStr(nvmlDeviceArchitecture_t arch) {
 	switch (arch) {
@@ -92,6 +102,7 @@ static const char* nvmlArchToStr(nvmlDeviceArchitecture_t arch) {
 }
 
 static bool initNVML() {
+	auto& nvml = getNVML();
 	if (!nvml.good())
 		return false;
 	switch (nvml.init()) {
@@ -116,30 +127,30 @@ NVMLStats::NVMLStats() : nvml({.supported = initNVML(), .devices = {}}) {
 	if (!nvml.supported)
 		return;
 	unsigned int count;
-	switch (nvmlReturn_t err; err = ::nvml.deviceGetCount(&count)) {
+	switch (nvmlReturn_t err; err = getNVML().deviceGetCount(&count)) {
 	case NVML_SUCCESS:
 		tirex::log::info("gpustats", "Found {} device(s):", count);
 		for (unsigned i = 0u; i < count; ++i) {
 			nvmlDevice_t device;
-			switch (nvmlReturn_t ret; ret = ::nvml.deviceGetHandleByIndex(i, &device)) {
+			switch (nvmlReturn_t ret; ret = getNVML().deviceGetHandleByIndex(i, &device)) {
 			case NVML_SUCCESS:
 				nvmlDeviceArchitecture_t arch;
-				::nvml.deviceGetArchitecture(device, &arch);
+				getNVML().deviceGetArchitecture(device, &arch);
 				char name[96];
-				::nvml.deviceGetName(device, name, sizeof(name) - 1);
+				getNVML().deviceGetName(device, name, sizeof(name) - 1);
 				tirex::log::info("gpustats", "\t[{}] {} ({} Architecture)", i, name, nvmlArchToStr(arch));
 				nvml.devices.emplace_back(device);
 				break;
 			default:
 				tirex::log::error(
-						"gpustats", "\t[{}] fetching handle failed with error {}", i, ::nvml.errorString(ret)
+						"gpustats", "\t[{}] fetching handle failed with error {}", i, getNVML().errorString(ret)
 				);
 				break;
 			}
 		}
 		break;
 	default:
-		tirex::log::error("gpustats", "Fetching devices failed with error {}", ::nvml.errorString(err));
+		tirex::log::error("gpustats", "Fetching devices failed with error {}", getNVML().errorString(err));
 		break;
 	}
 }
@@ -150,30 +161,36 @@ void NVMLStats::step() {
 	nvmlMemory_t memory;
 	/** \todo support multi-gpu **/
 	for (auto device : nvml.devices) {
-		if (nvmlReturn_t ret; (ret = ::nvml.deviceGetMemoryInfo(device, &memory)) == NVML_SUCCESS) {
-			nvml.vramUsageTotal.addValue(memory.used / 1000 / 1000);
-		} else {
-			static bool logged = false;
-			if (!logged) { // Make sure that we log this message only once
-				tirex::log::error("gpustats", "Could not fetch memory information: {}", ::nvml.errorString(ret));
-				logged = true;
+		// Only the enabled measures are queried since each query takes a call into the driver
+		if (isEnabled(TIREX_GPU_VRAM_USED_SYSTEM_MB)) {
+			if (nvmlReturn_t ret; (ret = getNVML().deviceGetMemoryInfo(device, &memory)) == NVML_SUCCESS) {
+				record(TIREX_GPU_VRAM_USED_SYSTEM_MB, memory.used / 1000 / 1000);
+			} else {
+				if (!memoryErrorLogged) { // Make sure that we log this message only once
+					tirex::log::error(
+							"gpustats", "Could not fetch memory information: {}", getNVML().errorString(ret)
+					);
+					memoryErrorLogged = true;
+				}
+				/** \todo how to handle? **/
+				tirex::abort(tirexLogLevel::ERROR, "Could not fetch GPU memory information");
 			}
-			tirex::abort(tirexLogLevel::ERROR, "Could not fetch GPU memory information"); /** \todo how to handle? **/
 		}
-		nvmlUtilization_t util;
-		if (nvmlReturn_t ret; (ret = ::nvml.deviceGetUtilizationRates(device, &util)) == NVML_SUCCESS) {
-			nvml.utilizationTotal.addValue(util.gpu);
-		} else {
-			static bool logged = false;
-			if (!logged) { // Make sure that we log this message only once
-				tirex::log::critical(
-						"gpustats", "Could not fetch utilization information: {}", ::nvml.errorString(ret)
-				);
-				logged = true;
+		if (isEnabled(TIREX_GPU_USED_SYSTEM_PERCENT)) {
+			nvmlUtilization_t util;
+			if (nvmlReturn_t ret; (ret = getNVML().deviceGetUtilizationRates(device, &util)) == NVML_SUCCESS) {
+				record(TIREX_GPU_USED_SYSTEM_PERCENT, util.gpu);
+			} else {
+				if (!utilizationErrorLogged) { // Make sure that we log this message only once
+					tirex::log::critical(
+							"gpustats", "Could not fetch utilization information: {}", getNVML().errorString(ret)
+					);
+					utilizationErrorLogged = true;
+				}
+				tirex::abort(
+						tirexLogLevel::ERROR, "Could not fetch GPU utlization information"
+				); /** \todo how to handle? **/
 			}
-			tirex::abort(
-					tirexLogLevel::ERROR, "Could not fetch GPU utlization information"
-			); /** \todo how to handle? **/
 		}
 	}
 
@@ -184,7 +201,7 @@ void NVMLStats::step() {
 		list.version = nvmlProcessDetailList_v1;
 		list.numProcArrayEntries = 0;
 		list.procArray = nullptr;
-		auto result = ::nvml.deviceGetRunningProcessDetailList(device, &list);
+		auto result = getNVML().deviceGetRunningProcessDetailList(device, &list);
 		if (result == NVML_SUCCESS) {
 			std::cout << "No processes running on GPU" << std::endl;
 			continue;
@@ -192,12 +209,12 @@ void NVMLStats::step() {
 			std::vector<nvmlProcessDetail_v1_t> buf;
 			buf.resize(list.numProcArrayEntries);
 			list.procArray = buf.data();
-			result = ::nvml.deviceGetRunningProcessDetailList(device, &list);
+			result = getNVML().deviceGetRunningProcessDetailList(device, &list);
 			for (auto element : buf) {
 				std::cout << "PID: " << element.pid << " Mem: " << element.usedGpuMemory << std::endl;
 			}
 		} else {
-			std::cout << "Error: " << ::nvml.errorString(result) << std::endl;
+			std::cout << "Error: " << getNVML().errorString(result) << std::endl;
 		}
 	}*/
 }
@@ -208,19 +225,23 @@ std::set<tirexMeasure> NVMLStats::providedMeasures() noexcept {
 	return {};
 }
 
-Stats NVMLStats::getStats() {
-	if (nvml.supported) {
-		return makeFilteredStats(
-				enabled, std::pair{TIREX_GPU_USED_PROCESS_PERCENT, "TODO"s},
-				std::pair{TIREX_GPU_USED_SYSTEM_PERCENT, std::cref(nvml.utilizationTotal)},
-				std::pair{TIREX_GPU_VRAM_USED_PROCESS_MB, "TODO"s},
-				std::pair{TIREX_GPU_VRAM_USED_SYSTEM_MB, std::cref(nvml.vramUsageTotal)}
-		);
-	} else {
-		return {};
-	}
+std::map<tirexMeasure, tirex::SampledMeasure> NVMLStats::sampledMeasures() const {
+	return {{TIREX_GPU_USED_SYSTEM_PERCENT, {TIREX_AGG_MAX}}, {TIREX_GPU_VRAM_USED_SYSTEM_MB, {TIREX_AGG_MAX}}};
+}
+
+std::unique_ptr<tirex::Window> NVMLStats::makeWindow(std::set<tirexMeasure> measures) {
+	return std::make_unique<NVMLWindow>(std::move(measures));
+}
+
+Stats NVMLStats::NVMLWindow::getStats() {
+	auto stats = Window::getStats();
+	stats.merge(makeFilteredStats(
+			enabled, std::pair{TIREX_GPU_USED_PROCESS_PERCENT, "TODO"s},
+			std::pair{TIREX_GPU_VRAM_USED_PROCESS_MB, "TODO"s}
+	));
+	return stats;
 }
-Stats NVMLStats::getInfo() {
+Stats NVMLStats::getInfo(const std::set<tirexMeasure>& measures) {
 	if (nvml.supported) {
 		std::string modelName;
 		std::string vramTotal;
@@ -229,19 +250,19 @@ Stats NVMLStats::getInfo() {
 			// Device Info
 			char name[96];
 			unsigned int ncores;
-			if (nvmlReturn_t ret; (ret = ::nvml.deviceGetName(device, name, sizeof(name) - 1)) == NVML_SUCCESS) {
+			if (nvmlReturn_t ret; (ret = getNVML().deviceGetName(device, name, sizeof(name) - 1)) == NVML_SUCCESS) {
 				modelName += std::string(name) + ",";
 			} else {
 				modelName += "<error>,";
 			}
-			if (nvmlReturn_t ret; (ret = ::nvml.deviceGetNumGpuCores(device, &ncores)) == NVML_SUCCESS) {
+			if (nvmlReturn_t ret; (ret = getNVML().deviceGetNumGpuCores(device, &ncores)) == NVML_SUCCESS) {
 				cores += std::to_string(ncores) + ",";
 			} else {
 				cores += "<error>,";
 			}
 			// Memory Info
 			nvmlMemory_t memory;
-			if (nvmlReturn_t ret; (ret = ::nvml.deviceGetMemoryInfo(device, &memory)) == NVML_SUCCESS) {
+			if (nvmlReturn_t ret; (ret = getNVML().deviceGetMemoryInfo(device, &memory)) == NVML_SUCCESS) {
 				vramTotal += std::to_string(memory.total / 1000 / 1000) + ",";
 			} else {
 				vramTotal += "<error>,";
@@ -249,10 +270,10 @@ Stats NVMLStats::getInfo() {
 		}
 
 		return makeFilteredStats(
-				enabled, std::pair{TIREX_GPU_SUPPORTED, "1"s}, std::pair{TIREX_GPU_MODEL_NAME, modelName},
+				enabledOf(measures), std::pair{TIREX_GPU_SUPPORTED, "1"s}, std::pair{TIREX_GPU_MODEL_NAME, modelName},
 				std::pair{TIREX_GPU_NUM_CORES, cores}, std::pair{TIREX_GPU_VRAM_AVAILABLE_SYSTEM_MB, vramTotal}
 		);
 	} else {
-		return makeFilteredStats(enabled, std::pair{TIREX_GPU_SUPPORTED, "0"s});
+		return makeFilteredStats(enabledOf(measures), std::pair{TIREX_GPU_SUPPORTED, "0"s});
 	}
 }
\ No newline at end of file
@@ -14,24 +14,28 @@ namespace tirex {
 		struct {
 			const bool supported;
 			std::vector<nvmlDevice_t> devices;
-			TimeSeries<unsigned> vramUsageTotal =
-					ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-					ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
-			TimeSeries<unsigned> vramUsageProcess =
-					ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-					ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
-			TimeSeries<unsigned> utilizationTotal =
-					ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-					ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
 		} nvml;
+		/** @brief Whether fetching memory information failed before (such that the error is logged only once). **/
+		bool memoryErrorLogged = false;
+		/** @brief Whether fetching utilization information failed before (such that the error is logged only once). **/
+		bool utilizationErrorLogged = false;
+
+		class NVMLWindow final : public Window {
+		public:
+			using Window::Window;
+			Stats getStats() override;
+		};
+
+	protected:
+		std::unique_ptr<Window> makeWindow(std::set<tirexMeasure> measures) override;
+		std::map<tirexMeasure, SampledMeasure> sampledMeasures() const override;
 
 	public:
 		NVMLStats();
 
 		std::set<tirexMeasure> providedMeasures() noexcept override;
 		void step() override;
-		Stats getStats() override;
-		Stats getInfo() override;
+		Stats getInfo(const std::set<tirexMeasure>& measures) override;
 
 		static constexpr const char* description = "Collects GPU related metrics for NVIDIA GPUs.";
 		static const char* version;
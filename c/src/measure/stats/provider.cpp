@@ -8,16 +8,24 @@
 #include "nvmlstats.hpp"
 #include "systemstats.hpp"
 #include "temperaturestats.hpp"
+#include "trackerstats.hpp"
 
 #include <algorithm>
+#include <future>
 
 using tirex::DevContainerStats;
 using tirex::EnergyStats;
 using tirex::GitStats;
 using tirex::NVMLStats;
+using tirex::SampleRing;
+using tirex::Stats;
 using tirex::StatsProvider;
 using tirex::SystemStats;
 using tirex::TemperatureStats;
+using tirex::TrackerStats;
+using tirex::Window;
+
+using namespace std::chrono_literals;
 
 const std::map<std::string, tirex::ProviderEntry> tirex::providers{
 		{"system",
@@ -32,25 +40,43 @@ const std::map<std::string, tirex::ProviderEntry> tirex::providers{
 		{"devcontainer",
 		 {std::make_unique<DevContainerStats>, DevContainerStats::measures, DevContainerStats::version,
 		  DevContainerStats::description}},
+		{"tracker",
+		 {std::make_unique<TrackerStats>, TrackerStats::measures, TrackerStats::version, TrackerStats::description}},
 };
 
-std::set<tirexMeasure>
-tirex::initProviders(std::set<tirexMeasure> measures, std::vector<std::unique_ptr<StatsProvider>>& providers) {
-	for (auto& [_, info] : tirex::providers) {
+std::set<tirexMeasure> tirex::initProviders(std::set<tirexMeasure> measures, ProviderList& providers) {
+	std::vector<std::pair<std::string_view, std::future<std::unique_ptr<StatsProvider>>>> pending;
+	for (auto& [name, info] : tirex::providers) {
 		std::set<tirexMeasure> diff;
 		std::set_difference(
 				measures.begin(), measures.end(), info.measures.begin(), info.measures.end(),
 				std::inserter(diff, diff.begin())
 		);
 		if (diff.size() != measures.size()) { // The provider is responsible for some of the requested measures
-			auto& provider = providers.emplace_back(info.constructor());
-			provider->requestMeasures(measures);
+			auto construct = [&info, measures] {
+				auto provider = info.constructor();
+				provider->requestMeasures(measures);
+				return provider;
+			};
+			pending.emplace_back(name, std::async(std::launch::async, std::move(construct)));
 		}
 		measures = std::move(diff);
 	}
+	for (auto& [name, provider] : pending)
+		providers.emplace_back(name, provider.get());
 	return measures;
 }
 
+Stats tirex::collectInfo(const std::vector<StatsProvider*>& providers, const std::set<tirexMeasure>& measures) {
+	std::vector<std::future<Stats>> pending;
+	for (auto provider : providers)
+		pending.emplace_back(std::async(std::launch::async, &StatsProvider::getInfo, provider, std::cref(measures)));
+	Stats stats{};
+	for (auto& info : pending)
+		stats.merge(info.get());
+	return stats;
+}
+
 void StatsProvider::requestMeasures(const std::set<tirexMeasure>& measures) noexcept {
 	auto supported = providedMeasures();
 	enabled.clear();
@@ -58,4 +84,240 @@ void StatsProvider::requestMeasures(const std::set<tirexMeasure>& measures) noex
 			measures.cbegin(), measures.cend(), supported.begin(), supported.end(),
 			std::inserter(enabled, enabled.begin())
 	);
-}
\ No newline at end of file
+	uint64_t bits = 0;
+	for (auto measure : enabled)
+		bits |= uint64_t{1} << static_cast<unsigned>(measure);
+	enabledBits.store(bits, std::memory_order_relaxed);
+}
+
+std::set<tirexMeasure> StatsProvider::enabledOf(const std::set<tirexMeasure>& measures) const {
+	std::set<tirexMeasure> result;
+	std::set_intersection(
+			measures.cbegin(), measures.cend(), enabled.cbegin(), enabled.cend(), std::inserter(result, result.begin())
+	);
+	return result;
+}
+
+std::unique_ptr<Window> StatsProvider::openWindow(
+		const std::set<tirexMeasure>& measures, clock::time_point epoch, bool withSeries, const SeriesConfs& series,
+		std::shared_ptr<MemoryBudget> budget, SampleLog* log
+) {
+	std::set<tirexMeasure> windowMeasures;
+	std::set_intersection(
+			measures.cbegin(), measures.cend(), enabled.cbegin(), enabled.cend(),
+			std::inserter(windowMeasures, windowMeasures.begin())
+	);
+	auto window = makeWindow(std::move(windowMeasures));
+	window->epoch = epoch;
+	window->budget = std::move(budget);
+	window->log = log;
+	for (auto& [measure, sampled] : sampledMeasures()) {
+		if (!window->enabled.contains(measure))
+			continue;
+		auto it = series.find(measure);
+		const auto& conf = (it != series.end()) ? it->second : SeriesConf{};
+		visitSampleType(sampled.type, [&]<typename T>() {
+			if (withSeries && conf.storage != TIREX_SERIES_NONE) {
+				window->series.emplace(measure, Window::makeSeries<T>(conf, sampled.aggregate, epoch));
+				if (window->budget != nullptr)
+					window->budgetEntries.emplace(measure, &window->budget->add(conf.priority));
+			}
+			window->summaries.try_emplace(measure, std::in_place_type<utils::SeqLock<Window::Summary<T>>>);
+		});
+	}
+	std::lock_guard lock(windowsMutex);
+	window->start();
+	windows.push_back(window.get());
+	return window;
+}
+
+void StatsProvider::closeWindow(Window& window) {
+	std::lock_guard lock(windowsMutex);
+	std::erase(windows, &window);
+	window.stop();
+}
+
+void StatsProvider::attachSink(Window& window, SampleRing* sink) {
+	std::lock_guard lock(windowsMutex);
+	window.sink = sink;
+}
+
+void StatsProvider::record(tirexMeasure measure, SampleValue value, clock::time_point timestamp) {
+	std::lock_guard lock(windowsMutex);
+	latest.insert_or_assign(measure, std::visit([](auto val) { return static_cast<double>(val); }, value));
+	for (auto window : windows)
+		window->record(measure, value, timestamp);
+}
+
+std::map<tirexMeasure, double> StatsProvider::latestSamples() {
+	std::lock_guard lock(windowsMutex);
+	return latest;
+}
+
+template <typename T>
+tirex::TimeSeries<T> Window::makeSeries(
+		const SeriesConf& conf, tirexAggregateFn agg, std::chrono::steady_clock::time_point epoch
+) {
+	agg = conf.aggregate.value_or(agg);
+	// Every sample passes through this pipeline, so it is composed at compile time to only cost a single virtual call.
+	// ts::TimeWeighted sees every sample such that the reported average is not biased by irregular sampling.
+	return ts::agg::visit(agg, [&]<typename Agg>() {
+		auto finish = [&](auto&& store) {
+			if (conf.batchInterval > 0ms)
+				return ts::erase(
+						std::move(store) | ts::BatchedBy<Agg>{conf.batchInterval, conf.maxPoints} | ts::Quantiles{} |
+						ts::TimeWeighted{}
+				);
+			return ts::erase(std::move(store) | ts::Quantiles{} | ts::TimeWeighted{});
+		};
+		switch (conf.storage) {
+		case TIREX_SERIES_PLAIN:
+			return finish(ts::flat<T>(epoch) | ts::Downsample{conf.maxPoints});
+		case TIREX_SERIES_ROLLUP: // The rings bound the memory by themselves
+			return finish(ts::flatRollup<T>(epoch, ts::defaultResolutions, agg));
+		default:
+			return finish(ts::flatCompressed<T>(epoch) | ts::Downsample{conf.maxPoints});
+		}
+	});
+}
+
+Window::~Window() {
+	for (auto [_, entry] : budgetEntries)
+		budget->remove(*entry);
+}
+
+Stats Window::getStats() {
+	Stats stats;
+	for (const auto& [measure, timeseries] : series)
+		std::visit([&](const auto& typed) { stats.emplace(measure, std::cref(typed)); }, timeseries);
+	// Windows without time series report the aggregates instead
+	stats.merge(Window::peekStats());
+	return stats;
+}
+
+Stats Window::peekStats() const {
+	Stats stats;
+	for (const auto& [measure, summary] : summaries) {
+		std::visit(
+				[&](const auto& lock) {
+					auto summary = lock.load();
+					if (summary.count == 0)
+						return;
+					auto json = nlohmann::json{
+							{"max", summary.max}, {"min", summary.min}, {"avg", summary.sum / summary.count}
+					};
+					// Like ts::TimeWeighted, the mean by the number of values is only reported for a single value
+					if (summary.weighted.duration > 0) {
+						json["avg"] = static_cast<decltype(summary.max)>(summary.weighted.mean);
+						json["variance"] = summary.weighted.variance();
+					}
+					stats.emplace(measure, std::move(json));
+				},
+				summary
+		);
+	}
+	return stats;
+}
+
+size_t Window::memoryUsage() const noexcept {
+	size_t bytes = summaries.size() * sizeof(decltype(summaries)::value_type);
+	for (const auto& [_, timeseries] : series) {
+		bytes += sizeof(decltype(series)::value_type);
+		bytes += std::visit([](const auto& typed) { return typed.memoryUsage(); }, timeseries);
+	}
+	return bytes;
+}
+
+std::set<tirexMeasure> Window::sampledMeasures() const {
+	std::set<tirexMeasure> measures;
+	for (const auto& [measure, _] : summaries)
+		measures.insert(measure);
+	return measures;
+}
+
+void Window::record(tirexMeasure measure, SampleValue value, std::chrono::steady_clock::time_point timestamp) noexcept {
+	auto it = summaries.find(measure);
+	if (it == summaries.end()) // The measure was not requested for this window
+		return;
+	// A tick that was due shortly before the window was opened is attributed to the window's start
+	timestamp = std::max(timestamp, epoch);
+	std::visit(
+			[&]<typename T>(utils::SeqLock<Summary<T>>& lock) {
+				// The summary was created with the measure's SampleType, which the value is converted to
+				auto typed = std::visit([](auto val) { return static_cast<T>(val); }, value);
+				auto offset = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp - epoch);
+				if (auto series_it = series.find(measure); series_it != series.end()) {
+					auto& timeseries = *std::get_if<TimeSeries<T>>(&series_it->second);
+					timeseries.addValue(typed, offset);
+					if (budget != nullptr)
+						enforceBudget(measure, timeseries);
+				}
+				if (sink != nullptr)
+					sink->push({.measure = measure, .timestamp = timestamp, .value = typed});
+				if (log != nullptr) {
+					auto offsetUs = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - epoch);
+					// The sampler commits the log once per tick rather than after each sample
+					log->append(makeSample(measure, static_cast<uint64_t>(offsetUs.count()), typed));
+				}
+
+				// Only the provider (holding its windowsMutex) writes, so the summary can not change in between
+				auto summary = lock.load();
+				if (summary.count == 0)
+					summary = {.min = typed, .max = typed, .sum = 0, .count = 0};
+				else
+					summary.weighted.add(
+							static_cast<double>(summary.last), static_cast<double>((offset - summary.lastTime).count())
+					);
+				summary.min = std::min(summary.min, typed);
+				summary.max = std::max(summary.max, typed);
+				summary.sum += typed;
+				++summary.count;
+				summary.last = typed;
+				summary.lastTime = offset;
+				lock.store(summary);
+			},
+			it->second
+	);
+}
+
+template <typename T>
+void Window::enforceBudget(tirexMeasure measure, TimeSeries<T>& timeseries) noexcept {
+	auto& entry = *budgetEntries.at(measure);
+	budget->update(entry, timeseries.memoryUsage());
+	switch (entry.request.load(std::memory_order_relaxed)) {
+	case MemoryBudget::Request::None:
+		break;
+	case MemoryBudget::Request::Shrink: {
+		auto before = timeseries.memoryUsage();
+		timeseries.shrink();
+		auto after = timeseries.memoryUsage();
+		// Downsampled series keep at least 8 points, so there is nothing left to gain at that point
+		if (after >= before || timeseries.size() <= 8)
+			entry.exhausted.store(true, std::memory_order_relaxed);
+		entry.request.store(MemoryBudget::Request::None, std::memory_order_relaxed);
+		budget->update(entry, after);
+		break;
+	}
+	case MemoryBudget::Request::Drop:
+		// Only the time series is dropped, the summary still reports the aggregates of the measure
+		tirex::log::warn(
+				"tracker", "Dropped the time series of measure {} to stay within the memory budget",
+				static_cast<signed>(measure)
+		);
+		budget->remove(entry);
+		budgetEntries.erase(measure);
+		series.erase(measure); // Invalidates timeseries
+		break;
+	}
+}
+
+tirexSample tirex::makeSample(tirexMeasure measure, uint64_t timestampUs, const SampleValue& value) noexcept {
+	tirexSample sample{.source = measure, .timestampUs = timestampUs, .type = TIREX_INTEGER, .value = 0};
+	if (const auto* floating = std::get_if<double>(&value)) {
+		sample.type = TIREX_FLOATING;
+		sample.floating = *floating;
+	} else {
+		sample.value = std::visit([](auto val) { return static_cast<uint64_t>(val); }, value);
+	}
+	return sample;
+}
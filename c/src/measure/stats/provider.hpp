@@ -3,7 +3,11 @@
 
 #include <tirex_tracker.h>
 
+#include "../memorybudget.hpp"
+#include "../samplelog.hpp"
 #include "../timeseries.hpp"
+#include "../utils/seqlock.hpp"
+#include "../utils/spscring.hpp"
 
 #include <nlohmann/json.hpp>
 
@@ -15,13 +19,20 @@
 #define CONVERTIBLE_TO_PAIR_CONCEPT
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -50,26 +61,361 @@ namespace tirex {
 		}
 	};
 
+	/**
+	 * @brief A time series that is reported as a statistic. It is only valid as long as the window that recorded it.
+	 */
+	template <typename T>
+	using SeriesRef = std::reference_wrapper<const tirex::TimeSeries<T>>;
 	using StatVal = std::variant<
-			std::string, nlohmann::json, TmpFile, std::reference_wrapper<const tirex::TimeSeries<unsigned>>>;
+			std::string, nlohmann::json, TmpFile, SeriesRef<unsigned>, SeriesRef<uint64_t>, SeriesRef<double>>;
 	using Stats = std::map<tirexMeasure, StatVal>;
 
+	/**
+	 * @brief The number of points that a time series is downsampled to when it is added to a result.
+	 */
+	constexpr size_t maxExportedPoints = 300;
+
 	tirexResult_st* createMsrResultFromStats(Stats&& stats);
 
+	/**
+	 * @brief The type of the values of a sampled measure. The measure's time series, its running aggregates, and its
+	 * samples all hold values of this type.
+	 */
+	enum class SampleType { Unsigned, UInt64, Double };
+	/** @brief A sampled value, which holds the alternative that corresponds to the measure's SampleType. **/
+	using SampleValue = std::variant<unsigned, uint64_t, double>;
+
+	/**
+	 * @brief Invokes \p fn with the value type that corresponds to \p type as its template argument (e.g.,
+	 * `fn.template operator()<double>()` for SampleType::Double) and returns its result.
+	 */
+	template <typename Fn>
+	decltype(auto) visitSampleType(SampleType type, Fn&& fn) {
+		switch (type) {
+		case SampleType::UInt64:
+			return fn.template operator()<uint64_t>();
+		case SampleType::Double:
+			return fn.template operator()<double>();
+		default:
+			return fn.template operator()<unsigned>();
+		}
+	}
+
+	/**
+	 * @brief Wraps \p value, which a provider sampled, as a SampleValue. The windows convert it to the measure's
+	 * SampleType when they record it.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	constexpr SampleValue toSampleValue(T value) noexcept {
+		if constexpr (std::is_floating_point_v<T>)
+			return static_cast<double>(value);
+		else if constexpr (sizeof(T) <= sizeof(unsigned))
+			return static_cast<unsigned>(value);
+		else
+			return static_cast<uint64_t>(value);
+	}
+
+	/**
+	 * @brief A single sample as it was recorded by a provider.
+	 */
+	struct Sample final {
+		tirexMeasure measure;
+		std::chrono::steady_clock::time_point timestamp;
+		SampleValue value;
+	};
+	using SampleRing = utils::SPSCRing<Sample>;
+
+	/**
+	 * @brief Converts \p value into the sample that is passed to a tirexSampleCallback.
+	 *
+	 * @param measure The measure that was sampled.
+	 * @param timestampUs When the sample was taken, in microseconds since the measurement started.
+	 * @param value The sampled value. Floating point values are reported as TIREX_FLOATING and all others as
+	 * TIREX_INTEGER.
+	 */
+	tirexSample makeSample(tirexMeasure measure, uint64_t timestampUs, const SampleValue& value) noexcept;
+
+	class StatsProvider;
+
+	/**
+	 * @brief How the time series of a sampled measure is recorded (see tirexTrackingConfSetSeries).
+	 */
+	struct SeriesConf final {
+		/** @brief Merges the samples of a batch. The provider's default aggregation if not set. **/
+		std::optional<tirexAggregateFn> aggregate;
+		/** @brief Samples within this interval are merged into one point. Every sample is kept if zero. **/
+		std::chrono::milliseconds batchInterval{100};
+		/**
+		 * @brief The number of points that the time series keeps at most. Since the points are stored compressed by
+		 * default, this is considerably more than what is exported (see tirex::maxExportedPoints).
+		 */
+		size_t maxPoints = 4096;
+		tirexSeriesStorage storage = TIREX_SERIES_COMPRESSED;
+		/** @brief Series of a lower priority are reduced first once the memory budget is exceeded. **/
+		unsigned priority = 0;
+	};
+	using SeriesConfs = std::map<tirexMeasure, SeriesConf>;
+
+	/**
+	 * @brief How a provider samples a measure (see StatsProvider::sampledMeasures).
+	 */
+	struct SampledMeasure final {
+		tirexAggregateFn aggregate; /**< The aggregation that is used unless the configuration overrides it. **/
+		SampleType type = SampleType::Unsigned;
+	};
+
+	/**
+	 * @brief A single measurement's view on a (potentially shared) provider.
+	 * @details Providers are shared between all measurements that are running concurrently. Each measurement opens a
+	 * window on every provider it needs, which spans from StatsProvider::openWindow to StatsProvider::closeWindow.
+	 * Samples that the provider takes in the meantime are recorded into the time series of all open windows. Subclasses
+	 * may additionally capture state on Window::start and Window::stop (e.g., counters whose difference is reported).
+	 *
+	 * The timestamps of the time series are relative to the window's epoch, which all windows of a measurement share
+	 * (the start of the measurement). Together with the providers stamping their samples with the tick that triggered
+	 * the step (see StatsProvider::stepAt), samples of different providers that were taken in the same tick carry the
+	 * exact same timestamp.
+	 */
+	class Window {
+		friend class StatsProvider;
+
+	public:
+		/**
+		 * @brief Running aggregates over all samples of a measure that was recorded in the window.
+		 */
+		template <typename T>
+		struct Summary final {
+			/** @brief Integers are summed up as 64-bit integers such that the sum does not overflow. **/
+			using Sum = std::conditional_t<std::is_floating_point_v<T>, double, uint64_t>;
+			T min;
+			T max;
+			Sum sum;
+			uint64_t count;
+			/** @brief Weights the values by how long they held, which is not biased by irregular sampling. **/
+			ts::TimeWeightedMoments weighted;
+			T last; /**< Only counts towards Summary::weighted once the next value arrives. **/
+			std::chrono::milliseconds lastTime;
+		};
+		/** @brief The time series of a sampled measure, whose values are of the measure's SampleType. **/
+		using AnySeries = std::variant<TimeSeries<unsigned>, TimeSeries<uint64_t>, TimeSeries<double>>;
+		using AnySummary = std::variant<
+				utils::SeqLock<Summary<unsigned>>, utils::SeqLock<Summary<uint64_t>>, utils::SeqLock<Summary<double>>>;
+
+	protected:
+		std::set<tirexMeasure> enabled; /**< The measures that were requested for this window. **/
+		std::chrono::steady_clock::time_point epoch; /**< The timestamps of the time series are relative to this. **/
+		std::map<tirexMeasure, AnySeries> series;
+		/**
+		 * @brief The running aggregates of the time series, which are published via a seqlock such that
+		 * Window::peekStats never blocks the thread that records the samples.
+		 */
+		std::map<tirexMeasure, AnySummary> summaries;
+		/**
+		 * @brief Receives a copy of every sample recorded in the window (if set). Guarded by the provider's
+		 * windowsMutex, which also makes the provider the ring's only producer.
+		 */
+		SampleRing* sink = nullptr;
+		/**
+		 * @brief Receives every sample recorded in the window (if set). Unlike Window::sink, the log is appended to
+		 * directly, so no sample is lost if the consumer of the ring falls behind or the sink is swapped.
+		 */
+		SampleLog* log = nullptr;
+		/** @brief Bounds the memory of the time series of all windows of the measurement (if set). **/
+		std::shared_ptr<MemoryBudget> budget;
+		/** @brief The entries of Window::series in Window::budget. **/
+		std::map<tirexMeasure, MemoryBudget::Entry*> budgetEntries;
+
+		/**
+		 * @brief Reports the size of the time series of \p measure to the budget and carries out what the budget
+		 * requested of it.
+		 */
+		template <typename T>
+		void enforceBudget(tirexMeasure measure, TimeSeries<T>& timeseries) noexcept;
+
+	public:
+		explicit Window(std::set<tirexMeasure> measures) : enabled(std::move(measures)) {}
+		Window(const Window&) = delete;
+		virtual ~Window();
+		Window& operator=(const Window&) = delete;
+
+		/**
+		 * @brief The pipeline for time series measures.
+		 * 
+		 * @param conf How the time series is recorded. Must not have TIREX_SERIES_NONE as its storage.
+		 * @param agg The aggregation that is used to reduce the time series once it grows too large unless \p conf
+		 * overrides it.
+		 * @param epoch The point in time that the timestamps are relative to.
+		 * @tparam T The type of the values (see SampleType).
+		 */
+		template <typename T>
+		static TimeSeries<T>
+		makeSeries(const SeriesConf& conf, tirexAggregateFn agg, std::chrono::steady_clock::time_point epoch);
+
+		/**
+		 * @brief Called when the window is opened. The provider's windows are locked while this is called.
+		 */
+		virtual void start() {}
+		/**
+		 * @brief Called when the window is closed. The provider's windows are locked while this is called.
+		 */
+		virtual void stop() {}
+		/**
+		 * @brief Returns the statistics collected within the window. This should be called once after the window was
+		 * closed and the result is only valid as long as the window is.
+		 * 
+		 * @returns the statistics that were measured
+		 */
+		virtual Stats getStats();
+		/**
+		 * @brief Returns the statistics collected so far while the window is still open.
+		 * @details This must neither block the provider nor copy the sampled time series. Hence, only the running
+		 * aggregates (max, min, and avg) of the sampled measures are reported, plus whatever the subclass can cheaply
+		 * compute (e.g., the elapsed time). It may be called concurrently to samples being recorded but not
+		 * concurrently to Window::start or Window::stop.
+		 *
+		 * @returns the statistics that were measured up to now
+		 */
+		virtual Stats peekStats() const;
+
+		/**
+		 * @brief Returns the number of bytes the window allocated for its time series and running aggregates.
+		 * @details Must not be called concurrently to samples being recorded (e.g., only after the window was closed).
+		 */
+		size_t memoryUsage() const noexcept;
+
+		/**
+		 * @brief Returns the measures of the window that are sampled (i.e., recorded via Window::record).
+		 */
+		std::set<tirexMeasure> sampledMeasures() const;
+
+		/**
+		 * @brief Adds \p value, which was sampled at \p timestamp, to the time series of \p measure if it was
+		 * requested for this window. The value is converted to the measure's SampleType first.
+		 */
+		void record(tirexMeasure measure, SampleValue value, std::chrono::steady_clock::time_point timestamp) noexcept;
+	};
+
 	class StatsProvider {
+	public:
+		using clock = std::chrono::steady_clock;
+
+	private:
+		static_assert(TIREX_MEASURE_COUNT <= 64, "StatsProvider::enabledBits needs a bit per measure");
+		/** @brief StatsProvider::enabled as a bit per measure, which StatsProvider::isEnabled reads lock-free. **/
+		std::atomic<uint64_t> enabledBits{0};
+
 	protected:
 		std::set<tirexMeasure> enabled;
+		/** @brief Guards StatsProvider::windows. Subclasses may also lock it to synchronize with their windows. **/
+		std::mutex windowsMutex;
+		std::vector<Window*> windows; /**< The currently open windows. **/
+		/** @brief The value that was last recorded for each measure. Guarded by StatsProvider::windowsMutex. **/
+		std::map<tirexMeasure, double> latest;
+		/** @brief The tick of the step that is currently running (see StatsProvider::stepAt). **/
+		clock::time_point stepTime;
+
+		/**
+		 * @brief Records \p value for \p measure in all currently open windows.
+		 * @details This is called by the provider from StatsProvider::step whenever it took a sample. The sample is
+		 * stamped with the tick that triggered the step.
+		 */
+		template <typename T>
+			requires std::is_arithmetic_v<T>
+		void record(tirexMeasure measure, T value) {
+			record(measure, toSampleValue(value), stepTime);
+		}
+		/**
+		 * @brief Like StatsProvider::record(tirexMeasure, T) but for samples that are taken outside of
+		 * StatsProvider::step (e.g., by the monitor thread).
+		 */
+		template <typename T>
+			requires std::is_arithmetic_v<T>
+		void record(tirexMeasure measure, T value, clock::time_point timestamp) {
+			record(measure, toSampleValue(value), timestamp);
+		}
+		/** @brief Like StatsProvider::record(tirexMeasure, T, clock::time_point) but for an already wrapped value. */
+		void record(tirexMeasure measure, SampleValue value, clock::time_point timestamp);
+		/**
+		 * @brief Whether the provider is enabled for \p measure.
+		 * @details Unlike StatsProvider::enabled, this may be called from StatsProvider::step while the sampler
+		 * enables or disables measures (see StatsProvider::requestMeasures). Steps use it to skip the queries for
+		 * measures that no measurement requested.
+		 */
+		bool isEnabled(tirexMeasure measure) const noexcept {
+			return (enabledBits.load(std::memory_order_relaxed) >> static_cast<unsigned>(measure)) & 1;
+		}
+
+		/**
+		 * @brief Creates a (yet empty) window for the given measures.
+		 * @details Providers that need to report more than their time series (e.g., the difference between two
+		 * counters at the start and end of a measurement) return a subclass of Window here.
+		 */
+		virtual std::unique_ptr<Window> makeWindow(std::set<tirexMeasure> measures) {
+			return std::make_unique<Window>(std::move(measures));
+		}
+
+		/**
+		 * @brief The measures that are sampled as a time series (via StatsProvider::record) together with their
+		 * default aggregation and the type of their values.
+		 */
+		virtual std::map<tirexMeasure, SampledMeasure> sampledMeasures() const { return {}; }
 
 	public:
 		StatsProvider() = default;
-		StatsProvider(const StatsProvider&) = default;
-		StatsProvider(StatsProvider&&) = default;
+		StatsProvider(const StatsProvider&) = delete;
 		virtual ~StatsProvider() = default;
 
-		StatsProvider& operator=(const StatsProvider&) = default;
-		StatsProvider& operator=(StatsProvider&&) = default;
+		StatsProvider& operator=(const StatsProvider&) = delete;
 
+		/**
+		 * @brief Enables the provider for those of \p measures that it provides and disables it for all others.
+		 * @details The sampler calls this whenever the measures that its subscriptions request change, which may
+		 * happen while the provider is running.
+		 */
 		void requestMeasures(const std::set<tirexMeasure>& measures) noexcept;
+		/**
+		 * @brief Returns the subset of \p measures that the provider is enabled for.
+		 */
+		std::set<tirexMeasure> enabledOf(const std::set<tirexMeasure>& measures) const;
+
+		/**
+		 * @brief Opens a new window on the provider that records all samples from now on until it is closed.
+		 * 
+		 * @param measures The measures requested for the window. Measures the provider was not enabled for are ignored.
+		 * @param epoch The point in time that the timestamps of the window's time series are relative to.
+		 * @param withSeries Whether the window records the time series of sampled measures. If not, only their
+		 * aggregates (max, min, and avg) are reported, which is much cheaper for short-lived windows.
+		 * @param series How the time series of individual measures are recorded. Measures that are not listed use the
+		 * defaults.
+		 * @param budget The memory budget that the window's time series are registered with or nullptr to not bound
+		 * their memory.
+		 * @param log The log that every sample of the window is appended to or nullptr. It must outlive the window's
+		 * registration (i.e., until StatsProvider::closeWindow returns).
+		 * @return The opened window. It must be closed via StatsProvider::closeWindow before it is destroyed.
+		 */
+		std::unique_ptr<Window> openWindow(
+				const std::set<tirexMeasure>& measures, clock::time_point epoch, bool withSeries = true,
+				const SeriesConfs& series = {}, std::shared_ptr<MemoryBudget> budget = nullptr, SampleLog* log = nullptr
+		);
+		/**
+		 * @brief Closes the \p window such that it does not receive samples anymore.
+		 */
+		void closeWindow(Window& window);
+		/**
+		 * @brief Forwards all samples recorded in \p window to \p sink from now on.
+		 * @details After this returns, the provider does not push to the previous sink anymore (such that it can be
+		 * destroyed).
+		 *
+		 * @param window A window that was opened on this provider.
+		 * @param sink The ring to push the samples to or nullptr to stop forwarding.
+		 */
+		void attachSink(Window& window, SampleRing* sink);
+
+		/**
+		 * @brief Returns the value that was last recorded for each sampled measure.
+		 */
+		std::map<tirexMeasure, double> latestSamples();
 
 		/**
 		 * @brief The set of measures that the provider can provide.
@@ -77,12 +423,12 @@ namespace tirex {
 		virtual std::set<tirexMeasure> providedMeasures() noexcept = 0;
 
 		/**
-		 * @brief Start is called once at the very beginning of collecting statistics and shortly before the command is
-		 * run.
+		 * @brief Start is called once when the provider is instantiated for tracking, i.e., before the first window is
+		 * opened.
 		 */
 		virtual void start() {}
 		/**
-		 * @brief Stop is called once at the end of collecting statistics and shortly after the command is run.
+		 * @brief Stop is called once when the provider is no longer needed, i.e., after the last window was closed.
 		 */
 		virtual void stop() {}
 		/**
@@ -91,19 +437,24 @@ namespace tirex {
 		 */
 		virtual void step() {}
 		/**
-		 * @brief Returns the statistics collected during the last measurement. This should be called once after
-		 * StatsProvider::stop().
-		 * 
-		 * @returns the statistics that were measured
+		 * @brief Runs StatsProvider::step for the given \p tick, i.e., all samples it records are stamped with
+		 * \p tick. Must not be called concurrently.
 		 */
-		virtual Stats getStats() { return {}; }
+		void stepAt(clock::time_point tick) {
+			stepTime = tick;
+			step();
+		}
 
 		/**
 		 * @brief Returns the information collected by this provider.
-		 * 
-		 * @return the system information that is collected by this provider. 
+		 * @details Only the \p measures that the provider is enabled for are collected. Since the information may be
+		 * collected while the provider is already sampling (see tirex::collectInfo), this must not modify state that
+		 * StatsProvider::step uses.
+		 *
+		 * @param measures The measures whose information is requested.
+		 * @return the system information that is collected by this provider.
 		 */
-		virtual Stats getInfo() { return {}; }
+		virtual Stats getInfo(const std::set<tirexMeasure>& measures) { return {}; }
 	};
 
 	using ProviderConstructor = std::function<std::unique_ptr<StatsProvider>(void)>;
@@ -128,15 +479,27 @@ namespace tirex {
 	};
 	extern const std::map<std::string, ProviderEntry> providers;
 
+	/**
+	 * @brief A list of instantiated providers together with their name (i.e., their key in tirex::providers).
+	 */
+	using ProviderList = std::vector<std::pair<std::string_view, std::unique_ptr<StatsProvider>>>;
+
 	/**
 	 * @brief Initializes all the providers necessary to track the requested measures.
+	 * @details The providers are constructed in parallel since some of them take a while to initialize (e.g., NVML).
 	 * 
 	 * @param[in] measures The measures that are requested.
-	 * @param[out] providers A vector of StatsProvider which will be populated with the initialized providers.
+	 * @param[out] providers A list which will be populated with the initialized providers.
 	 * @return A set of tirexMeasure which are not provided by any of the providers.
 	 */
-	std::set<tirexMeasure>
-	initProviders(std::set<tirexMeasure> measures, std::vector<std::unique_ptr<StatsProvider>>& providers);
+	std::set<tirexMeasure> initProviders(std::set<tirexMeasure> measures, ProviderList& providers);
+
+	/**
+	 * @brief Collects the information for \p measures from all \p providers in parallel.
+	 * @details Collecting the information may take long for some providers (e.g., hashing the files of a large git
+	 * repository), so each provider is queried on its own thread.
+	 */
+	Stats collectInfo(const std::vector<StatsProvider*>& providers, const std::set<tirexMeasure>& measures);
 
 	Stats makeFilteredStats(const std::set<tirexMeasure>& filter, CONVERTIBLE_TO_PAIR_CONCEPT auto&&... args) {
 		/** May be more readable when we can assume C++26 and expansion statements
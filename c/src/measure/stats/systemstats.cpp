@@ -424,13 +424,32 @@ SystemStats::CPUInfo SystemStats::getCPUInfo() {
 
 std::set<tirexMeasure> SystemStats::providedMeasures() noexcept { return measures; }
 
-void SystemStats::stop() {
+std::map<tirexMeasure, tirex::SampledMeasure> SystemStats::sampledMeasures() const {
+	return {{TIREX_RAM_USED_PROCESS_KB, {TIREX_AGG_MAX, SampleType::UInt64}},
+			{TIREX_RAM_USED_SYSTEM_MB, {TIREX_AGG_MAX}},
+			{TIREX_CPU_USED_PROCESS_PERCENT, {TIREX_AGG_MEAN}},
+			{TIREX_CPU_USED_SYSTEM_PERCENT, {TIREX_AGG_MEAN}},
+			{TIREX_CPU_FREQUENCY_MHZ, {TIREX_AGG_MAX}}};
+}
+
+std::unique_ptr<tirex::Window> SystemStats::makeWindow(std::set<tirexMeasure> measures) {
+	return std::make_unique<SystemWindow>(*this, std::move(measures));
+}
+
+void SystemStats::SystemWindow::start() {
+	starttimer = steady_clock::now();
+	startTimepoint = system_clock::now();
+	std::tie(startSysTime, startUTime) = provider.getSysAndUserTime();
+	tirex::log::debug("system", "Start systime {} ms, utime {} ms", tickToMs(startSysTime), tickToMs(startUTime));
+}
+
+void SystemStats::SystemWindow::stop() {
 	stoptimer = steady_clock::now();
 	stopTimepoint = system_clock::now();
-	std::tie(stopSysTime, stopUTime) = getSysAndUserTime();
+	std::tie(stopSysTime, stopUTime) = provider.getSysAndUserTime();
 }
 
-Stats SystemStats::getInfo() {
+Stats SystemStats::getInfo(const std::set<tirexMeasure>& measures) {
 	auto info = getSysInfo();
 	auto cpuInfo = getCPUInfo();
 
@@ -447,7 +466,7 @@ Stats SystemStats::getInfo() {
 	}
 
 	return makeFilteredStats(
-			enabled, std::pair{TIREX_VERSION_MEASURE, std::string{TIREX_VERSION}},
+			enabledOf(measures), std::pair{TIREX_VERSION_MEASURE, std::string{TIREX_VERSION}},
 			std::pair{TIREX_OS_NAME, info.osname}, std::pair{TIREX_OS_KERNEL, info.kerneldesc},
 			std::pair{TIREX_INVOCATION, nlohmann::json(getInvocationCmd())},
 			std::pair{TIREX_CPU_AVAILABLE_SYSTEM_CORES, std::to_string(cpuInfo.numCores)},
@@ -467,19 +486,33 @@ Stats SystemStats::getInfo() {
 	);
 }
 
-Stats SystemStats::getStats() {
+Stats SystemStats::SystemWindow::getStats() {
 	auto wallclocktime =
 			std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(stoptimer - starttimer).count());
 
-	return makeFilteredStats(
+	auto stats = Window::getStats();
+	stats.merge(makeFilteredStats(
 			enabled, std::pair{TIREX_TIME_START, _fmt::format("{:%FT%T%z}", startTimepoint)},
 			std::pair{TIREX_TIME_STOP, _fmt::format("{:%FT%T%z}", stopTimepoint)},
 			std::pair{TIREX_TIME_ELAPSED_WALL_CLOCK_MS, wallclocktime},
 			std::pair{TIREX_TIME_ELAPSED_USER_MS, std::to_string(tickToMs(stopUTime - startUTime))},
-			std::pair{TIREX_TIME_ELAPSED_SYSTEM_MS, std::to_string(tickToMs(stopSysTime - startSysTime))},
-			std::pair{TIREX_CPU_USED_PROCESS_PERCENT, std::cref(cpuUtil)},
-			std::pair{TIREX_CPU_USED_SYSTEM_PERCENT, std::cref(sysCpuUtil)},
-			std::pair{TIREX_CPU_FREQUENCY_MHZ, std::cref(frequency)},
-			std::pair{TIREX_RAM_USED_PROCESS_KB, std::cref(ram)}, std::pair{TIREX_RAM_USED_SYSTEM_MB, std::cref(sysRam)}
+			std::pair{TIREX_TIME_ELAPSED_SYSTEM_MS, std::to_string(tickToMs(stopSysTime - startSysTime))}
+	));
+	return stats;
+}
+
+Stats SystemStats::SystemWindow::peekStats() const {
+	auto wallclocktime = std::to_string(
+			std::chrono::duration_cast<std::chrono::milliseconds>(steady_clock::now() - starttimer).count()
 	);
+	auto [sysTime, uTime] = provider.getSysAndUserTime();
+
+	auto stats = Window::peekStats();
+	stats.merge(makeFilteredStats(
+			enabled, std::pair{TIREX_TIME_START, _fmt::format("{:%FT%T%z}", startTimepoint)},
+			std::pair{TIREX_TIME_ELAPSED_WALL_CLOCK_MS, wallclocktime},
+			std::pair{TIREX_TIME_ELAPSED_USER_MS, std::to_string(tickToMs(uTime - startUTime))},
+			std::pair{TIREX_TIME_ELAPSED_SYSTEM_MS, std::to_string(tickToMs(sysTime - startSysTime))}
+	));
+	return stats;
 }
\ No newline at end of file
@@ -49,45 +49,47 @@ namespace tirex {
 
 	private:
 		/**
-		 * @brief The starting timepoint of the tracking on the steady timer.
-		 * @details This uses the steady clock. Use startTimepoint to get the timestamp.
+		 * @brief Captures the times that are reported as the difference between the start and end of a measurement.
 		 */
-		std::chrono::steady_clock::time_point starttimer;
-		/**
-		 * @brief The stopping timepoint of the tracking on the steady timer.
-		 * @details This uses the steady clock. Use stopTimepoint to get the timestamp.
-		 */
-		std::chrono::steady_clock::time_point stoptimer;
-		/**
-		 * @brief The starting timepoint of the tracking on the system clock.
-		 * @details This uses the system clock. Use starttimer to measure runtime.
-		 */
-		std::chrono::system_clock::time_point startTimepoint;
-		/**
-		 * @brief The stopping timepoint of the tracking on the system clock.
-		 * @details This uses the system clock. Use stoptimer to measure runtime.
-		 */
-		std::chrono::system_clock::time_point stopTimepoint;
-
-		tirex::TimeSeries<unsigned> ram = ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-										  ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
-		tirex::TimeSeries<unsigned> sysRam = ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-											 ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
-		tirex::TimeSeries<unsigned> cpuUtil =
-				ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MEAN) |
-				ts::Batched(100ms, TIREX_AGG_MEAN, 300); /** \todo make agg configurable */
-		tirex::TimeSeries<unsigned> sysCpuUtil =
-				ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MEAN) |
-				ts::Batched(100ms, TIREX_AGG_MEAN, 300); /** \todo make agg configurable */
-		tirex::TimeSeries<uint32_t> frequency =
-				ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MAX) |
-				ts::Batched(100ms, TIREX_AGG_MAX, 300); /** \todo make agg configurable */
-
-		size_t startUTime, stopUTime;
-		size_t startSysTime, stopSysTime;
+		class SystemWindow final : public Window {
+		private:
+			const SystemStats& provider;
+			/**
+			 * @brief The starting timepoint of the tracking on the steady timer.
+			 * @details This uses the steady clock. Use startTimepoint to get the timestamp.
+			 */
+			std::chrono::steady_clock::time_point starttimer;
+			/**
+			 * @brief The stopping timepoint of the tracking on the steady timer.
+			 * @details This uses the steady clock. Use stopTimepoint to get the timestamp.
+			 */
+			std::chrono::steady_clock::time_point stoptimer;
+			/**
+			 * @brief The starting timepoint of the tracking on the system clock.
+			 * @details This uses the system clock. Use starttimer to measure runtime.
+			 */
+			std::chrono::system_clock::time_point startTimepoint;
+			/**
+			 * @brief The stopping timepoint of the tracking on the system clock.
+			 * @details This uses the system clock. Use stoptimer to measure runtime.
+			 */
+			std::chrono::system_clock::time_point stopTimepoint;
+
+			size_t startUTime, stopUTime;
+			size_t startSysTime, stopSysTime;
+
+		public:
+			SystemWindow(const SystemStats& provider, std::set<tirexMeasure> measures)
+					: Window(std::move(measures)), provider(provider) {}
+
+			void start() override;
+			void stop() override;
+			Stats getStats() override;
+			Stats peekStats() const override;
+		};
 
 		struct Utilization {
-			unsigned ramUsedKB;		/**< Amount of RAM used by the monitored process alone **/
+			uint64_t ramUsedKB;		/**< Amount of RAM used by the monitored process alone **/
 			uint8_t cpuUtilization; /**< CPU utilization (in percent) of the tracked process **/
 			struct {
 				unsigned ramUsedMB;		/**< Amount of RAM (in Megabytes) used by all processes **/
@@ -133,15 +135,17 @@ namespace tirex {
 		uint8_t getCPUUtilization();
 #endif
 
+	protected:
+		std::unique_ptr<Window> makeWindow(std::set<tirexMeasure> measures) override;
+		std::map<tirexMeasure, SampledMeasure> sampledMeasures() const override;
+
 	public:
 		SystemStats();
 
 		std::set<tirexMeasure> providedMeasures() noexcept override;
 		void start() override;
-		void stop() override;
 		void step() override;
-		Stats getStats() override;
-		Stats getInfo() override;
+		Stats getInfo(const std::set<tirexMeasure>& measures) override;
 
 		static constexpr const char* description = "Collects system components and utilization metrics.";
 		static const char* version;
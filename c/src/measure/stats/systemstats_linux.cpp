@@ -90,20 +90,21 @@ void SystemStats::start() {
 	for (auto tmp : getInvocationCmd())
 		tirex::log::info("linuxstats", "{}", tmp);
 	tirex::log::info("linuxstats", "Collecting resources for Process {}", pid);
-	starttimer = steady_clock::now();
-	startTimepoint = system_clock::now();
-	std::tie(startSysTime, startUTime) = getSysAndUserTime();
-	tirex::log::debug("linuxstats", "Start systime {} ms, utime {} ms", tickToMs(startSysTime), tickToMs(startUTime));
 	getUtilization(); // Call getUtilization once to init CPU Utilization tracking
 }
 
 void SystemStats::step() {
 	auto utilization = getUtilization();
-	ram.addValue(utilization.ramUsedKB);
-	sysRam.addValue(utilization.system.ramUsedMB);
-	cpuUtil.addValue(utilization.cpuUtilization);
-	sysCpuUtil.addValue(utilization.system.cpuUtilization);
-	frequency.addValue(cpuinfo_linux_get_processor_cur_frequency(0));
+	if (isEnabled(TIREX_RAM_USED_PROCESS_KB))
+		record(TIREX_RAM_USED_PROCESS_KB, utilization.ramUsedKB);
+	if (isEnabled(TIREX_RAM_USED_SYSTEM_MB))
+		record(TIREX_RAM_USED_SYSTEM_MB, utilization.system.ramUsedMB);
+	if (isEnabled(TIREX_CPU_USED_PROCESS_PERCENT))
+		record(TIREX_CPU_USED_PROCESS_PERCENT, utilization.cpuUtilization);
+	if (isEnabled(TIREX_CPU_USED_SYSTEM_PERCENT))
+		record(TIREX_CPU_USED_SYSTEM_PERCENT, utilization.system.cpuUtilization);
+	if (isEnabled(TIREX_CPU_FREQUENCY_MHZ))
+		record(TIREX_CPU_FREQUENCY_MHZ, cpuinfo_linux_get_processor_cur_frequency(0));
 }
 
 std::optional<std::string> readDistroFromLSB() {
@@ -146,16 +147,22 @@ std::string readDistro() {
 }
 
 SystemStats::Utilization SystemStats::getUtilization() {
-	Utilization utilization;
-	parseStat(utilization);
-	parseStatm(pid, utilization);
-
-	struct sysinfo info;
-	sysinfo(&info);
-	utilization.system.ramUsedMB =
-			((std::uint64_t)(info.totalram - info.freeram - info.bufferram - info.freehigh) * info.mem_unit) / 1000 /
-			1000;
-	utilization.cpuUtilization = getProcCPUUtilization();
+	// Only the files of the enabled measures are read, the others are left at zero
+	Utilization utilization{};
+	if (isEnabled(TIREX_CPU_USED_SYSTEM_PERCENT))
+		parseStat(utilization);
+	if (isEnabled(TIREX_RAM_USED_PROCESS_KB))
+		parseStatm(pid, utilization);
+
+	if (isEnabled(TIREX_RAM_USED_SYSTEM_MB)) {
+		struct sysinfo info;
+		sysinfo(&info);
+		utilization.system.ramUsedMB =
+				((std::uint64_t)(info.totalram - info.freeram - info.bufferram - info.freehigh) * info.mem_unit) /
+				1000 / 1000;
+	}
+	if (isEnabled(TIREX_CPU_USED_PROCESS_PERCENT))
+		utilization.cpuUtilization = getProcCPUUtilization();
 
 	return utilization;
 }
@@ -81,7 +81,7 @@ size_t SystemStats::tickToMs(size_t tick) {
 	return tick / 1000'000u;
 }
 
-static unsigned getRAMUsageKB(pid_t pid) {
+static uint64_t getRAMUsageKB(pid_t pid) {
 	proc_taskinfo taskInfo;
 	if (int err; (err = proc_pidinfo(pid, PROC_PIDTASKINFO, 0, &taskInfo, PROC_PIDTASKINFO_SIZE)) != 0) {
 		return taskInfo.pti_resident_size / 1000;
@@ -154,10 +154,6 @@ void SystemStats::start() {
 	for (auto tmp : getInvocationCmd())
 		tirex::log::info("macosstats", "{}", tmp);
 	tirex::log::info("macosstats", "Collecting resources for Process {}", pid);
-	starttimer = steady_clock::now();
-	startTimepoint = system_clock::now();
-	std::tie(startSysTime, startUTime) = getSysAndUserTime();
-	tirex::log::debug("macosstats", "Start systime {} ms, utime {} ms", tickToMs(startSysTime), tickToMs(startUTime));
 
 	lastTotal = lastIdle = lastProcActiveMs = 0;
 	getUtilization(); // Call getUtilization once to init CPU Utilization tracking
@@ -202,11 +198,11 @@ void SystemStats::start() {
 
 void SystemStats::step() {
 	auto utilization = getUtilization();
-	ram.addValue(utilization.ramUsedKB);
-	sysRam.addValue(utilization.system.ramUsedMB);
-	cpuUtil.addValue(utilization.cpuUtilization);
-	sysCpuUtil.addValue(utilization.system.cpuUtilization);
-	// frequency.addValue(); /** \todo implement **/
+	record(TIREX_RAM_USED_PROCESS_KB, utilization.ramUsedKB);
+	record(TIREX_RAM_USED_SYSTEM_MB, utilization.system.ramUsedMB);
+	record(TIREX_CPU_USED_PROCESS_PERCENT, utilization.cpuUtilization);
+	record(TIREX_CPU_USED_SYSTEM_PERCENT, utilization.system.cpuUtilization);
+	// record(TIREX_CPU_FREQUENCY_MHZ, ); /** \todo implement **/
 }
 
 #endif
\ No newline at end of file
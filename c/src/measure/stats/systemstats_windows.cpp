@@ -146,7 +146,7 @@ size_t SystemStats::tickToMs(size_t tick) {
 	return tick / 10000;
 }
 
-static unsigned getRAMUsageKB(HANDLE pid) {
+static uint64_t getRAMUsageKB(HANDLE pid) {
 	PROCESS_MEMORY_COUNTERS pmc;
 	if (GetProcessMemoryInfo(pid, &pmc, sizeof(pmc))) {
 		return pmc.WorkingSetSize / 1000;
@@ -249,10 +249,6 @@ std::vector<std::string> SystemStats::getInvocationCmd() {
 void SystemStats::start() {
 	for (auto tmp : getInvocationCmd())
 		tirex::log::info("windowsstats", "{}", tmp);
-	starttimer = steady_clock::now();
-	startTimepoint = system_clock::now();
-	std::tie(startSysTime, startUTime) = getSysAndUserTime();
-	tirex::log::debug("windowsstats", "Start systime {} ms, utime {} ms", tickToMs(startSysTime), tickToMs(startUTime));
 	getUtilization(); // Call getUtilization once to init CPU Utilization tracking
 	//
 	SYSTEM_INFO sysInfo;
@@ -264,10 +260,10 @@ void SystemStats::step() {
 	getProcessorFrequencies(cpuFreqs);
 
 	auto utilization = getUtilization();
-	ram.addValue(utilization.ramUsedKB);
-	sysRam.addValue(utilization.system.ramUsedMB);
-	cpuUtil.addValue(utilization.cpuUtilization);
-	sysCpuUtil.addValue(utilization.system.cpuUtilization);
-	frequency.addValue(cpuFreqs[0]);
+	record(TIREX_RAM_USED_PROCESS_KB, utilization.ramUsedKB);
+	record(TIREX_RAM_USED_SYSTEM_MB, utilization.system.ramUsedMB);
+	record(TIREX_CPU_USED_PROCESS_PERCENT, utilization.cpuUtilization);
+	record(TIREX_CPU_USED_SYSTEM_PERCENT, utilization.system.cpuUtilization);
+	record(TIREX_CPU_FREQUENCY_MHZ, cpuFreqs[0]);
 }
 #endif
\ No newline at end of file
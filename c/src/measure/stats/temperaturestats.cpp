@@ -35,28 +35,33 @@ static std::filesystem::path findCPUTemperatureSensor() {
 	return {};
 }
 
-std::optional<unsigned> TemperatureStats::readTemperature() {
-	static const std::filesystem::path sensor = []() {
-		auto path = findCPUTemperatureSensor();
-		if (path.empty())
-			tirex::log::info("temperature", "No CPU temperature sensor found; temperature will not be tracked");
-		else
-			tirex::log::info("temperature", "Reading the CPU temperature from {}", path.string());
-		return path;
-	}();
+std::filesystem::path TemperatureStats::findSensor() {
+	auto path = findCPUTemperatureSensor();
+	if (path.empty())
+		tirex::log::info("temperature", "No CPU temperature sensor found; temperature will not be tracked");
+	else
+		tirex::log::info("temperature", "Reading the CPU temperature from {}", path.string());
+	return path;
+}
+
+std::optional<double> TemperatureStats::readTemperature() const {
 	if (sensor.empty())
 		return std::nullopt;
 	std::ifstream stream(sensor);
 	if (long millidegrees; stream >> millidegrees)
-		return static_cast<unsigned>((millidegrees + 500) / 1000);
+		return static_cast<double>(millidegrees) / 1000.0;
 	return std::nullopt;
 }
 #else
-std::optional<unsigned> TemperatureStats::readTemperature() {
-	return std::nullopt; /** \todo not implemented on Windows and macOS **/
+std::filesystem::path TemperatureStats::findSensor() {
+	return {}; /** \todo not implemented on Windows and macOS **/
 }
+
+std::optional<double> TemperatureStats::readTemperature() const { return std::nullopt; }
 #endif
 
+TemperatureStats::TemperatureStats() : sensor(findSensor()) {}
+
 std::set<tirexMeasure> TemperatureStats::providedMeasures() noexcept {
 	// Only claim the temperature measure if the system actually exposes a CPU temperature sensor.
 	return readTemperature().has_value() ? measures : std::set<tirexMeasure>{};
@@ -64,9 +69,9 @@ std::set<tirexMeasure> TemperatureStats::providedMeasures() noexcept {
 
 void TemperatureStats::step() {
 	if (auto temp = readTemperature(); temp.has_value())
-		temperature.addValue(temp.value());
+		record(TIREX_CPU_TEMPERATURE_CELSIUS, temp.value());
 }
 
-Stats TemperatureStats::getStats() {
-	return makeFilteredStats(enabled, std::pair{TIREX_CPU_TEMPERATURE_CELSIUS, std::cref(temperature)});
+std::map<tirexMeasure, tirex::SampledMeasure> TemperatureStats::sampledMeasures() const {
+	return {{TIREX_CPU_TEMPERATURE_CELSIUS, {TIREX_AGG_MEAN, SampleType::Double}}};
 }
@@ -4,6 +4,7 @@
 #include "../timeseries.hpp"
 #include "provider.hpp"
 
+#include <filesystem>
 #include <optional>
 
 namespace tirex {
@@ -18,20 +19,33 @@ namespace tirex {
 	 */
 	class TemperatureStats final : public StatsProvider {
 	private:
-		tirex::TimeSeries<unsigned> temperature =
-				ts::store<unsigned>() | ts::Limit(300, TIREX_AGG_MEAN) |
-				ts::Batched(100ms, TIREX_AGG_MEAN, 300); /** \todo make agg configurable */
+		/**
+		 * @brief The sensor to read the temperature from or empty if no sensor was found.
+		 * @details The sensor is located once on construction such that it does not need to be shared (and
+		 * synchronized) between instances.
+		 */
+		const std::filesystem::path sensor;
 
 		/**
-		 * @brief Reads the current CPU temperature in degree Celsius.
+		 * @brief Locates the sensor that reports the CPU temperature.
+		 * @details Implemented per platform; returns an empty path if the system exposes no suitable sensor.
+		 */
+		static std::filesystem::path findSensor();
+
+		/**
+		 * @brief Reads the current CPU temperature in degree Celsius (with the sensor's full resolution).
 		 * @details Implemented per platform; returns empty if the system exposes no suitable temperature sensor.
 		 */
-		static std::optional<unsigned> readTemperature();
+		std::optional<double> readTemperature() const;
+
+	protected:
+		std::map<tirexMeasure, SampledMeasure> sampledMeasures() const override;
 
 	public:
+		TemperatureStats();
+
 		std::set<tirexMeasure> providedMeasures() noexcept override;
 		void step() override;
-		Stats getStats() override;
 
 		static constexpr const char* description = "Tracks the temperature of various components.";
 		static const char* version;
@@ -0,0 +1,96 @@
+#include "trackerstats.hpp"
+
+#include "../utils/threadusage.hpp"
+
+#include <algorithm>
+
+using tirex::Stats;
+using tirex::TrackerStats;
+
+const char* TrackerStats::version = nullptr;
+const std::set<tirexMeasure> TrackerStats::measures{
+		TIREX_TRACKER_JITTER_US, TIREX_TRACKER_MISSED_DEADLINES, TIREX_TRACKER_STEP_OVERRUNS,
+		TIREX_TRACKER_CPU_TIME_US, TIREX_TRACKER_STEP_LATENCY_US, TIREX_TRACKER_SYSCALLS_PER_TICK,
+		// Reported by the measurement itself (see tirexSetSampleCallback and tirexSpanBegin)
+		TIREX_TRACKER_DROPPED_SAMPLES, TIREX_TRACKER_SPANS, TIREX_TRACKER_MEMORY_KB, TIREX_TRACKER_ISOLATION
+};
+
+std::set<tirexMeasure> TrackerStats::providedMeasures() noexcept { return measures; }
+
+std::map<tirexMeasure, tirex::SampledMeasure> TrackerStats::sampledMeasures() const {
+	return {{TIREX_TRACKER_JITTER_US, {TIREX_AGG_MAX}}};
+}
+
+std::unique_ptr<tirex::Window> TrackerStats::makeWindow(std::set<tirexMeasure> measures) {
+	return std::make_unique<TrackerWindow>(*this, std::move(measures));
+}
+
+void TrackerStats::recordTick(clock::time_point tick, std::chrono::nanoseconds lateness, size_t missed) {
+	auto us = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+	record(TIREX_TRACKER_JITTER_US, static_cast<unsigned>(std::max<decltype(us)>(us, 0)), tick);
+	missedDeadlines = missed;
+}
+
+void TrackerStats::recordProvider(std::string_view provider, ProviderCost cost) {
+	std::lock_guard lock(windowsMutex);
+	costs.insert_or_assign(std::string{provider}, std::move(cost));
+}
+
+void TrackerStats::recordMonitor(size_t ticks, uint64_t cpuNs) {
+	std::lock_guard lock(windowsMutex);
+	this->ticks = ticks;
+	monitorCpuNs = cpuNs;
+}
+
+/**
+ * @brief Returns the difference between two totals of a counter. The provider may have been restarted in between, in
+ * which case its counter was reset and \p to is returned.
+ */
+template <typename T>
+static T since(T from, T to) {
+	return (from <= to) ? to - from : to;
+}
+
+void TrackerStats::TrackerWindow::start() {
+	startMissed = provider.missedDeadlines;
+	startTicks = provider.ticks;
+	startMonitorCpuNs = provider.monitorCpuNs;
+	startCosts = provider.costs;
+}
+
+void TrackerStats::TrackerWindow::stop() {
+	stopMissed = provider.missedDeadlines;
+	ticks = since(startTicks, provider.ticks);
+	cpuNs = since(startMonitorCpuNs, provider.monitorCpuNs);
+	for (const auto& [name, cost] : provider.costs) {
+		auto it = startCosts.find(name);
+		auto start = (it != startCosts.end()) ? it->second : ProviderCost{};
+		overruns[name] = since(start.overruns, cost.overruns);
+		cpuNs += since(start.cpuNs, cost.cpuNs);
+		syscalls += since(start.syscalls, cost.syscalls);
+		latencies[name] = utils::summarize(cost.latencyNs.since(start.latencyNs), 1e-3);
+	}
+}
+
+Stats TrackerStats::TrackerWindow::getStats() {
+	auto stats = Window::getStats();
+	stats.merge(makeFilteredStats(
+			enabled, std::pair{TIREX_TRACKER_MISSED_DEADLINES, std::to_string(stopMissed - startMissed)},
+			std::pair{TIREX_TRACKER_STEP_OVERRUNS, overruns},
+			std::pair{TIREX_TRACKER_CPU_TIME_US, std::to_string(cpuNs / 1000)},
+			std::pair{TIREX_TRACKER_STEP_LATENCY_US, latencies}
+	));
+	if (utils::SyscallCounter::supported && enabled.contains(TIREX_TRACKER_SYSCALLS_PER_TICK)) {
+		auto perTick = (ticks == 0) ? 0.0 : static_cast<double>(syscalls) / static_cast<double>(ticks);
+		stats.insert_or_assign(TIREX_TRACKER_SYSCALLS_PER_TICK, std::to_string(perTick));
+	}
+	return stats;
+}
+
+Stats TrackerStats::TrackerWindow::peekStats() const {
+	auto stats = Window::peekStats();
+	stats.merge(makeFilteredStats(
+			enabled, std::pair{TIREX_TRACKER_MISSED_DEADLINES, std::to_string(provider.missedDeadlines - startMissed)}
+	));
+	return stats;
+}
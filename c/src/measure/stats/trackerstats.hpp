@@ -0,0 +1,108 @@
+#ifndef STATS_TRACKERSTATS_HPP
+#define STATS_TRACKERSTATS_HPP
+
+#include "../utils/histogram.hpp"
+#include "provider.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace tirex {
+	/**
+	 * @brief Reports on the tracker itself, i.e., how accurately the monitor thread kept its sampling schedule and how
+	 * much the tracker perturbs the workload.
+	 * @details Other than the remaining providers, the tracker stats do not poll any data source. Instead, the monitor
+	 * thread reports every tick to the provider via TrackerStats::recordTick and the sampler reports the cost of the
+	 * monitor thread and of every provider via TrackerStats::recordMonitor and TrackerStats::recordProvider.
+	 */
+	class TrackerStats final : public StatsProvider {
+	public:
+		/**
+		 * @brief The totals of what polling a provider cost since it was started.
+		 */
+		struct ProviderCost final {
+			/** @brief The steps that were dropped since the previous step was still running. **/
+			size_t overruns = 0;
+			/** @brief The CPU time the provider's steps spent. **/
+			uint64_t cpuNs = 0;
+			/** @brief The reading and writing system calls the provider's steps issued. **/
+			uint64_t syscalls = 0;
+			/** @brief The distribution of the time each step took. **/
+			utils::LogHistogram<>::Snapshot latencyNs;
+		};
+
+	private:
+		std::atomic<size_t> missedDeadlines = 0;
+		/** @brief The totals per provider. Guarded by StatsProvider::windowsMutex. **/
+		std::map<std::string, ProviderCost, std::less<>> costs;
+		/** @brief The ticks and CPU time of the monitor thread. Guarded by StatsProvider::windowsMutex. **/
+		size_t ticks = 0;
+		uint64_t monitorCpuNs = 0;
+
+		/**
+		 * @brief Reports the difference of the tracker's counters between the start and end of a measurement.
+		 */
+		class TrackerWindow final : public Window {
+		private:
+			const TrackerStats& provider;
+			size_t startMissed = 0;
+			size_t stopMissed = 0;
+			size_t startTicks = 0;
+			uint64_t startMonitorCpuNs = 0;
+			std::map<std::string, ProviderCost, std::less<>> startCosts;
+			nlohmann::json overruns = nlohmann::json::object();
+			nlohmann::json latencies = nlohmann::json::object();
+			uint64_t cpuNs = 0;
+			uint64_t syscalls = 0;
+			size_t ticks = 0;
+
+		public:
+			TrackerWindow(const TrackerStats& provider, std::set<tirexMeasure> measures)
+					: Window(std::move(measures)), provider(provider) {}
+
+			void start() override;
+			void stop() override;
+			Stats getStats() override;
+			Stats peekStats() const override;
+		};
+
+	protected:
+		std::unique_ptr<Window> makeWindow(std::set<tirexMeasure> measures) override;
+		std::map<tirexMeasure, SampledMeasure> sampledMeasures() const override;
+
+	public:
+		std::set<tirexMeasure> providedMeasures() noexcept override;
+
+		/**
+		 * @brief Called by the monitor thread once per tick.
+		 *
+		 * @param tick The tick's deadline, which the jitter sample is stamped with.
+		 * @param lateness How late the monitor thread woke up with respect to the tick's deadline.
+		 * @param missed The total number of deadlines the monitor thread skipped so far since it overran them.
+		 */
+		void recordTick(clock::time_point tick, std::chrono::nanoseconds lateness, size_t missed);
+		/**
+		 * @brief Updates the totals of a provider. Called before windows are opened or closed.
+		 *
+		 * @param provider The name of the provider.
+		 * @param cost What polling \p provider cost since it was started.
+		 */
+		void recordProvider(std::string_view provider, ProviderCost cost);
+		/**
+		 * @brief Updates the totals of the monitor thread. Called before windows are opened or closed.
+		 *
+		 * @param ticks The number of ticks the monitor thread took so far.
+		 * @param cpuNs The CPU time the monitor thread spent so far.
+		 */
+		void recordMonitor(size_t ticks, uint64_t cpuNs);
+
+		static constexpr const char* description =
+				"Reports on the sampling accuracy and overhead of the tracker itself.";
+		static const char* version;
+		static const std::set<tirexMeasure> measures;
+	};
+} // namespace tirex
+
+#endif
@@ -2,18 +2,50 @@
 #define MEASURE_TIMESERIES_HPP
 
 #include "../abort.hpp"
+#include "utils/compression.hpp"
+#include "utils/ddsketch.hpp"
+#include "utils/simd.hpp"
 
 #include <tirex_tracker.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace tirex {
 
+	namespace ts {
+		/**
+		 * @brief The mean and variance of a signal whose values hold until the next value arrives, where every value
+		 * is weighted by how long it held (see ts::TimeWeighted).
+		 * @details Unlike averaging by the number of values, this is not biased towards periods in which values
+		 * arrived more often (e.g., since batches were cut short or steps overran). The moments are updated
+		 * incrementally (West's algorithm), which is numerically stable.
+		 */
+		struct TimeWeightedMoments final {
+			double duration = 0; /**< @brief The total time that the values held, in milliseconds. **/
+			double mean = 0;
+			double m2 = 0; /**< @brief The weighted sum of squared differences from the mean. **/
+
+			void add(double value, double weight) noexcept {
+				if (weight <= 0)
+					return;
+				duration += weight;
+				auto delta = value - mean;
+				mean += delta * weight / duration;
+				m2 += weight * delta * (value - mean);
+			}
+			double variance() const noexcept { return (duration > 0) ? m2 / duration : 0.0; }
+		};
+	} // namespace ts
+
 	/**
 	 * @brief The details namespace contains implementation details and is not part of the public API.
 	 */
@@ -84,15 +116,49 @@ namespace tirex {
 
 			virtual void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept = 0;
 			virtual std::chrono::milliseconds currentTimestamp() const noexcept = 0;
+			virtual std::chrono::milliseconds lastTimestamp() const noexcept = 0;
+			virtual void updateLast(const T& value) noexcept = 0;
+			virtual void decimate(T (*combine)(const T&, const T&)) noexcept = 0;
+			virtual void
+			replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept = 0;
 			virtual const T& maxValue() const noexcept = 0;
 			virtual const T& minValue() const noexcept = 0;
 			virtual const T& avgValue() const noexcept = 0;
-			virtual std::tuple<std::vector<std::chrono::milliseconds>&, std::vector<T>&> timeseries() noexcept = 0;
-			virtual std::tuple<const std::vector<std::chrono::milliseconds>&, const std::vector<T>&>
-			timeseries() const noexcept = 0;
+			virtual std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const = 0;
+
+			virtual const utils::DDSketch* sketch() const noexcept = 0;
+			virtual const ts::TimeWeightedMoments* moments() const noexcept = 0;
 
 			virtual size_t size() const noexcept = 0;
+			virtual size_t memoryUsage() const noexcept = 0;
 		};
+
+		/**
+		 * @brief Halves the number of points by merging every pair of neighboring points into one.
+		 * @details The merged point takes the later timestamp and \p combine of both values. If the number of points is
+		 * odd, the last point is kept as is. Combinations that name their vectorized counterpart (see ts::agg) are
+		 * computed by utils::simd::pairwise.
+		 */
+		template <typename T, typename Combine>
+		void decimate(std::vector<std::chrono::milliseconds>& timepoints, std::vector<T>& values, Combine&& combine) {
+			size_t num = timepoints.size() / 2;
+			for (size_t i = 0; i < num; ++i)
+				timepoints[i] = timepoints[2 * i + 1];
+			using Fn = std::remove_cvref_t<Combine>;
+			if constexpr (utils::simd::Vectorizable<T> && requires { Fn::pairwise; }) {
+				utils::simd::pairwise(std::span<const T>(values), values.data(), Fn::pairwise);
+			} else {
+				for (size_t i = 0; i < num; ++i)
+					values[i] = combine(values[2 * i], values[2 * i + 1]);
+			}
+			if (timepoints.size() % 2 != 0) {
+				timepoints[num] = timepoints.back();
+				values[num] = values.back();
+				++num;
+			}
+			timepoints.resize(num);
+			values.resize(num);
+		}
 	} // namespace ts::details
 
 	template <typename T>
@@ -112,6 +178,40 @@ namespace tirex {
 			impl->addValue(value, timestamp);
 		}
 		std::chrono::milliseconds currentTimestamp() const noexcept { return impl->currentTimestamp(); }
+		/**
+		 * @brief The timestamp of the most recent point.
+		 * @details It is undefined behavior to call this on an empty time series.
+		 */
+		std::chrono::milliseconds lastTimestamp() const noexcept { return impl->lastTimestamp(); }
+		/**
+		 * @brief Replaces the value of the most recent point (e.g., to merge a value into the current batch). This does
+		 * not change the aggregates (see TimeSeries::maxValue).
+		 * @details It is undefined behavior to call this on an empty time series.
+		 */
+		void updateLast(const T& value) noexcept { impl->updateLast(value); }
+		/**
+		 * @brief Halves the number of points by merging every pair of neighboring points with \p combine. This does
+		 * not change the aggregates (see TimeSeries::maxValue).
+		 */
+		void decimate(T (*combine)(const T&, const T&)) noexcept { impl->decimate(combine); }
+		/**
+		 * @brief Reduces the points to free memory (e.g., for a MemoryBudget). This does not change the aggregates
+		 * (see TimeSeries::maxValue).
+		 * @details Downsampled series merge every two neighboring buckets into one, which keeps the smallest and the
+		 * largest point of each, and keep at most half as many points from then on. Rollup series coarsen their rings
+		 * instead, which does not free memory since their slots are allocated up front. Series that store every point
+		 * keep every second one.
+		 */
+		void shrink() noexcept {
+			impl->decimate(+[](const T&, const T& b) { return b; });
+		}
+		/**
+		 * @brief Replaces all points (e.g., by a downsampled version of them). This does not change the aggregates
+		 * (see TimeSeries::maxValue).
+		 */
+		void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+			impl->replace(std::move(timepoints), std::move(values));
+		}
 
 		/**
 		 * @brief The largest value encountered in the time series.
@@ -137,198 +237,1113 @@ namespace tirex {
 		/**
 		 * @brief A pair of timepoint and data vectors. Where the i-th data entry denotes the value of the time series
 		 * at the i-th timepoint.
+		 * @details The vectors are a copy since the points may be stored compressed (see ts::compressed).
 		 * 
 		 * @return A pair of timepoint and data vectors.
 		 */
-		std::tuple<std::vector<std::chrono::milliseconds>&, std::vector<T>&> timeseries() noexcept {
+		std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
 			return impl->timeseries();
 		}
 		/**
-		 * @brief A pair of timepoint and data vectors. Where the i-th data entry denotes the value of the time series
-		 * at the i-th timepoint.
-		 * 
-		 * @return A pair of timepoint and data vectors.
+		 * @brief The quantile sketch over all values encountered in the time series or nullptr if the time series does
+		 * not keep one (see ts::Quantiles).
 		 */
-		std::tuple<const std::vector<std::chrono::milliseconds>&, const std::vector<T>&> timeseries() const noexcept {
-			return impl->timeseries();
-		}
+		const utils::DDSketch* sketch() const noexcept { return impl->sketch(); }
+		/**
+		 * @brief The time-weighted mean and variance of the values or nullptr if the time series does not keep them
+		 * (see ts::TimeWeighted).
+		 */
+		const ts::TimeWeightedMoments* moments() const noexcept { return impl->moments(); }
 		size_t size() const noexcept { return impl->size(); }
+		/** @brief The number of bytes that the time series allocated for its points. */
+		size_t memoryUsage() const noexcept { return impl->memoryUsage(); }
 	};
 
 	namespace ts::details {
 		/**
-	 * @brief The timeseries datatype represents a compressed timestamped sequence of datapoints.
-	 * 
-	 * @tparam T The datatype of each entry of the timeseries.
-	 */
+		 * @brief A running aggregate that does not aggregate but keeps the most recent value (used for TIREX_AGG_NO).
+		 */
 		template <typename T>
-		struct StoreImpl final : public TimeSeriesImpl<T> {
-			using clock = std::chrono::high_resolution_clock;
+		struct LastAggFn final : public AggFn<T> {
+			T val;
+			LastAggFn() { reset(); }
+			T update(const T& next) override { return val = next; }
+			void reset() override { val = {}; }
+		};
 
-		private:
-			clock::time_point starttime;
+		/**
+		 * @brief Forwards to an AggFn that is selected at runtime (see ts::Batched).
+		 */
+		template <typename T>
+		struct DynamicAggFn final {
+			std::unique_ptr<AggFn<T>> fn;
+			T update(const T& next) { return fn->update(next); }
+			void reset() { fn->reset(); }
+		};
+
+		/**
+		 * @brief The running aggregates over all values that were added to a time series.
+		 */
+		template <typename T>
+		struct Aggregates final {
 			T max;			 /**< @brief Maximum value encountered in the time series **/
 			T min;			 /**< @brief Minimum value encountered in the time series **/
 			T avg;			 /**< @brief Average value encountered in the time series **/
 			double mean;	 /**< @brief Running mean, used to compute the average **/
 			size_t numAdded; /**< @brief Number of values added, used to compute the average **/
+
+			Aggregates() : max(), min(), avg(), mean(0), numAdded(0) {}
+
+			void add(const T& value) noexcept {
+				if (numAdded == 0)
+					max = min = value;
+				else {
+					max = std::max(max, value);
+					min = std::min(min, value);
+				}
+				numAdded += 1;
+				mean += (static_cast<double>(value) - mean) / static_cast<double>(numAdded);
+				avg = static_cast<T>(mean);
+			}
+		};
+
+		/**
+		 * @brief The timeseries datatype represents a timestamped sequence of datapoints.
+		 *
+		 * @tparam T The datatype of each entry of the timeseries.
+		 */
+		template <typename T>
+		struct StoreStage final {
+			using value_type = T;
+			using clock = std::chrono::steady_clock;
+
+		private:
+			clock::time_point starttime;
+			Aggregates<T> aggregates;
 			std::vector<std::chrono::milliseconds> timepoints;
 			std::vector<T> values;
 
-			static T maxFn(const T& a, const T& b) { return std::max(a, b); }
-			static T minFn(const T& a, const T& b) { return std::min(a, b); }
-
 		public:
-			StoreImpl() : StoreImpl(clock::now()) {}
-			explicit StoreImpl(clock::time_point starttime)
-					: starttime(starttime), max(), min(), avg(), mean(0), numAdded(0), timepoints(), values() {}
-			StoreImpl(StoreImpl&& other) = default;
+			StoreStage() : StoreStage(clock::now()) {}
+			explicit StoreStage(clock::time_point starttime)
+					: starttime(starttime), aggregates(), timepoints(), values() {}
+			StoreStage(StoreStage&& other) = default;
 
-			StoreImpl& operator=(StoreImpl&& other) = default;
-			std::chrono::milliseconds currentTimestamp() const noexcept override {
+			StoreStage& operator=(StoreStage&& other) = default;
+			std::chrono::milliseconds currentTimestamp() const noexcept {
 				return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - starttime);
-				;
 			}
 
-			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept override {
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
 				timepoints.emplace_back(timestamp);
 				values.emplace_back(value);
-				if (numAdded == 0)
-					max = min = value;
-				else {
-					max = maxFn(max, value);
-					min = minFn(min, value);
-				}
-				numAdded += 1;
-				mean += (static_cast<double>(value) - mean) / static_cast<double>(numAdded);
-				avg = static_cast<T>(mean);
+				aggregates.add(value);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept { return timepoints.back(); }
+			void updateLast(const T& value) noexcept { values.back() = value; }
+			template <typename Combine>
+			void decimate(Combine&& combine) noexcept {
+				details::decimate(timepoints, values, combine);
+			}
+			void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+				this->timepoints = std::move(timepoints);
+				this->values = std::move(values);
 			}
 
-			const T& maxValue() const noexcept override { return max; }
-			const T& minValue() const noexcept override { return min; }
-			const T& avgValue() const noexcept override { return avg; }
-			std::tuple<std::vector<std::chrono::milliseconds>&, std::vector<T>&> timeseries() noexcept override {
+			const T& maxValue() const noexcept { return aggregates.max; }
+			const T& minValue() const noexcept { return aggregates.min; }
+			const T& avgValue() const noexcept { return aggregates.avg; }
+			const utils::DDSketch* sketch() const noexcept { return nullptr; }
+			const TimeWeightedMoments* moments() const noexcept { return nullptr; }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
 				return {timepoints, values};
 			}
-			std::tuple<const std::vector<std::chrono::milliseconds>&, const std::vector<T>&>
-			timeseries() const noexcept override {
-				return {timepoints, values};
+
+			size_t size() const noexcept { return timepoints.size(); }
+			size_t memoryUsage() const noexcept {
+				return timepoints.capacity() * sizeof(std::chrono::milliseconds) + values.capacity() * sizeof(T);
+			}
+		};
+
+		/**
+		 * @brief Like StoreStage but keeps the points compressed in a single bit stream.
+		 * @details The timestamps are encoded by their delta of deltas (see utils::DeltaOfDeltaCodec) and the values by
+		 * their difference to the previous value (see utils::ValueCodec). For samples taken at a fixed interval whose
+		 * value changes only slightly, a point takes one to two bytes instead of 8 + sizeof(T), such that a measure
+		 * that is sampled every 10ms for hours at full resolution only takes a few MB.
+		 *
+		 * The most recent point is kept uncompressed since it may still be updated (e.g., by BatchedStage). Decimating
+		 * (e.g., by LimitStage) decodes and re-encodes all points.
+		 *
+		 * @tparam T The datatype of each entry of the timeseries (an integral or floating point type).
+		 */
+		template <typename T>
+		struct CompressedStage final {
+			using value_type = T;
+			using clock = std::chrono::steady_clock;
+
+		private:
+			clock::time_point starttime;
+			Aggregates<T> aggregates;
+			utils::BitStream stream;
+			utils::DeltaOfDeltaCodec timeEncoder;
+			utils::ValueCodec<T> valueEncoder;
+			size_t numSealed = 0; /**< The number of points that were written to the stream. **/
+			std::chrono::milliseconds openTimestamp{};
+			T openValue{};
+			bool hasOpen = false;
+
+			void seal() {
+				timeEncoder.encode(stream, openTimestamp.count());
+				valueEncoder.encode(stream, openValue);
+				++numSealed;
+			}
+
+		public:
+			CompressedStage() : CompressedStage(clock::now()) {}
+			explicit CompressedStage(clock::time_point starttime) : starttime(starttime) {}
+			CompressedStage(CompressedStage&& other) = default;
+
+			CompressedStage& operator=(CompressedStage&& other) = default;
+			std::chrono::milliseconds currentTimestamp() const noexcept {
+				return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - starttime);
+			}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasOpen)
+					seal();
+				openTimestamp = timestamp;
+				openValue = value;
+				hasOpen = true;
+				aggregates.add(value);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept { return openTimestamp; }
+			void updateLast(const T& value) noexcept { openValue = value; }
+			template <typename Combine>
+			void decimate(Combine&& combine) noexcept {
+				auto [timepoints, values] = timeseries();
+				details::decimate(timepoints, values, combine);
+				replace(std::move(timepoints), std::move(values));
+			}
+			void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+				stream = {}; // Releases the memory since the points usually shrink
+				timeEncoder = {};
+				valueEncoder = {};
+				numSealed = 0;
+				hasOpen = !timepoints.empty();
+				if (!hasOpen)
+					return;
+				// All points but the most recent one are sealed, whose timestamps' deltas are computed at once
+				std::vector<int64_t> deltas(timepoints.size() - 1);
+				utils::simd::deltas(std::span(timepoints).first(deltas.size()), {}, deltas.data());
+				for (; numSealed < deltas.size(); ++numSealed) {
+					timeEncoder.encodeDelta(stream, deltas[numSealed]);
+					valueEncoder.encode(stream, values[numSealed]);
+				}
+				openTimestamp = timepoints.back();
+				openValue = values.back();
+			}
+
+			const T& maxValue() const noexcept { return aggregates.max; }
+			const T& minValue() const noexcept { return aggregates.min; }
+			const T& avgValue() const noexcept { return aggregates.avg; }
+			const utils::DDSketch* sketch() const noexcept { return nullptr; }
+			const TimeWeightedMoments* moments() const noexcept { return nullptr; }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
+				std::vector<std::chrono::milliseconds> timepoints;
+				std::vector<T> values;
+				timepoints.reserve(size());
+				values.reserve(size());
+				utils::BitStream::Reader reader(stream);
+				utils::DeltaOfDeltaCodec timeDecoder;
+				utils::ValueCodec<T> valueDecoder;
+				for (size_t i = 0; i < numSealed; ++i) {
+					timepoints.emplace_back(timeDecoder.decode(reader));
+					values.emplace_back(valueDecoder.decode(reader));
+				}
+				if (hasOpen) {
+					timepoints.emplace_back(openTimestamp);
+					values.emplace_back(openValue);
+				}
+				return {std::move(timepoints), std::move(values)};
 			}
 
-			size_t size() const noexcept override { return timepoints.size(); }
+			size_t size() const noexcept { return numSealed + (hasOpen ? 1 : 0); }
+			size_t memoryUsage() const noexcept { return stream.capacity(); }
 		};
+	} // namespace ts::details
 
+	namespace ts {
+		/**
+		 * @brief One ring of a rollup time series (see ts::rollup): it keeps up to \p slots slots, each of which
+		 * summarizes the values within \p resolution.
+		 */
+		struct Resolution final {
+			std::chrono::milliseconds resolution;
+			size_t slots;
+		};
+		/**
+		 * @brief 100ms for the last 5 minutes, 1s for the hour before, and 1min (coarsening further if needed) for
+		 * everything older.
+		 */
+		inline const std::vector<Resolution> defaultResolutions{
+				{std::chrono::milliseconds{100}, 3000},
+				{std::chrono::seconds{1}, 3600},
+				{std::chrono::minutes{1}, 1440},
+		};
+	} // namespace ts
+
+	namespace ts::details {
+		/**
+		 * @brief Summarizes the values of a time interval of a RollupRing.
+		 */
 		template <typename T>
-		struct BatchedImpl final : public TimeSeriesImpl<T> {
-			std::chrono::milliseconds batchintervall;
-			std::unique_ptr<AggFn<T>> aggfn;
-			size_t startBatchingAtSize;
-			TimeSeries<T> ts;
+		struct RollupSlot final {
+			std::chrono::milliseconds start; /**< The start of the interval. **/
+			T min{};
+			T max{};
+			double sum = 0;
+			uint64_t count = 0;
 
-			[[nodiscard]] static inline std::unique_ptr<AggFn<T>> enumToAggFn(tirexAggregateFn fn) {
-				switch (fn) {
-				case TIREX_AGG_NO:
-					return nullptr;
+			void add(const T& value) noexcept {
+				min = (count == 0) ? value : std::min(min, value);
+				max = (count == 0) ? value : std::max(max, value);
+				sum += static_cast<double>(value);
+				++count;
+			}
+			void merge(const RollupSlot& other) noexcept {
+				if (other.count == 0)
+					return;
+				min = (count == 0) ? other.min : std::min(min, other.min);
+				max = (count == 0) ? other.max : std::max(max, other.max);
+				sum += other.sum;
+				count += other.count;
+			}
+			/** @brief The value that represents the slot: its maximum, minimum, or (otherwise) mean. */
+			T value(tirexAggregateFn agg) const noexcept {
+				switch (agg) {
 				case TIREX_AGG_MAX:
-					return std::make_unique<MaxAggFn<T>>();
+					return max;
 				case TIREX_AGG_MIN:
-					return std::make_unique<MinAggFn<T>>();
-				case TIREX_AGG_MEAN:
-					return std::make_unique<AvgAggFn<T>>();
+					return min;
 				default:
-					tirex::abort(tirexLogLevel::CRITICAL, "enumToAggFn was given an invalid value");
-					return nullptr;
-				};
+					return static_cast<T>(sum / static_cast<double>(count));
+				}
 			}
+		};
 
-			BatchedImpl(
-					std::chrono::milliseconds batchintervall, tirexAggregateFn agg, size_t startBatchingAtSize,
-					TimeSeries<T>&& ts
-			)
-					: batchintervall(batchintervall), aggfn(enumToAggFn(agg)),
-					  startBatchingAtSize(std::max(size_t(1), startBatchingAtSize)), ts(std::move(ts)) {}
+		/**
+		 * @brief A fixed-size ring of slots of the same resolution, ordered by time.
+		 */
+		template <typename T>
+		class RollupRing final {
+		private:
+			std::chrono::milliseconds resolution;
+			std::vector<RollupSlot<T>> slots;
+			size_t head = 0; /**< The index of the newest slot. **/
+			size_t num = 0;
 
-			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept override {
-				const auto& [timepoints, values] = timeseries();
-				if (size() >= startBatchingAtSize &&
-					(timestamp - timepoints.back()) < batchintervall) { // Add to previous batch
-					values.back() = aggfn->update(value);
-				} else { // Start New Batch
-					aggfn->reset();
-					ts.addValue(aggfn->update(value), timestamp);
+		public:
+			explicit RollupRing(const Resolution& resolution)
+					: resolution(std::max(resolution.resolution, std::chrono::milliseconds{1})),
+					  slots(std::max(size_t(2), resolution.slots)) {}
+
+			size_t size() const noexcept { return num; }
+			bool full() const noexcept { return num == slots.size(); }
+			/** @brief The \p i -th slot in the order of time. */
+			const RollupSlot<T>& at(size_t i) const noexcept {
+				return slots[(head + slots.size() + 1 - num + i) % slots.size()];
+			}
+			RollupSlot<T>& newest() noexcept { return slots[head]; }
+			const RollupSlot<T>& newest() const noexcept { return slots[head]; }
+			/** @brief The start of the slot that \p timestamp falls into. */
+			std::chrono::milliseconds align(std::chrono::milliseconds timestamp) const noexcept {
+				return timestamp - timestamp % resolution;
+			}
+
+			/**
+			 * @brief Appends \p slot as the newest slot.
+			 * @return The oldest slot if it had to make room for \p slot.
+			 */
+			std::optional<RollupSlot<T>> push(const RollupSlot<T>& slot) noexcept {
+				std::optional<RollupSlot<T>> evicted;
+				if (full())
+					evicted = at(0);
+				else
+					++num;
+				head = (head + 1) % slots.size();
+				slots[head] = slot;
+				return evicted;
+			}
+			/** @brief Doubles the resolution, merging the slots that fall into the same, coarser slot. */
+			void coarsen() {
+				resolution *= 2;
+				std::vector<RollupSlot<T>> merged;
+				for (size_t i = 0; i < num; ++i) {
+					auto slot = at(i);
+					if (!merged.empty() && merged.back().start == align(slot.start)) {
+						merged.back().merge(slot);
+					} else {
+						slot.start = align(slot.start);
+						merged.push_back(slot);
+					}
 				}
+				std::copy(merged.begin(), merged.end(), slots.begin());
+				num = merged.size();
+				head = (num == 0) ? 0 : num - 1;
 			}
-			std::chrono::milliseconds currentTimestamp() const noexcept override { return ts.currentTimestamp(); }
-			const T& maxValue() const noexcept override { return ts.maxValue(); }
-			const T& minValue() const noexcept override { return ts.minValue(); }
-			const T& avgValue() const noexcept override { return ts.avgValue(); }
-			std::tuple<std::vector<std::chrono::milliseconds>&, std::vector<T>&> timeseries() noexcept override {
-				return ts.timeseries();
+			void clear() noexcept { head = num = 0; }
+			size_t memoryUsage() const noexcept { return slots.capacity() * sizeof(RollupSlot<T>); }
+		};
+
+		/**
+		 * @brief Keeps the time series in rings of decreasing resolution (like a round-robin database).
+		 * @details New values are summarized (minimum, maximum, and mean) in the slots of the finest ring. Once a ring
+		 * is full, its oldest slot is merged into the next coarser ring, such that the rings cover consecutive periods
+		 * with the most recent one in the finest detail. Instead of dropping slots, the coarsest ring doubles its
+		 * resolution whenever it is full, such that the whole measurement remains covered. Hence, adding a value takes
+		 * amortized constant time and the memory is bounded by the number of slots, regardless of how long the
+		 * measurement runs.
+		 *
+		 * Each slot is reported as a single point (at the slot's start) whose value is selected by \p agg. The most
+		 * recent value is not added to its slot until the next value arrives, such that it can still be updated (e.g.,
+		 * by BatchedStage).
+		 *
+		 * @tparam T The datatype of each entry of the timeseries.
+		 */
+		template <typename T>
+		struct RollupStage final {
+			using value_type = T;
+			using clock = std::chrono::steady_clock;
+
+		private:
+			clock::time_point starttime;
+			Aggregates<T> aggregates;
+			std::vector<RollupRing<T>> rings; /**< From the finest to the coarsest resolution. **/
+			tirexAggregateFn agg;
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false; /**< Whether lastValue still has to be added to the finest ring's newest slot. **/
+
+			void insert(size_t ring, RollupSlot<T> slot) {
+				auto& target = rings[ring];
+				auto start = target.align(slot.start);
+				while (target.full() && ring + 1 == rings.size() && start > target.newest().start) {
+					target.coarsen();
+					start = target.align(slot.start);
+				}
+				if (target.size() > 0 && start <= target.newest().start) { // Values that arrive late join the newest
+					target.newest().merge(slot);
+					return;
+				}
+				slot.start = start;
+				if (auto evicted = target.push(slot); evicted && ring + 1 < rings.size())
+					insert(ring + 1, *evicted);
+			}
+			void feed(const T& value, const std::chrono::milliseconds& timestamp) {
+				if (hasLast)
+					rings.front().newest().add(lastValue);
+				insert(0, RollupSlot<T>{.start = timestamp});
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+			}
+
+		public:
+			RollupStage(clock::time_point starttime, const std::vector<Resolution>& resolutions, tirexAggregateFn agg)
+					: starttime(starttime), agg(agg) {
+				for (const auto& resolution : resolutions)
+					rings.emplace_back(resolution);
+				if (rings.empty())
+					rings.emplace_back(Resolution{std::chrono::milliseconds{1}, 2});
+			}
+			RollupStage(RollupStage&& other) = default;
+
+			RollupStage& operator=(RollupStage&& other) = default;
+			std::chrono::milliseconds currentTimestamp() const noexcept {
+				return std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - starttime);
+			}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				feed(value, timestamp);
+				aggregates.add(value);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept { return lastTime; }
+			void updateLast(const T& value) noexcept { lastValue = value; }
+			/** @brief Coarsens every ring, which roughly halves the number of points. */
+			template <typename Combine>
+			void decimate(Combine&&) noexcept {
+				for (auto& ring : rings)
+					ring.coarsen();
+			}
+			void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+				for (auto& ring : rings)
+					ring.clear();
+				hasLast = false;
+				for (size_t i = 0; i < timepoints.size(); ++i)
+					feed(values[i], timepoints[i]);
+			}
+
+			const T& maxValue() const noexcept { return aggregates.max; }
+			const T& minValue() const noexcept { return aggregates.min; }
+			const T& avgValue() const noexcept { return aggregates.avg; }
+			const utils::DDSketch* sketch() const noexcept { return nullptr; }
+			const TimeWeightedMoments* moments() const noexcept { return nullptr; }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
+				std::vector<std::chrono::milliseconds> timepoints;
+				std::vector<T> values;
+				timepoints.reserve(size());
+				values.reserve(size());
+				for (size_t ring = rings.size(); ring-- > 0;) { // From the oldest to the most recent period
+					for (size_t i = 0; i < rings[ring].size(); ++i) {
+						auto slot = rings[ring].at(i);
+						if (ring == 0 && i + 1 == rings[ring].size() && hasLast)
+							slot.add(lastValue);
+						timepoints.emplace_back(slot.start);
+						values.emplace_back(slot.value(agg));
+					}
+				}
+				return {std::move(timepoints), std::move(values)};
+			}
+
+			size_t size() const noexcept {
+				size_t num = 0;
+				for (const auto& ring : rings)
+					num += ring.size();
+				return num;
+			}
+			size_t memoryUsage() const noexcept {
+				size_t bytes = rings.capacity() * sizeof(RollupRing<T>);
+				for (const auto& ring : rings)
+					bytes += ring.memoryUsage();
+				return bytes;
+			}
+		};
+
+		/**
+		 * @brief The base of stages that transform the values before handing them to the next stage (\p ts), which
+		 * answers all accessors.
+		 */
+		template <typename T, typename Next>
+		struct ForwardingStage {
+			using value_type = T;
+
+			Next ts;
+
+			explicit ForwardingStage(Next&& ts) : ts(std::move(ts)) {}
+
+			std::chrono::milliseconds currentTimestamp() const noexcept { return ts.currentTimestamp(); }
+			std::chrono::milliseconds lastTimestamp() const noexcept { return ts.lastTimestamp(); }
+			void updateLast(const T& value) noexcept { ts.updateLast(value); }
+			template <typename Combine>
+			void decimate(Combine&& combine) noexcept {
+				ts.decimate(std::forward<Combine>(combine));
 			}
-			std::tuple<const std::vector<std::chrono::milliseconds>&, const std::vector<T>&>
-			timeseries() const noexcept override {
+			void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+				ts.replace(std::move(timepoints), std::move(values));
+			}
+			const T& maxValue() const noexcept { return ts.maxValue(); }
+			const T& minValue() const noexcept { return ts.minValue(); }
+			const T& avgValue() const noexcept { return ts.avgValue(); }
+			const utils::DDSketch* sketch() const noexcept { return ts.sketch(); }
+			const TimeWeightedMoments* moments() const noexcept { return ts.moments(); }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
 				return ts.timeseries();
 			}
+			size_t size() const noexcept { return ts.size(); }
+			size_t memoryUsage() const noexcept { return ts.memoryUsage(); }
+		};
+
+		/**
+		 * @tparam Running The running aggregate of a batch (with `update` and `reset` like AggFn).
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Running, typename Next>
+		struct BatchedStage final : public ForwardingStage<T, Next> {
+			std::chrono::milliseconds batchintervall;
+			Running aggfn;
+			size_t startBatchingAtSize;
+
+			BatchedStage(
+					std::chrono::milliseconds batchintervall, Running&& aggfn, size_t startBatchingAtSize, Next&& ts
+			)
+					: ForwardingStage<T, Next>(std::move(ts)), batchintervall(batchintervall), aggfn(std::move(aggfn)),
+					  startBatchingAtSize(std::max(size_t(1), startBatchingAtSize)) {}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (this->size() >= startBatchingAtSize &&
+					(timestamp - this->lastTimestamp()) < batchintervall) { // Add to previous batch
+					this->ts.updateLast(aggfn.update(value));
+				} else { // Start New Batch
+					aggfn.reset();
+					this->ts.addValue(aggfn.update(value), timestamp);
+				}
+			}
+		};
 
-			size_t size() const noexcept override { return ts.size(); }
+		/**
+		 * @tparam Combine Merges two neighboring values into one (`T(const T&, const T&)`).
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Combine, typename Next>
+		struct LimitStage final : public ForwardingStage<T, Next> {
+			size_t limit;
+			Combine aggfn;
+
+			LimitStage(size_t limit, Combine aggfn, Next&& ts)
+					: ForwardingStage<T, Next>(std::move(ts)), limit(limit), aggfn(aggfn) {}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (this->size() >= limit) // Aggregate every pair of elements to half the number of points
+					this->ts.decimate(aggfn);
+				this->ts.addValue(value, timestamp);
+			}
 		};
 
+		/**
+		 * @brief The smallest and the largest of a group of consecutive points.
+		 */
 		template <typename T>
-		struct LimitImpl final : public TimeSeriesImpl<T> {
-			using AggFn = T (*)(const T& a, const T& b);
+		struct Envelope final {
+			std::chrono::milliseconds minTime{};
+			std::chrono::milliseconds maxTime{};
+			T min{};
+			T max{};
+			size_t count = 0;
+
+			void add(std::chrono::milliseconds timestamp, const T& value) noexcept {
+				if (count == 0 || value < min) {
+					minTime = timestamp;
+					min = value;
+				}
+				if (count == 0 || value > max) {
+					maxTime = timestamp;
+					max = value;
+				}
+				++count;
+			}
+			/**
+			 * @brief Invokes \p fn with the timestamp and value of the smallest and the largest point in the order of
+			 * time (or only once if all points have the same value).
+			 *
+			 * @return The number of points that \p fn was invoked with.
+			 */
+			template <typename Fn>
+			size_t emit(Fn&& fn) const {
+				if (count == 0)
+					return 0;
+				if (!(min < max)) {
+					fn(minTime, min);
+					return 1;
+				}
+				if (minTime <= maxTime) {
+					fn(minTime, min);
+					fn(maxTime, max);
+				} else {
+					fn(maxTime, max);
+					fn(minTime, min);
+				}
+				return 2;
+			}
+			size_t emit(std::vector<std::chrono::milliseconds>& timepoints, std::vector<T>& values) const {
+				return emit([&](std::chrono::milliseconds timestamp, const T& value) {
+					timepoints.emplace_back(timestamp);
+					values.emplace_back(value);
+				});
+			}
+
+			/** @brief The envelope of the (non-empty) range [\p begin, \p end) of points. */
+			static Envelope of(
+					const std::vector<std::chrono::milliseconds>& timepoints, const std::vector<T>& values, size_t begin,
+					size_t end
+			) {
+				Envelope envelope;
+				if constexpr (utils::simd::Vectorizable<T>) {
+					// Finding the extremes is vectorized, such that only their first occurrences have to be searched
+					auto range = std::span<const T>(values).subspan(begin, end - begin);
+					auto [min, max] = utils::simd::minMax(range);
+					auto minAt = std::find(range.begin(), range.end(), min);
+					auto maxAt = std::find(range.begin(), range.end(), max);
+					if (minAt != range.end() && maxAt != range.end()) { // Unless a NaN was found
+						envelope.minTime = timepoints[begin + static_cast<size_t>(minAt - range.begin())];
+						envelope.maxTime = timepoints[begin + static_cast<size_t>(maxAt - range.begin())];
+						envelope.min = min;
+						envelope.max = max;
+						envelope.count = end - begin;
+						return envelope;
+					}
+				}
+				for (auto i = begin; i < end; ++i)
+					envelope.add(timepoints[i], values[i]);
+				return envelope;
+			}
+		};
+
+		/**
+		 * @brief Bounds the number of points to \p limit while preserving the shape of the time series.
+		 * @details The values are grouped into buckets of consecutive values, of which only the smallest and the
+		 * largest are handed to the next stage (see Envelope). Hence, spikes survive regardless of how many values are
+		 * merged into a bucket. Once the points would exceed the limit, every two neighboring buckets are merged and
+		 * the buckets cover twice as many values from then on. Since this happens whenever the number of values
+		 * doubles, adding a value takes amortized constant time.
+		 *
+		 * The bucket that is currently filled is kept here and only handed on once it is complete. The most recent
+		 * value is kept apart from it such that it can still be updated (e.g., by BatchedStage). Since the next stage
+		 * only sees a subset of the values, this stage keeps its own aggregates.
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct DownsampleStage final : public ForwardingStage<T, Next> {
 			size_t limit;
-			AggFn aggfn;
-			TimeSeries<T> ts;
+			size_t span = 1;	/**< The number of values per bucket. **/
+			Envelope<T> bucket; /**< The bucket that is currently filled (without the most recent value). **/
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false;
+			std::vector<uint8_t> sizes; /**< The number of points of each bucket that was handed on. **/
+			Aggregates<T> aggregates;
 
-			static AggFn enumToAggFn(tirexAggregateFn fn) {
-				switch (fn) {
-				case TIREX_AGG_NO:
-					return nullptr;
-				case TIREX_AGG_MAX:
-					return +[](const T& a, const T& b) { return std::max(a, b); };
-				case TIREX_AGG_MIN:
-					return +[](const T& a, const T& b) { return std::min(a, b); };
-				case TIREX_AGG_MEAN:
-					return +[](const T& a, const T& b) { return (a + b) / 2; };
-				default:
-					tirex::abort(tirexLogLevel::CRITICAL, "enumToAggFn was given an invalid value");
-					return nullptr;
-				};
+			DownsampleStage(size_t limit, Next&& ts)
+					: ForwardingStage<T, Next>(std::move(ts)), limit(std::max(size_t(8), limit)) {}
+
+			/** @brief The bucket that is currently filled including the most recent value. */
+			Envelope<T> current() const noexcept {
+				auto envelope = bucket;
+				if (hasLast)
+					envelope.add(lastTime, lastValue);
+				return envelope;
 			}
 
-			LimitImpl(size_t limit, tirexAggregateFn agg, TimeSeries<T>&& ts)
-					: limit(limit), aggfn(enumToAggFn(agg)), ts(std::move(ts)) {}
+			/** @brief Merges every two neighboring buckets that were handed on into one. */
+			void merge() {
+				auto [timepoints, values] = this->ts.timeseries();
+				std::vector<std::chrono::milliseconds> mergedTimepoints;
+				std::vector<T> mergedValues;
+				std::vector<uint8_t> mergedSizes;
+				for (size_t i = 0, pos = 0; i < sizes.size(); i += 2) {
+					Envelope<T> envelope;
+					for (auto end = pos + sizes[i] + ((i + 1 < sizes.size()) ? sizes[i + 1] : 0); pos < end; ++pos)
+						envelope.add(timepoints[pos], values[pos]);
+					mergedSizes.push_back(static_cast<uint8_t>(envelope.emit(mergedTimepoints, mergedValues)));
+				}
+				this->ts.replace(std::move(mergedTimepoints), std::move(mergedValues));
+				sizes = std::move(mergedSizes);
+				span *= 2;
+			}
 
-			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept override {
-				auto data = timeseries();
-				auto& [timepoints, values] = data;
-				if (size() >= limit) { // Aggregate every pair of elements to half the number of points
-					for (size_t i = 0; i < timepoints.size(); i += 2) {
-						timepoints[i / 2] = timepoints[i + 1];
-						values[i / 2] = aggfn(values[i], values[i + 1]);
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasLast) {
+					bucket.add(lastTime, lastValue);
+					if (bucket.count >= span) {
+						// Each bucket takes up to two points, which includes the one that is currently filled
+						if (sizes.size() + 1 >= limit / 2)
+							merge();
+						sizes.push_back(static_cast<uint8_t>(bucket.emit([this](auto time, const T& val) {
+							this->ts.addValue(val, time);
+						})));
+						bucket = {};
 					}
-					/** \fixme does not yet work for uneven limit */
-					timepoints.resize(timepoints.size() / 2);
-					values.resize(timepoints.size());
 				}
-				ts.addValue(value, timestamp);
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+				aggregates.add(value);
 			}
-			std::chrono::milliseconds currentTimestamp() const noexcept override { return ts.currentTimestamp(); }
-			const T& maxValue() const noexcept override { return ts.maxValue(); }
-			const T& minValue() const noexcept override { return ts.minValue(); }
-			const T& avgValue() const noexcept override { return ts.avgValue(); }
-			std::tuple<std::vector<std::chrono::milliseconds>&, std::vector<T>&> timeseries() noexcept override {
-				return ts.timeseries();
+			std::chrono::milliseconds lastTimestamp() const noexcept {
+				return hasLast ? lastTime : this->ts.lastTimestamp();
 			}
-			std::tuple<const std::vector<std::chrono::milliseconds>&, const std::vector<T>&>
-			timeseries() const noexcept override {
-				return ts.timeseries();
+			void updateLast(const T& value) noexcept {
+				if (hasLast)
+					lastValue = value;
+				else
+					this->ts.updateLast(value);
+			}
+			/**
+			 * @brief Merges neighboring buckets like the downsampling does instead of combining the values. The limit
+			 * is halved as well, such that the series does not grow back (e.g., when memory runs short).
+			 */
+			template <typename Combine>
+			void decimate(Combine&&) noexcept {
+				merge();
+				limit = std::max(size_t(8), limit / 2);
+			}
+			void replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept {
+				sizes.assign(timepoints.size(), 1);
+				bucket = {};
+				hasLast = false;
+				this->ts.replace(std::move(timepoints), std::move(values));
+			}
+
+			const T& maxValue() const noexcept { return aggregates.max; }
+			const T& minValue() const noexcept { return aggregates.min; }
+			const T& avgValue() const noexcept { return aggregates.avg; }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const {
+				auto series = this->ts.timeseries();
+				current().emit(std::get<0>(series), std::get<1>(series));
+				return series;
+			}
+			size_t size() const noexcept {
+				auto open = current();
+				return this->ts.size() + ((open.count == 0) ? 0 : (open.min < open.max) ? 2 : 1);
+			}
+			size_t memoryUsage() const noexcept { return sizes.capacity() + this->ts.memoryUsage(); }
+		};
+
+		/**
+		 * @brief Adds every value to a quantile sketch (see utils::DDSketch) before handing it to the next stage.
+		 * @details To cover all values, this should be the last stage that is appended (i.e., the first to receive
+		 * the values), since stages like DownsampleStage hand on only some of them.
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct QuantileStage final : public ForwardingStage<T, Next> {
+			utils::DDSketch quantiles;
+
+			QuantileStage(double relativeAccuracy, Next&& ts)
+					: ForwardingStage<T, Next>(std::move(ts)), quantiles(relativeAccuracy) {}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				quantiles.add(static_cast<double>(value));
+				this->ts.addValue(value, timestamp);
+			}
+			const utils::DDSketch* sketch() const noexcept { return &quantiles; }
+			size_t memoryUsage() const noexcept { return quantiles.memoryUsage() + this->ts.memoryUsage(); }
+		};
+
+		/**
+		 * @brief Turns a cumulative counter (e.g., the bytes read so far) into its rate of change per \p per (e.g.,
+		 * bytes per second), which is handed to the next stage.
+		 * @details The rate of a value is computed over the time since the previous value, such that irregular
+		 * sampling does not skew it. Hence, the first value does not produce a point. If the counter decreases, it is
+		 * assumed to have been reset and to have counted up from zero since. Values with the timestamp of the most
+		 * recent one update it (like TimeSeries::updateLast).
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct RateStage final : public ForwardingStage<T, Next> {
+			std::chrono::milliseconds per;
+			std::chrono::milliseconds prevTime{};
+			T prevValue{};
+			bool hasPrev = false;
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false;
+
+			RateStage(std::chrono::milliseconds per, Next&& ts) : ForwardingStage<T, Next>(std::move(ts)), per(per) {}
+
+			T rate() const noexcept {
+				auto increase = (lastValue < prevValue) ? lastValue : lastValue - prevValue;
+				auto elapsed = static_cast<double>((lastTime - prevTime).count());
+				return static_cast<T>(static_cast<double>(increase) * static_cast<double>(per.count()) / elapsed);
+			}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasLast && timestamp <= lastTime)
+					return updateLast(value);
+				if (hasLast) {
+					prevTime = lastTime;
+					prevValue = lastValue;
+					hasPrev = true;
+				}
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+				if (hasPrev)
+					this->ts.addValue(rate(), timestamp);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept {
+				return hasLast ? lastTime : this->ts.lastTimestamp();
+			}
+			void updateLast(const T& value) noexcept {
+				lastValue = value;
+				if (hasPrev)
+					this->ts.updateLast(rate());
+			}
+		};
+
+		/**
+		 * @brief Integrates the values over time (e.g., a power in watts into the energy in joules) and hands the
+		 * integral up to each value to the next stage.
+		 * @details The integral between two values is approximated by the trapezoidal rule and divided by \p per, the
+		 * unit of time the values refer to (e.g., 1s for watts). The first value produces a point of zero. Values
+		 * with the timestamp of the most recent one update it (like TimeSeries::updateLast).
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct IntegrateStage final : public ForwardingStage<T, Next> {
+			std::chrono::milliseconds per;
+			double integral = 0; /**< The integral up to prevTime. **/
+			std::chrono::milliseconds prevTime{};
+			T prevValue{};
+			bool hasPrev = false;
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false;
+
+			IntegrateStage(std::chrono::milliseconds per, Next&& ts)
+					: ForwardingStage<T, Next>(std::move(ts)), per(per) {}
+
+			/** @brief The integral from prevTime to lastTime. */
+			double segment() const noexcept {
+				if (!hasPrev)
+					return 0.0;
+				auto elapsed = static_cast<double>((lastTime - prevTime).count()) / static_cast<double>(per.count());
+				return (static_cast<double>(prevValue) + static_cast<double>(lastValue)) / 2 * elapsed;
+			}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasLast && timestamp <= lastTime)
+					return updateLast(value);
+				if (hasLast) {
+					integral += segment();
+					prevTime = lastTime;
+					prevValue = lastValue;
+					hasPrev = true;
+				}
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+				this->ts.addValue(static_cast<T>(integral + segment()), timestamp);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept {
+				return hasLast ? lastTime : this->ts.lastTimestamp();
+			}
+			void updateLast(const T& value) noexcept {
+				lastValue = value;
+				this->ts.updateLast(static_cast<T>(integral + segment()));
+			}
+		};
+
+		/**
+		 * @brief Smooths the values by an exponentially weighted moving average before handing them to the next stage.
+		 * @details The weight of the previous average decays with the time that passed since the previous value, such
+		 * that it halves every \p halfLife. Unlike a weight per value, this smooths the same regardless of how often
+		 * values arrive. Values with the timestamp of the most recent one update it (like TimeSeries::updateLast).
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct EwmaStage final : public ForwardingStage<T, Next> {
+			std::chrono::milliseconds halfLife;
+			double prevAverage = 0; /**< The average up to prevTime. **/
+			std::chrono::milliseconds prevTime{};
+			bool hasPrev = false;
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false;
+
+			EwmaStage(std::chrono::milliseconds halfLife, Next&& ts)
+					: ForwardingStage<T, Next>(std::move(ts)),
+					  halfLife(std::max(std::chrono::milliseconds(1), halfLife)) {}
+
+			/** @brief The average up to lastTime. */
+			double average() const noexcept {
+				if (!hasPrev)
+					return static_cast<double>(lastValue);
+				auto halfLives =
+						static_cast<double>((lastTime - prevTime).count()) / static_cast<double>(halfLife.count());
+				return prevAverage + (static_cast<double>(lastValue) - prevAverage) * (1 - std::exp2(-halfLives));
+			}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasLast && timestamp <= lastTime)
+					return updateLast(value);
+				if (hasLast) {
+					prevAverage = average();
+					prevTime = lastTime;
+					hasPrev = true;
+				}
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+				this->ts.addValue(static_cast<T>(average()), timestamp);
+			}
+			std::chrono::milliseconds lastTimestamp() const noexcept {
+				return hasLast ? lastTime : this->ts.lastTimestamp();
+			}
+			void updateLast(const T& value) noexcept {
+				lastValue = value;
+				this->ts.updateLast(static_cast<T>(average()));
+			}
+		};
+
+		/**
+		 * @brief Keeps the time-weighted mean and variance of the values (see ts::TimeWeightedMoments) and reports the
+		 * former as the average (see TimeSeries::avgValue) instead of the mean by the number of values.
+		 * @details Each value holds until the next one arrives, such that the most recent value only counts once its
+		 * successor arrived. Until then (i.e., for a single value) the next stage's average is reported. The values
+		 * are handed on unchanged.
+		 *
+		 * @tparam Next The next stage.
+		 */
+		template <typename T, typename Next>
+		struct TimeWeightedStage final : public ForwardingStage<T, Next> {
+			TimeWeightedMoments weighted;
+			T average{};
+			std::chrono::milliseconds lastTime{};
+			T lastValue{};
+			bool hasLast = false;
+
+			explicit TimeWeightedStage(Next&& ts) : ForwardingStage<T, Next>(std::move(ts)) {}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept {
+				if (hasLast) {
+					weighted.add(static_cast<double>(lastValue), static_cast<double>((timestamp - lastTime).count()));
+					average = static_cast<T>(weighted.mean);
+				}
+				lastTime = timestamp;
+				lastValue = value;
+				hasLast = true;
+				this->ts.addValue(value, timestamp);
 			}
+			void updateLast(const T& value) noexcept {
+				lastValue = value;
+				this->ts.updateLast(value);
+			}
+			const T& avgValue() const noexcept { return (weighted.duration > 0) ? average : this->ts.avgValue(); }
+			const TimeWeightedMoments* moments() const noexcept { return &weighted; }
+		};
+
+		/**
+		 * @brief Type-erases a pipeline of stages such that it can be stored as a TimeSeries.
+		 * @details Stages have the same (non-virtual) interface as TimeSeries and hand their values to the next stage,
+		 * which is either another stage (see ts::flat) or a type-erased TimeSeries (see ts::store). A pipeline that is
+		 * built from stages alone is only type-erased here, such that it costs a single virtual call per operation and
+		 * its aggregations can be inlined.
+		 */
+		template <typename Stage>
+		struct ErasedImpl final : public TimeSeriesImpl<typename Stage::value_type> {
+			using T = typename Stage::value_type;
+
+			Stage stage;
 
-			size_t size() const noexcept override { return ts.size(); }
+			template <typename... Args>
+			explicit ErasedImpl(Args&&... args) : stage(std::forward<Args>(args)...) {}
+
+			void addValue(const T& value, const std::chrono::milliseconds& timestamp) noexcept override {
+				stage.addValue(value, timestamp);
+			}
+			std::chrono::milliseconds currentTimestamp() const noexcept override { return stage.currentTimestamp(); }
+			std::chrono::milliseconds lastTimestamp() const noexcept override { return stage.lastTimestamp(); }
+			void updateLast(const T& value) noexcept override { stage.updateLast(value); }
+			void decimate(T (*combine)(const T&, const T&)) noexcept override { stage.decimate(combine); }
+			void
+			replace(std::vector<std::chrono::milliseconds>&& timepoints, std::vector<T>&& values) noexcept override {
+				stage.replace(std::move(timepoints), std::move(values));
+			}
+			const T& maxValue() const noexcept override { return stage.maxValue(); }
+			const T& minValue() const noexcept override { return stage.minValue(); }
+			const T& avgValue() const noexcept override { return stage.avgValue(); }
+			const utils::DDSketch* sketch() const noexcept override { return stage.sketch(); }
+			const TimeWeightedMoments* moments() const noexcept override { return stage.moments(); }
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> timeseries() const override {
+				return stage.timeseries();
+			}
+
+			size_t size() const noexcept override { return stage.size(); }
+			size_t memoryUsage() const noexcept override { return sizeof(*this) + stage.memoryUsage(); }
 		};
+
+		template <typename T>
+		using StoreImpl = ErasedImpl<StoreStage<T>>;
+		template <typename T>
+		using CompressedImpl = ErasedImpl<CompressedStage<T>>;
+		template <typename T>
+		using RollupImpl = ErasedImpl<RollupStage<T>>;
+		template <typename T>
+		using BatchedImpl = ErasedImpl<BatchedStage<T, DynamicAggFn<T>, TimeSeries<T>>>;
+		template <typename T>
+		using LimitImpl = ErasedImpl<LimitStage<T, T (*)(const T&, const T&), TimeSeries<T>>>;
+		template <typename T>
+		using DownsampleImpl = ErasedImpl<DownsampleStage<T, TimeSeries<T>>>;
+		template <typename T>
+		using QuantileImpl = ErasedImpl<QuantileStage<T, TimeSeries<T>>>;
+		template <typename T>
+		using RateImpl = ErasedImpl<RateStage<T, TimeSeries<T>>>;
+		template <typename T>
+		using IntegrateImpl = ErasedImpl<IntegrateStage<T, TimeSeries<T>>>;
+		template <typename T>
+		using EwmaImpl = ErasedImpl<EwmaStage<T, TimeSeries<T>>>;
+		template <typename T>
+		using TimeWeightedImpl = ErasedImpl<TimeWeightedStage<T, TimeSeries<T>>>;
+
+		/** @brief A stage of a pipeline that is composed at compile time (see ts::flat). */
+		template <typename S>
+		concept Stage = requires { typename S::value_type; };
 	} // namespace ts::details
 
+	/**
+	 * @brief Aggregation policies for pipelines that are composed at compile time (see ts::LimitBy and ts::BatchedBy).
+	 * @details Each policy provides the running aggregate of a batch (`Running<T>`) and how two neighboring values are
+	 * merged when a time series is thinned out (`Combine<T>`). A Combine may name the equivalent vectorized operation
+	 * (`pairwise`), which is then used to merge all values at once.
+	 */
+	namespace ts::agg {
+		struct Max final {
+			template <typename T>
+			using Running = details::MaxAggFn<T>;
+			template <typename T>
+			struct Combine final {
+				static constexpr auto pairwise = utils::simd::Pairwise::Max;
+				T operator()(const T& a, const T& b) const noexcept { return std::max(a, b); }
+			};
+		};
+		struct Min final {
+			template <typename T>
+			using Running = details::MinAggFn<T>;
+			template <typename T>
+			struct Combine final {
+				static constexpr auto pairwise = utils::simd::Pairwise::Min;
+				T operator()(const T& a, const T& b) const noexcept { return std::min(a, b); }
+			};
+		};
+		struct Mean final {
+			template <typename T>
+			using Running = details::AvgAggFn<T>;
+			template <typename T>
+			struct Combine final {
+				static constexpr auto pairwise = utils::simd::Pairwise::Mean;
+				T operator()(const T& a, const T& b) const noexcept { return (a + b) / 2; }
+			};
+		};
+		/** @brief Keeps the most recent value, i.e., thins out the time series without aggregating. */
+		struct Last final {
+			template <typename T>
+			using Running = details::LastAggFn<T>;
+			template <typename T>
+			struct Combine final {
+				T operator()(const T&, const T& b) const noexcept { return b; }
+			};
+		};
+
+		/**
+		 * @brief Invokes \p fn with the policy that corresponds to \p agg as its template argument (e.g.,
+		 * `fn.template operator()<Max>()` for TIREX_AGG_MAX) and returns its result.
+		 * @details This selects the compile-time pipeline for an aggregation that is only known at runtime.
+		 * TIREX_AGG_NO maps to Last.
+		 */
+		template <typename Fn>
+		decltype(auto) visit(tirexAggregateFn agg, Fn&& fn) {
+			switch (agg) {
+			case TIREX_AGG_MAX:
+				return fn.template operator()<Max>();
+			case TIREX_AGG_MIN:
+				return fn.template operator()<Min>();
+			case TIREX_AGG_MEAN:
+				return fn.template operator()<Mean>();
+			case TIREX_AGG_NO:
+				return fn.template operator()<Last>();
+			default:
+				tirex::abort(tirexLogLevel::CRITICAL, "ts::agg::visit was given an invalid value");
+				return fn.template operator()<Last>();
+			}
+		}
+	} // namespace ts::agg
+
 	namespace ts {
 
 		struct Batched final {
@@ -337,13 +1352,31 @@ namespace tirex {
 			tirexAggregateFn agg;
 			size_t startBatchingAtSize;
 
+			template <typename T>
+			[[nodiscard]] static inline std::unique_ptr<details::AggFn<T>> enumToAggFn(tirexAggregateFn fn) {
+				switch (fn) {
+				case TIREX_AGG_NO:
+					return nullptr;
+				case TIREX_AGG_MAX:
+					return std::make_unique<details::MaxAggFn<T>>();
+				case TIREX_AGG_MIN:
+					return std::make_unique<details::MinAggFn<T>>();
+				case TIREX_AGG_MEAN:
+					return std::make_unique<details::AvgAggFn<T>>();
+				default:
+					tirex::abort(tirexLogLevel::CRITICAL, "enumToAggFn was given an invalid value");
+					return nullptr;
+				};
+			}
+
 		public:
 			Batched(std::chrono::milliseconds batchintervall, tirexAggregateFn agg, size_t startBatchingAtSize = 0)
 					: batchintervall(batchintervall), agg(agg), startBatchingAtSize(startBatchingAtSize) {}
 			template <typename T>
 			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Batched& self) {
 				return TimeSeries<T>(std::make_unique<details::BatchedImpl<T>>(
-						self.batchintervall, self.agg, self.startBatchingAtSize, std::move(ts)
+						self.batchintervall, details::DynamicAggFn<T>{enumToAggFn<T>(self.agg)},
+						self.startBatchingAtSize, std::move(ts)
 				));
 			}
 		};
@@ -353,20 +1386,290 @@ namespace tirex {
 			size_t limit;
 			tirexAggregateFn agg;
 
+			template <typename T>
+			static T (*enumToAggFn(tirexAggregateFn fn))(const T&, const T&) {
+				switch (fn) {
+				case TIREX_AGG_NO:
+					return nullptr;
+				case TIREX_AGG_MAX:
+					return +[](const T& a, const T& b) { return std::max(a, b); };
+				case TIREX_AGG_MIN:
+					return +[](const T& a, const T& b) { return std::min(a, b); };
+				case TIREX_AGG_MEAN:
+					return +[](const T& a, const T& b) { return (a + b) / 2; };
+				default:
+					tirex::abort(tirexLogLevel::CRITICAL, "enumToAggFn was given an invalid value");
+					return nullptr;
+				};
+			}
+
 		public:
 			Limit(size_t limit, tirexAggregateFn agg) : limit(limit), agg(agg) {}
 			template <typename T>
 			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Limit& self) {
-				return TimeSeries<T>(std::make_unique<details::LimitImpl<T>>(self.limit, self.agg, std::move(ts)));
+				return TimeSeries<T>(
+						std::make_unique<details::LimitImpl<T>>(self.limit, enumToAggFn<T>(self.agg), std::move(ts))
+				);
+			}
+		};
+
+		/**
+		 * @brief Bounds the number of points like ts::Limit but keeps the smallest and the largest value of every
+		 * merged group of values instead of aggregating them, such that spikes remain visible (see
+		 * ts::details::DownsampleStage). It can be appended to pipelines that are composed at runtime and at compile
+		 * time (see ts::flat).
+		 */
+		struct Downsample final {
+			size_t limit;
+
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Downsample& self) {
+				return TimeSeries<T>(std::make_unique<details::DownsampleImpl<T>>(self.limit, std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const Downsample& self) {
+				return details::DownsampleStage<typename S::value_type, S>(self.limit, std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Keeps a quantile sketch over all values that are added to the time series (see TimeSeries::sketch),
+		 * whose quantiles are within \p relativeAccuracy of the true ones and take bounded memory. It can be appended
+		 * to pipelines that are composed at runtime and at compile time (see ts::flat).
+		 */
+		struct Quantiles final {
+			double relativeAccuracy = 0.01;
+
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Quantiles& self) {
+				return TimeSeries<T>(std::make_unique<details::QuantileImpl<T>>(self.relativeAccuracy, std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const Quantiles& self) {
+				return details::QuantileStage<typename S::value_type, S>(self.relativeAccuracy, std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Turns a cumulative counter into its rate of change per \p per (see ts::details::RateStage), e.g.,
+		 * bytes read into bytes read per second. It can be appended to pipelines that are composed at runtime and at
+		 * compile time (see ts::flat).
+		 */
+		struct Rate final {
+			std::chrono::milliseconds per = std::chrono::seconds(1);
+
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Rate& self) {
+				return TimeSeries<T>(std::make_unique<details::RateImpl<T>>(self.per, std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const Rate& self) {
+				return details::RateStage<typename S::value_type, S>(self.per, std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Integrates the values over time, where they refer to the unit of time \p per (see
+		 * ts::details::IntegrateStage), e.g., a power in watts into the energy in joules. It can be appended to
+		 * pipelines that are composed at runtime and at compile time (see ts::flat).
+		 */
+		struct Integrate final {
+			std::chrono::milliseconds per = std::chrono::seconds(1);
+
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Integrate& self) {
+				return TimeSeries<T>(std::make_unique<details::IntegrateImpl<T>>(self.per, std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const Integrate& self) {
+				return details::IntegrateStage<typename S::value_type, S>(self.per, std::move(stage));
 			}
 		};
 
+		/**
+		 * @brief Smooths the values by an exponentially weighted moving average whose weights halve every
+		 * \p halfLife (see ts::details::EwmaStage). It can be appended to pipelines that are composed at runtime and at
+		 * compile time (see ts::flat).
+		 */
+		struct Ewma final {
+			std::chrono::milliseconds halfLife;
+
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const Ewma& self) {
+				return TimeSeries<T>(std::make_unique<details::EwmaImpl<T>>(self.halfLife, std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const Ewma& self) {
+				return details::EwmaStage<typename S::value_type, S>(self.halfLife, std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Weights the values by how long they held, such that TimeSeries::avgValue is the time-weighted mean
+		 * and TimeSeries::moments provides the time-weighted variance (see ts::details::TimeWeightedStage). To cover
+		 * all values, it should be appended last. It can be appended to pipelines that are composed at runtime and at
+		 * compile time (see ts::flat).
+		 */
+		struct TimeWeighted final {
+			template <typename T>
+			friend TimeSeries<T> operator|(TimeSeries<T>&& ts, const TimeWeighted&) {
+				return TimeSeries<T>(std::make_unique<details::TimeWeightedImpl<T>>(std::move(ts)));
+			}
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const TimeWeighted&) {
+				return details::TimeWeightedStage<typename S::value_type, S>(std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Reduces the points of a time series to at most \p maxPoints (e.g., before exporting it) by keeping
+		 * the smallest and the largest value of equally sized groups of consecutive points.
+		 *
+		 * @param series The timepoints and values as returned by TimeSeries::timeseries.
+		 * @param maxPoints The maximum number of points to keep (at least 2).
+		 * @return The downsampled timepoints and values.
+		 */
+		template <typename T>
+		std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>>
+		downsample(std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>>&& series, size_t maxPoints) {
+			const auto& [timepoints, values] = series;
+			if (timepoints.size() <= maxPoints)
+				return std::move(series);
+			auto perGroup = (timepoints.size() + maxPoints / 2 - 1) / (maxPoints / 2);
+			std::tuple<std::vector<std::chrono::milliseconds>, std::vector<T>> result;
+			for (size_t begin = 0; begin < timepoints.size(); begin += perGroup) {
+				auto end = std::min(begin + perGroup, timepoints.size());
+				details::Envelope<T>::of(timepoints, values, begin, end).emit(std::get<0>(result), std::get<1>(result));
+			}
+			return result;
+		}
+
 		template <typename T>
 		static inline TimeSeries<T> store() {
 			return TimeSeries<T>(std::make_unique<details::StoreImpl<T>>());
 		}
+		/**
+		 * @brief Like store() but the timestamps are relative to \p starttime (e.g., the start of the measurement)
+		 * instead of the time series' construction.
+		 */
+		template <typename T>
+		static inline TimeSeries<T> store(std::chrono::steady_clock::time_point starttime) {
+			return TimeSeries<T>(std::make_unique<details::StoreImpl<T>>(starttime));
+		}
+
+		/**
+		 * @brief Like store() but keeps the points compressed (see ts::details::CompressedStage), which takes a
+		 * fraction of the memory but has to decode the points to read them.
+		 */
+		template <typename T>
+		static inline TimeSeries<T> compressed() {
+			return TimeSeries<T>(std::make_unique<details::CompressedImpl<T>>());
+		}
+		/**
+		 * @brief Like compressed() but the timestamps are relative to \p starttime.
+		 */
+		template <typename T>
+		static inline TimeSeries<T> compressed(std::chrono::steady_clock::time_point starttime) {
+			return TimeSeries<T>(std::make_unique<details::CompressedImpl<T>>(starttime));
+		}
+
+		/**
+		 * @brief Like store() but keeps the time series in rings of decreasing resolution (see
+		 * ts::details::RollupStage), which take constant memory however long the measurement runs.
+		 *
+		 * @param starttime The timestamps are relative to this.
+		 * @param resolutions The rings from the finest to the coarsest resolution.
+		 * @param agg Selects the value that represents a slot: its maximum (TIREX_AGG_MAX), minimum (TIREX_AGG_MIN), or
+		 * mean (otherwise).
+		 */
+		template <typename T>
+		static inline TimeSeries<T> rollup(
+				std::chrono::steady_clock::time_point starttime,
+				const std::vector<Resolution>& resolutions = defaultResolutions, tirexAggregateFn agg = TIREX_AGG_MEAN
+		) {
+			return TimeSeries<T>(std::make_unique<details::RollupImpl<T>>(starttime, resolutions, agg));
+		}
+		template <typename T>
+		static inline TimeSeries<T> rollup() {
+			return rollup<T>(std::chrono::steady_clock::now());
+		}
+
+		/**
+		 * @brief Like ts::Batched but for pipelines that are composed at compile time (see ts::flat).
+		 *
+		 * @tparam Agg The aggregation policy (e.g., ts::agg::Max).
+		 */
+		template <typename Agg>
+		struct BatchedBy final {
+			std::chrono::milliseconds batchintervall;
+			size_t startBatchingAtSize = 0;
+
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const BatchedBy& self) {
+				using T = typename S::value_type;
+				using Running = typename Agg::template Running<T>;
+				return details::BatchedStage<T, Running, S>(
+						self.batchintervall, Running{}, self.startBatchingAtSize, std::move(stage)
+				);
+			}
+		};
+
+		/**
+		 * @brief Like ts::Limit but for pipelines that are composed at compile time (see ts::flat).
+		 *
+		 * @tparam Agg The aggregation policy (e.g., ts::agg::Max).
+		 */
+		template <typename Agg>
+		struct LimitBy final {
+			size_t limit;
+
+			template <details::Stage S>
+			friend auto operator|(S&& stage, const LimitBy& self) {
+				using T = typename S::value_type;
+				using Combine = typename Agg::template Combine<T>;
+				return details::LimitStage<T, Combine, S>(self.limit, Combine{}, std::move(stage));
+			}
+		};
+
+		/**
+		 * @brief Starts a pipeline that is composed at compile time.
+		 * @details Unlike ts::store, stages are appended as concrete types (e.g.,
+		 * `ts::flat<unsigned>(start) | ts::LimitBy<ts::agg::Max>{300} | ts::BatchedBy<ts::agg::Max>{100ms, 300}`), such
+		 * that adding a value does not go through a virtual call per stage and the aggregations are inlined. Use
+		 * ts::erase to store the finished pipeline as a TimeSeries.
+		 */
+		template <typename T>
+		static inline details::StoreStage<T> flat(std::chrono::steady_clock::time_point starttime) {
+			return details::StoreStage<T>(starttime);
+		}
+		/**
+		 * @brief Like ts::flat but the points are kept in rings of decreasing resolution (see ts::rollup).
+		 */
+		template <typename T>
+		static inline details::RollupStage<T> flatRollup(
+				std::chrono::steady_clock::time_point starttime,
+				const std::vector<Resolution>& resolutions = defaultResolutions, tirexAggregateFn agg = TIREX_AGG_MEAN
+		) {
+			return details::RollupStage<T>(starttime, resolutions, agg);
+		}
+		/**
+		 * @brief Like ts::flat but the points are stored compressed (see ts::compressed).
+		 */
+		template <typename T>
+		static inline details::CompressedStage<T> flatCompressed(std::chrono::steady_clock::time_point starttime) {
+			return details::CompressedStage<T>(starttime);
+		}
+
+		/**
+		 * @brief Wraps a pipeline that was composed at compile time into a TimeSeries, which costs a single virtual
+		 * call per operation.
+		 */
+		template <details::Stage S>
+		static inline TimeSeries<typename S::value_type> erase(S&& pipeline) {
+			return TimeSeries<typename S::value_type>(std::make_unique<details::ErasedImpl<S>>(std::move(pipeline)));
+		}
 	} // namespace ts
 
 }; // namespace tirex
 
-#endif
\ No newline at end of file
+#endif
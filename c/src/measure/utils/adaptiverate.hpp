@@ -0,0 +1,175 @@
+#ifndef MEASURE_UTILS_ADAPTIVERATE_HPP
+#define MEASURE_UTILS_ADAPTIVERATE_HPP
+
+#include <tirex_tracker.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace tirex::utils {
+	/**
+	 * @brief Decides at which interval a provider should be polled based on the samples it recorded recently.
+	 * @details While the samples are stable (i.e., no measure changed by more than the configured tolerance since the
+	 * previous step), the interval is doubled after every step up to the configured maximum. Once a sample changes, the
+	 * interval falls back to the base interval (the one requested by the measurements). If a trigger fires, the
+	 * provider is polled at the configured minimum interval until the trigger's hold time passed without it firing
+	 * again. The interval always stays within the configured bounds.
+	 *
+	 * AdaptiveRate::observe is called by the thread that polls the provider while AdaptiveRate::interval may be read
+	 * concurrently by the thread that schedules it.
+	 */
+	class AdaptiveRate final {
+	public:
+		using clock = std::chrono::steady_clock;
+
+		struct Trigger final {
+			tirexMeasure measure;
+			tirexTriggerCondition condition;
+			double threshold;
+			std::chrono::microseconds hold; /**< For how long the burst rate is kept after the trigger fired. **/
+
+			bool operator==(const Trigger&) const = default;
+		};
+
+		struct Config final {
+			std::chrono::microseconds minInterval;
+			std::chrono::microseconds maxInterval;
+			double tolerance; /**< The relative change up to which two consecutive samples are considered equal. **/
+			std::vector<Trigger> triggers;
+
+			bool operator==(const Config&) const = default;
+		};
+
+	private:
+		std::mutex mutex;
+		bool configured = false;
+		Config config{};
+		std::chrono::microseconds base{0};
+		std::map<tirexMeasure, double> previous;
+		clock::time_point previousTime;
+		clock::time_point burstUntil;
+		std::atomic<bool> active = false;
+		std::atomic<std::chrono::microseconds::rep> current{0};
+
+		std::chrono::microseconds clamp(std::chrono::microseconds interval) const noexcept {
+			return std::clamp(interval, config.minInterval, config.maxInterval);
+		}
+
+		bool fires(const Trigger& trigger, double value, clock::time_point now) const noexcept {
+			switch (trigger.condition) {
+			case TIREX_TRIGGER_ABOVE:
+				return value > trigger.threshold;
+			case TIREX_TRIGGER_BELOW:
+				return value < trigger.threshold;
+			case TIREX_TRIGGER_RISE: {
+				auto it = previous.find(trigger.measure);
+				auto seconds = std::chrono::duration<double>(now - previousTime).count();
+				if (it == previous.end() || seconds <= 0)
+					return false;
+				return (value - it->second) / seconds > trigger.threshold;
+			}
+			}
+			return false;
+		}
+
+	public:
+		/**
+		 * @brief Enables (or reconfigures) the adaptive rate.
+		 */
+		void configure(Config conf) {
+			std::lock_guard lock(mutex);
+			config = std::move(conf);
+			configured = true;
+			current = clamp(base).count();
+			active = base.count() > 0;
+		}
+
+		/**
+		 * @brief Stops adapting the interval, i.e., AdaptiveRate::enabled returns false until it is configured again.
+		 */
+		void disable() {
+			std::lock_guard lock(mutex);
+			configured = false;
+			active = false;
+			current = base.count();
+		}
+
+		/**
+		 * @brief Combines the configurations of several measurements that share a provider such that the bounds of
+		 * each of them hold: the shortest of the minimum and of the maximum intervals, the smallest tolerance, and all
+		 * triggers. \p configs must not be empty.
+		 */
+		static Config merge(const std::vector<Config>& configs) {
+			auto merged = configs.front();
+			for (const auto& config : configs) {
+				merged.minInterval = std::min(merged.minInterval, config.minInterval);
+				merged.maxInterval = std::min(merged.maxInterval, config.maxInterval);
+				merged.tolerance = std::min(merged.tolerance, config.tolerance);
+				for (const auto& trigger : config.triggers) {
+					if (std::find(merged.triggers.begin(), merged.triggers.end(), trigger) == merged.triggers.end())
+						merged.triggers.push_back(trigger);
+				}
+			}
+			return merged;
+		}
+
+		/**
+		 * @brief Sets the interval that is used while the samples change (e.g., once the provider was rescheduled).
+		 * @details A base interval of zero (the provider is not polled) deactivates the adaptive rate.
+		 */
+		void setBase(std::chrono::microseconds interval) {
+			std::lock_guard lock(mutex);
+			base = interval;
+			previous.clear();
+			if (configured)
+				current = clamp(base).count();
+			active = configured && base.count() > 0;
+		}
+
+		/** @brief Whether the interval is adapted, i.e., whether AdaptiveRate::interval should be followed. */
+		bool enabled() const noexcept { return active.load(std::memory_order_relaxed); }
+
+		/** @brief The interval at which the provider should be polled next. */
+		std::chrono::microseconds interval() const noexcept {
+			return std::chrono::microseconds{current.load(std::memory_order_relaxed)};
+		}
+
+		/**
+		 * @brief Updates the interval based on the latest value of each measure that the provider recorded.
+		 */
+		void observe(const std::map<tirexMeasure, double>& samples, clock::time_point now = clock::now()) {
+			std::lock_guard lock(mutex);
+			if (!active)
+				return;
+			for (const auto& trigger : config.triggers) {
+				if (auto it = samples.find(trigger.measure); it != samples.end() && fires(trigger, it->second, now))
+					burstUntil = std::max(burstUntil, now + trigger.hold);
+			}
+			auto stable = !previous.empty() && std::all_of(samples.begin(), samples.end(), [this](const auto& sample) {
+				auto it = previous.find(sample.first);
+				if (it == previous.end())
+					return false;
+				auto before = it->second, after = sample.second;
+				return std::abs(after - before) <= config.tolerance * std::max(std::abs(before), 1.0);
+			});
+			std::chrono::microseconds next;
+			if (now <= burstUntil)
+				next = config.minInterval;
+			else if (stable)
+				next = clamp(std::max(interval(), clamp(base)) * 2);
+			else
+				next = clamp(base);
+			current = next.count();
+			for (const auto& [measure, value] : samples)
+				previous.insert_or_assign(measure, value);
+			previousTime = now;
+		}
+	};
+} // namespace tirex::utils
+
+#endif
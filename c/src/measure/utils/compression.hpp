@@ -0,0 +1,231 @@
+#ifndef MEASURE_UTILS_COMPRESSION_HPP
+#define MEASURE_UTILS_COMPRESSION_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace tirex::utils {
+	/**
+	 * @brief An append-only sequence of bits, which are written most significant bit first.
+	 */
+	class BitStream final {
+	private:
+		std::vector<uint64_t> words;
+		size_t numBits = 0;
+
+	public:
+		/**
+		 * @brief Reads the bits of a BitStream from the beginning. The stream must not be modified while it is read.
+		 */
+		class Reader final {
+		private:
+			const std::vector<uint64_t>& words;
+			size_t pos = 0;
+
+		public:
+			explicit Reader(const BitStream& stream) noexcept : words(stream.words) {}
+
+			/** @brief Reads the next \p n (at most 64) bits. */
+			uint64_t read(unsigned n) noexcept {
+				if (n == 0)
+					return 0;
+				auto offset = pos % 64;
+				auto free = 64 - offset;
+				const auto* word = &words[pos / 64];
+				uint64_t value;
+				if (n <= free)
+					value = word[0] >> (free - n);
+				else
+					value = (word[0] << (n - free)) | (word[1] >> (64 - (n - free)));
+				pos += n;
+				return (n < 64) ? value & ((uint64_t{1} << n) - 1) : value;
+			}
+			bool readBit() noexcept { return read(1) != 0; }
+		};
+
+		/** @brief Appends the lowest \p n (at most 64) bits of \p value. */
+		void write(uint64_t value, unsigned n) {
+			if (n == 0)
+				return;
+			if (n < 64)
+				value &= (uint64_t{1} << n) - 1;
+			auto offset = numBits % 64;
+			if (offset == 0)
+				words.push_back(0);
+			auto free = 64 - offset;
+			if (n <= free) {
+				words.back() |= value << (free - n);
+			} else {
+				words.back() |= value >> (n - free);
+				words.push_back(value << (64 - (n - free)));
+			}
+			numBits += n;
+		}
+		void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+
+		void clear() noexcept {
+			words.clear();
+			numBits = 0;
+		}
+		size_t size() const noexcept { return numBits; }
+		/** @brief The number of bytes that the stream allocated. */
+		size_t capacity() const noexcept { return words.capacity() * sizeof(uint64_t); }
+	};
+
+	constexpr uint64_t zigzag(int64_t value) noexcept {
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+	constexpr int64_t unzigzag(uint64_t value) noexcept {
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	/**
+	 * @brief Encodes a sequence of timestamps by the difference between consecutive deltas (as in Gorilla [1]).
+	 * @details Since samples are usually taken at a fixed interval, the delta of deltas is mostly zero and encoded as
+	 * a single bit. Otherwise, its (zigzag-encoded) value is stored with a prefix that selects one of four widths.
+	 * An encoder and a decoder each keep their own state and must see the same sequence of values.
+	 *
+	 * [1] T. Pelkonen et al. "Gorilla: A Fast, Scalable, In-Memory Time Series Database". VLDB 2015.
+	 */
+	class DeltaOfDeltaCodec final {
+	private:
+		int64_t prev = 0;
+		int64_t prevDelta = 0;
+
+	public:
+		void encode(BitStream& stream, int64_t value) { encodeDelta(stream, value - prev); }
+		/**
+		 * @brief Like encode but given the difference of the value to the previous one (e.g., as computed for many
+		 * values at once by utils::simd::deltas).
+		 */
+		void encodeDelta(BitStream& stream, int64_t delta) {
+			auto dod = zigzag(delta - prevDelta);
+			prev += delta;
+			prevDelta = delta;
+			if (dod == 0) {
+				stream.writeBit(false);
+			} else if (dod < (uint64_t{1} << 7)) {
+				stream.write(0b10, 2);
+				stream.write(dod, 7);
+			} else if (dod < (uint64_t{1} << 9)) {
+				stream.write(0b110, 3);
+				stream.write(dod, 9);
+			} else if (dod < (uint64_t{1} << 12)) {
+				stream.write(0b1110, 4);
+				stream.write(dod, 12);
+			} else {
+				stream.write(0b1111, 4);
+				stream.write(dod, 64);
+			}
+		}
+		int64_t decode(BitStream::Reader& reader) noexcept {
+			unsigned width = 0;
+			if (reader.readBit()) {
+				if (!reader.readBit())
+					width = 7;
+				else if (!reader.readBit())
+					width = 9;
+				else
+					width = reader.readBit() ? 64 : 12;
+			}
+			prevDelta += unzigzag(reader.read(width));
+			return prev += prevDelta;
+		}
+	};
+
+	/**
+	 * @brief Encodes a sequence of values compactly, exploiting that consecutive values of a time series tend to be
+	 * close to each other.
+	 * @details Integers are stored as the (zigzag-encoded) difference to their predecessor in a variable number of
+	 * 7-bit groups. Floating point values are XORed with their predecessor, such that only the bits in between the
+	 * leading and trailing zeros need to be stored (as in Gorilla). Like DeltaOfDeltaCodec, encoders and decoders
+	 * keep their own state.
+	 */
+	template <typename T>
+	class ValueCodec;
+
+	template <std::integral T>
+	class ValueCodec<T> final {
+	private:
+		uint64_t prev = 0;
+
+	public:
+		void encode(BitStream& stream, T value) {
+			// Wraps around for 64-bit values, which the decoder reverses
+			auto diff = zigzag(static_cast<int64_t>(static_cast<uint64_t>(value) - prev));
+			prev = static_cast<uint64_t>(value);
+			do {
+				auto group = diff & 0x7f;
+				diff >>= 7;
+				stream.write(group | ((diff != 0) ? 0x80 : 0), 8);
+			} while (diff != 0);
+		}
+		T decode(BitStream::Reader& reader) noexcept {
+			uint64_t diff = 0;
+			for (unsigned shift = 0;; shift += 7) {
+				auto group = reader.read(8);
+				diff |= (group & 0x7f) << shift;
+				if ((group & 0x80) == 0)
+					break;
+			}
+			prev += static_cast<uint64_t>(unzigzag(diff));
+			return static_cast<T>(prev);
+		}
+	};
+
+	template <std::floating_point T>
+	class ValueCodec<T> final {
+	private:
+		static_assert(sizeof(T) <= sizeof(uint64_t));
+		using Bits = std::conditional_t<sizeof(T) == sizeof(uint64_t), uint64_t, uint32_t>;
+		static constexpr unsigned width = sizeof(Bits) * 8;
+
+		Bits prev = 0;
+		/** @brief The window of meaningful bits of the previous XOR (none until the first non-zero XOR). **/
+		unsigned leading = width;
+		unsigned trailing = 0;
+
+	public:
+		void encode(BitStream& stream, T value) {
+			auto bits = std::bit_cast<Bits>(value);
+			auto xored = bits ^ prev;
+			prev = bits;
+			if (xored == 0) {
+				stream.writeBit(false);
+				return;
+			}
+			stream.writeBit(true);
+			auto lz = std::min(static_cast<unsigned>(std::countl_zero(xored)), 31u);
+			auto tz = static_cast<unsigned>(std::countr_zero(xored));
+			if (leading != width && lz >= leading && tz >= trailing) { // Fits into the previous window
+				stream.writeBit(false);
+				stream.write(xored >> trailing, width - leading - trailing);
+			} else {
+				leading = lz;
+				trailing = tz;
+				auto meaningful = width - leading - trailing;
+				stream.writeBit(true);
+				stream.write(leading, 5);
+				stream.write(meaningful - 1, 6);
+				stream.write(xored >> trailing, meaningful);
+			}
+		}
+		T decode(BitStream::Reader& reader) noexcept {
+			if (reader.readBit()) {
+				if (reader.readBit()) {
+					leading = static_cast<unsigned>(reader.read(5));
+					trailing = width - leading - (static_cast<unsigned>(reader.read(6)) + 1);
+				}
+				prev ^= static_cast<Bits>(reader.read(width - leading - trailing) << trailing);
+			}
+			return std::bit_cast<T>(prev);
+		}
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef MEASURE_UTILS_DDSKETCH_HPP
+#define MEASURE_UTILS_DDSKETCH_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace tirex::utils {
+	/**
+	 * @brief A quantile sketch whose estimates are within a relative error of the true quantiles (DDSketch [1]).
+	 * @details Values are counted in logarithmically growing bins, where the bin of a positive value x is
+	 * ceil(log_gamma(x)) with gamma = (1 + alpha) / (1 - alpha) for a relative accuracy of alpha. Negative values are
+	 * counted by their magnitude in a second set of bins and values close to zero separately. Bins are only allocated
+	 * between the smallest and largest bin that was used. If more than maxBins bins would be needed, the lowest bins
+	 * are merged, such that only the accuracy of the smallest quantiles degrades. Hence, the memory is bounded
+	 * regardless of how many values are added. Sketches with the same parameters can be merged (see DDSketch::merge),
+	 * which yields the same sketch as adding all values to one (unless bins had to be merged).
+	 *
+	 * [1] C. Masson et al. "DDSketch: A Fast and Fully-Mergeable Quantile Sketch with Relative-Error Guarantees".
+	 * VLDB 2019.
+	 */
+	class DDSketch final {
+	private:
+		/** @brief Magnitudes below this are counted as zero. **/
+		static constexpr double minIndexable = 1e-9;
+
+		/** @brief A contiguous range of bins, starting at the bin with index Bins::offset. **/
+		struct Bins final {
+			std::vector<uint64_t> counts;
+			int offset = 0;
+
+			void add(int index, uint64_t count, size_t maxBins) {
+				if (counts.empty()) {
+					offset = index;
+					counts.assign(1, count);
+					return;
+				}
+				auto top = offset + static_cast<int>(counts.size()) - 1;
+				auto lowest = std::min(offset, index), highest = std::max(top, index);
+				if (highest - lowest + 1 > static_cast<int>(maxBins)) // The lowest bins are merged
+					lowest = highest - static_cast<int>(maxBins) + 1;
+				index = std::max(index, lowest);
+				if (lowest != offset || highest != top) {
+					std::vector<uint64_t> resized(static_cast<size_t>(highest - lowest) + 1, 0);
+					for (size_t i = 0; i < counts.size(); ++i) {
+						auto to = std::max(offset + static_cast<int>(i), lowest);
+						resized[static_cast<size_t>(to - lowest)] += counts[i];
+					}
+					counts = std::move(resized);
+					offset = lowest;
+				}
+				counts[static_cast<size_t>(index - offset)] += count;
+			}
+		};
+
+		double gamma;
+		double logGamma;
+		size_t maxBins;
+		Bins positive;
+		Bins negative;
+		uint64_t zeroCount = 0;
+		uint64_t num = 0;
+		double minimum = std::numeric_limits<double>::infinity();
+		double maximum = -std::numeric_limits<double>::infinity();
+
+		int indexOf(double magnitude) const noexcept {
+			return static_cast<int>(std::ceil(std::log(magnitude) / logGamma));
+		}
+		/** @brief The magnitude that represents the bin \p index (which is within the relative accuracy). */
+		double valueOf(int index) const noexcept { return 2 * std::pow(gamma, index) / (gamma + 1); }
+		double clamp(double value) const noexcept { return std::min(std::max(value, minimum), maximum); }
+
+	public:
+		/**
+		 * @param relativeAccuracy The relative error of the quantiles (e.g., 0.01 for 1%).
+		 * @param maxBins The maximum number of bins per sign.
+		 */
+		explicit DDSketch(double relativeAccuracy = 0.01, size_t maxBins = 2048)
+				: gamma((1 + relativeAccuracy) / (1 - relativeAccuracy)), logGamma(std::log(gamma)),
+				  maxBins(std::max(size_t(1), maxBins)) {}
+
+		void add(double value, uint64_t count = 1) {
+			if (value > minIndexable)
+				positive.add(indexOf(value), count, maxBins);
+			else if (value < -minIndexable)
+				negative.add(indexOf(-value), count, maxBins);
+			else
+				zeroCount += count;
+			num += count;
+			minimum = std::min(minimum, value);
+			maximum = std::max(maximum, value);
+		}
+
+		/**
+		 * @brief Adds all values that were added to \p other. Both sketches must have been constructed with the same
+		 * parameters.
+		 */
+		void merge(const DDSketch& other) {
+			assert(gamma == other.gamma && maxBins == other.maxBins);
+			for (size_t i = 0; i < other.positive.counts.size(); ++i) {
+				if (other.positive.counts[i] != 0)
+					positive.add(other.positive.offset + static_cast<int>(i), other.positive.counts[i], maxBins);
+			}
+			for (size_t i = 0; i < other.negative.counts.size(); ++i) {
+				if (other.negative.counts[i] != 0)
+					negative.add(other.negative.offset + static_cast<int>(i), other.negative.counts[i], maxBins);
+			}
+			zeroCount += other.zeroCount;
+			num += other.num;
+			minimum = std::min(minimum, other.minimum);
+			maximum = std::max(maximum, other.maximum);
+		}
+
+		/**
+		 * @brief Returns an estimate of the \p q -quantile (e.g., 0.5 for the median) of the added values.
+		 * @details The estimate is clamped to the smallest and largest added value, such that the 0- and 1-quantile
+		 * are exact. Returns 0 if no values were added.
+		 */
+		double quantile(double q) const noexcept {
+			if (num == 0)
+				return 0.0;
+			if (q <= 0 || q >= 1) // The extremes are known exactly
+				return (q <= 0) ? minimum : maximum;
+			auto rank = q * static_cast<double>(num - 1);
+			uint64_t seen = 0;
+			// Negative values in ascending order, i.e., by descending magnitude
+			for (size_t i = negative.counts.size(); i-- > 0;) {
+				seen += negative.counts[i];
+				if (static_cast<double>(seen) > rank)
+					return clamp(-valueOf(negative.offset + static_cast<int>(i)));
+			}
+			seen += zeroCount;
+			if (static_cast<double>(seen) > rank)
+				return clamp(0.0);
+			for (size_t i = 0; i < positive.counts.size(); ++i) {
+				seen += positive.counts[i];
+				if (static_cast<double>(seen) > rank)
+					return clamp(valueOf(positive.offset + static_cast<int>(i)));
+			}
+			return maximum;
+		}
+
+		uint64_t count() const noexcept { return num; }
+		/** @brief The number of bytes that the sketch allocated for its bins. */
+		size_t memoryUsage() const noexcept {
+			return (positive.counts.capacity() + negative.counts.capacity()) * sizeof(uint64_t);
+		}
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef MEASURE_UTILS_DEADLINESCHEDULER_HPP
+#define MEASURE_UTILS_DEADLINESCHEDULER_HPP
+
+#include "deadlinetimer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace tirex::utils {
+	/**
+	 * @brief Multiplexes periodic tasks with individual rates onto a single thread.
+	 * @details Each task is identified by an id and owns a DeadlineTimer. The timers are kept in a min-heap ordered by
+	 * their next deadline such that the scheduler only needs to sleep until the earliest one and only wakes up the
+	 * tasks that are actually due. Tasks that are returned by DeadlineScheduler::wait are considered to be running
+	 * until the next call to DeadlineScheduler::wait, which reschedules them with respect to the time at which they
+	 * finished. This way, the time a task needs is accounted for when skipping overrun deadlines.
+	 *
+	 * Waiting is implemented on top of absolute timeouts on the steady clock (e.g., std::future::wait_until or
+	 * std::condition_variable::wait_until). This keeps the wait cancellable and, on Linux, translates to a futex wait
+	 * with an absolute CLOCK_MONOTONIC timeout.
+	 */
+	class DeadlineScheduler final {
+	public:
+		using clock = DeadlineTimer::clock;
+
+	private:
+		struct Task {
+			size_t id;
+			DeadlineTimer timer;
+		};
+		std::vector<Task> queue;   /**< Min-heap of the scheduled tasks, ordered by their next deadline. **/
+		std::vector<Task> running; /**< The tasks that were returned by the last call to DeadlineScheduler::wait. **/
+		clock::duration lastLateness{0};
+		clock::time_point lastTick;
+		size_t missed = 0;
+
+		static bool later(const Task& a, const Task& b) noexcept {
+			return a.timer.currentDeadline() > b.timer.currentDeadline();
+		}
+
+	public:
+		/**
+		 * @brief Schedules the task \p id to become due every \p period starting at \p starttime.
+		 */
+		void schedule(size_t id, clock::duration period, clock::time_point starttime) {
+			queue.emplace_back(Task{id, DeadlineTimer{period, starttime}});
+			std::push_heap(queue.begin(), queue.end(), later);
+		}
+
+		/**
+		 * @brief Removes the task \p id from the schedule. Does nothing if there is no such task.
+		 */
+		void unschedule(size_t id) {
+			auto matches = [id](const Task& task) { return task.id == id; };
+			std::erase_if(running, matches);
+			if (std::erase_if(queue, matches) > 0)
+				std::make_heap(queue.begin(), queue.end(), later);
+		}
+
+		/**
+		 * @brief Changes the period of the task \p id, starting with its deadline after the current one. Does nothing
+		 * if there is no such task.
+		 */
+		void setPeriod(size_t id, clock::duration period) {
+			for (auto tasks : {&running, &queue}) {
+				for (auto& task : *tasks) {
+					if (task.id == id)
+						task.timer.setInterval(period); // The current deadlines (and thus the heap order) are kept
+				}
+			}
+		}
+
+		/**
+		 * @brief Reschedules the tasks returned by the last call and blocks until the next task is due or until the
+		 * wait is interrupted.
+		 * @details The wait itself is delegated to \p waitUntil, which is called with the deadline to wait for and
+		 * must return false if the scheduler should stop. It may return early (e.g., since the schedule was modified),
+		 * in which case \p due may be empty.
+		 *
+		 * @param waitUntil Blocks until the given deadline or until it is interrupted.
+		 * @param[out] due Populated with the ids of all tasks that are due.
+		 * @return false if the scheduler should stop and true otherwise.
+		 */
+		template <typename WaitFn>
+		bool wait(WaitFn&& waitUntil, std::vector<size_t>& due) {
+			auto now = clock::now();
+			for (auto& task : running) {
+				missed += task.timer.advance(now);
+				queue.emplace_back(std::move(task));
+				std::push_heap(queue.begin(), queue.end(), later);
+			}
+			running.clear();
+			due.clear();
+
+			auto deadline = queue.empty() ? now + std::chrono::hours{1} : queue.front().timer.currentDeadline();
+			if (!waitUntil(deadline))
+				return false;
+			now = clock::now();
+			if (!queue.empty())
+				lastTick = queue.front().timer.currentDeadline();
+			while (!queue.empty() && queue.front().timer.currentDeadline() <= now) {
+				std::pop_heap(queue.begin(), queue.end(), later);
+				due.push_back(queue.back().id);
+				running.emplace_back(std::move(queue.back()));
+				queue.pop_back();
+			}
+			if (!due.empty())
+				lastLateness = now - deadline;
+			return true;
+		}
+
+		/**
+		 * @brief The earliest deadline that was due at the last wakeup, i.e., the nominal time of the tick that all
+		 * tasks returned by the last call to DeadlineScheduler::wait share.
+		 */
+		clock::time_point tick() const noexcept { return lastTick; }
+		/** @brief How late the last wakeup was with respect to the earliest deadline that was due. */
+		clock::duration lateness() const noexcept { return lastLateness; }
+		/** @brief The total number of deadlines (of all tasks) that were skipped since they were already overrun. */
+		size_t missedDeadlines() const noexcept { return missed; }
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MEASURE_UTILS_DEADLINETIMER_HPP
+#define MEASURE_UTILS_DEADLINETIMER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace tirex::utils {
+	/**
+	 * @brief A periodic sequence of absolute deadlines.
+	 * @details The i-th deadline is always `start + i * period`, such that the time spent between two deadlines (e.g.,
+	 * stepping the providers) does not accumulate into drift. If the caller overran one or more deadlines, these are
+	 * skipped (and counted) instead of firing in a burst to catch up.
+	 */
+	class DeadlineTimer final {
+	public:
+		using clock = std::chrono::steady_clock;
+
+	private:
+		clock::duration period;
+		clock::time_point deadline;
+		size_t missed = 0;
+
+	public:
+		explicit DeadlineTimer(clock::duration period, clock::time_point starttime = clock::now()) noexcept
+				: period(std::max(period, clock::duration{1})), deadline(starttime) {}
+
+		/**
+		 * @brief Advances to the next deadline that lies after \p now while staying in phase.
+		 *
+		 * @param now The current point in time.
+		 * @return the number of deadlines that were skipped since they were already overrun.
+		 */
+		size_t advance(clock::time_point now = clock::now()) noexcept {
+			deadline += period;
+			if (now < deadline)
+				return 0;
+			auto skip = static_cast<size_t>((now - deadline) / period + 1);
+			missed += skip;
+			deadline += skip * period;
+			return skip;
+		}
+
+		/** @brief The deadline that the timer currently waits for (or the start time if it was not advanced yet). */
+		clock::time_point currentDeadline() const noexcept { return deadline; }
+		/** @brief The total number of deadlines that were skipped since they were already overrun. */
+		size_t missedDeadlines() const noexcept { return missed; }
+		clock::duration interval() const noexcept { return period; }
+		/** @brief Changes the period, starting with the deadline after the current one. */
+		void setInterval(clock::duration interval) noexcept { period = std::max(interval, clock::duration{1}); }
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef MEASURE_UTILS_HISTOGRAM_HPP
+#define MEASURE_UTILS_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <nlohmann/json.hpp>
+
+namespace tirex::utils {
+	/**
+	 * @brief A fixed-size histogram over unsigned integers with logarithmically growing buckets.
+	 * @details Values below 2^SubBits get a bucket each. Above that, every power of two is split into 2^SubBits
+	 * equally wide buckets, i.e., the relative error of a quantile is bounded by 2^-SubBits regardless of the
+	 * magnitude of the values (similar to an HDR histogram). The memory needed is constant, such that arbitrarily many
+	 * values can be accumulated.
+	 *
+	 * Recording is lock-free and may happen concurrently from any number of threads. Reads may run concurrently to
+	 * recording but are then not guaranteed to reflect a single point in time.
+	 *
+	 * @tparam SubBits The number of bits of precision that are kept per value.
+	 */
+	template <unsigned SubBits = 4>
+	class LogHistogram final {
+	private:
+		static constexpr uint64_t subBuckets = uint64_t{1} << SubBits;
+		static constexpr size_t numBuckets = (64 - SubBits + 1) * subBuckets;
+
+		std::array<std::atomic<uint64_t>, numBuckets> buckets{};
+		std::atomic<uint64_t> num{0};
+		std::atomic<uint64_t> total{0};
+		std::atomic<uint64_t> minimum{std::numeric_limits<uint64_t>::max()};
+		std::atomic<uint64_t> maximum{0};
+
+		static constexpr size_t bucketOf(uint64_t value) noexcept {
+			if (value < subBuckets)
+				return value;
+			auto shift = static_cast<unsigned>(std::bit_width(value)) - SubBits - 1;
+			return (shift + 1) * subBuckets + ((value >> shift) & (subBuckets - 1));
+		}
+		/** @brief The smallest value that falls into the bucket \p index. */
+		static constexpr uint64_t lowerBound(size_t index) noexcept {
+			if (index < subBuckets)
+				return index;
+			auto shift = index / subBuckets - 1;
+			return (subBuckets | (index & (subBuckets - 1))) << shift;
+		}
+		/** @brief The largest value that falls into the bucket \p index. */
+		static constexpr uint64_t upperBound(size_t index) noexcept {
+			return (index + 1 < numBuckets) ? lowerBound(index + 1) - 1 : std::numeric_limits<uint64_t>::max();
+		}
+
+	public:
+		/**
+		 * @brief A copy of the histogram's state at a point in time.
+		 * @details Snapshots can be subtracted from each other (see Snapshot::since) to obtain the distribution of the
+		 * values that were recorded in between.
+		 */
+		struct Snapshot final {
+			std::array<uint64_t, numBuckets> counts{};
+			uint64_t count = 0;
+			uint64_t sum = 0;
+			uint64_t min = 0;
+			uint64_t max = 0;
+
+			double mean() const noexcept {
+				return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+			}
+
+			/**
+			 * @brief Returns an estimate of the \p q -quantile (e.g., 0.5 for the median) of the recorded values.
+			 * @details The estimate is the midpoint of the bucket that contains the quantile, clamped to the smallest
+			 * and largest recorded value. The 0- and 1-quantile are exact. Returns 0 if no values were recorded.
+			 */
+			double quantile(double q) const noexcept {
+				if (count == 0)
+					return 0.0;
+				auto rank = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+				if (rank <= 1 || rank >= count) // The extremes are known exactly
+					return static_cast<double>(rank <= 1 ? min : max);
+				uint64_t seen = 0;
+				size_t index = 0;
+				for (; index + 1 < numBuckets; ++index) {
+					seen += counts[index];
+					if (seen >= rank)
+						break;
+				}
+				auto lower = static_cast<double>(lowerBound(index));
+				auto upper = static_cast<double>(upperBound(index));
+				auto estimate = (index < subBuckets) ? lower : (lower + upper) / 2;
+				auto lo = static_cast<double>(min), hi = static_cast<double>(max);
+				return estimate < lo ? lo : (estimate > hi ? hi : estimate);
+			}
+
+			/**
+			 * @brief Returns the distribution of the values that were recorded after \p earlier was taken.
+			 * @details The minimum and maximum are only exact if they changed in the meantime. Otherwise, they are
+			 * bounded by the buckets of the smallest and largest value. If \p earlier is not an earlier snapshot of
+			 * the same histogram (e.g., since the histogram was recreated), this snapshot is returned as is.
+			 */
+			Snapshot since(const Snapshot& earlier) const noexcept {
+				if (earlier.count > count)
+					return *this;
+				Snapshot diff;
+				size_t first = numBuckets, last = 0;
+				for (size_t i = 0; i < numBuckets; ++i) {
+					diff.counts[i] = counts[i] - earlier.counts[i];
+					if (diff.counts[i] != 0) {
+						first = std::min(first, i);
+						last = i;
+					}
+				}
+				diff.count = count - earlier.count;
+				diff.sum = sum - earlier.sum;
+				if (diff.count != 0) {
+					diff.min = (earlier.count == 0 || min < earlier.min) ? min : std::max(lowerBound(first), min);
+					diff.max = (earlier.count == 0 || max > earlier.max) ? max : std::min(upperBound(last), max);
+				}
+				return diff;
+			}
+		};
+
+		LogHistogram() = default;
+		LogHistogram(const LogHistogram&) = delete;
+		LogHistogram& operator=(const LogHistogram&) = delete;
+
+		void record(uint64_t value) noexcept {
+			buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+			num.fetch_add(1, std::memory_order_relaxed);
+			total.fetch_add(value, std::memory_order_relaxed);
+			auto current = minimum.load(std::memory_order_relaxed);
+			while (value < current && !minimum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+				;
+			current = maximum.load(std::memory_order_relaxed);
+			while (value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed))
+				;
+		}
+
+		uint64_t count() const noexcept { return num.load(std::memory_order_relaxed); }
+		uint64_t sum() const noexcept { return total.load(std::memory_order_relaxed); }
+		uint64_t min() const noexcept { return count() == 0 ? 0 : minimum.load(std::memory_order_relaxed); }
+		uint64_t max() const noexcept { return maximum.load(std::memory_order_relaxed); }
+		double mean() const noexcept {
+			auto n = count();
+			return n == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(n);
+		}
+
+		Snapshot snapshot() const noexcept {
+			Snapshot snapshot;
+			for (size_t i = 0; i < numBuckets; ++i)
+				snapshot.count += snapshot.counts[i] = buckets[i].load(std::memory_order_relaxed);
+			// Derive the count from the buckets such that it is consistent with them
+			snapshot.sum = sum();
+			snapshot.min = (snapshot.count == 0) ? 0 : minimum.load(std::memory_order_relaxed);
+			snapshot.max = maximum.load(std::memory_order_relaxed);
+			return snapshot;
+		}
+
+		/** @copydoc Snapshot::quantile */
+		double quantile(double q) const noexcept { return snapshot().quantile(q); }
+	};
+
+	/**
+	 * @brief Summarizes \p histogram as a JSON object of its count, mean, min, max, and quantiles, scaling its values
+	 * by \p scale to the unit of the measure.
+	 */
+	inline nlohmann::json summarize(const LogHistogram<>::Snapshot& histogram, double scale) {
+		return {{"count", histogram.count},
+				{"mean", histogram.mean() * scale},
+				{"min", static_cast<double>(histogram.min) * scale},
+				{"max", static_cast<double>(histogram.max) * scale},
+				{"p50", histogram.quantile(0.5) * scale},
+				{"p90", histogram.quantile(0.9) * scale},
+				{"p99", histogram.quantile(0.99) * scale}};
+	}
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef MEASURE_UTILS_SEQLOCK_HPP
+#define MEASURE_UTILS_SEQLOCK_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace tirex::utils {
+	/**
+	 * @brief Publishes a small, trivially copyable value from a single writer to any number of readers.
+	 * @details The writer never waits for readers: it makes the sequence number odd, writes the value and makes the
+	 * sequence number even again. Readers copy the value and retry if the sequence number was odd or changed in the
+	 * meantime, i.e., they only ever spin while a write is in progress. The value is stored as relaxed atomic words
+	 * such that concurrent reads and writes are not a data race.
+	 *
+	 * Writes must be serialized by the caller (e.g., by only writing from a single thread or while holding a lock that
+	 * readers do not need).
+	 *
+	 * @tparam T The type of the published value.
+	 */
+	template <typename T>
+	class SeqLock final {
+		static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+	private:
+		static constexpr size_t numWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+		std::atomic<uint64_t> sequence{0};
+		std::array<std::atomic<uint64_t>, numWords> data{};
+
+	public:
+		SeqLock() noexcept { store(T{}); }
+		explicit SeqLock(const T& value) noexcept { store(value); }
+		SeqLock(const SeqLock&) = delete;
+		SeqLock& operator=(const SeqLock&) = delete;
+
+		/**
+		 * @brief Publishes \p value. Must not be called concurrently with other calls to SeqLock::store.
+		 */
+		void store(const T& value) noexcept {
+			std::array<uint64_t, numWords> words{};
+			std::memcpy(words.data(), &value, sizeof(T));
+			auto seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (size_t i = 0; i < numWords; ++i)
+				data[i].store(words[i], std::memory_order_relaxed);
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Returns a consistent copy of the last published value. Never blocks the writer.
+		 */
+		T load() const noexcept {
+			std::array<uint64_t, numWords> words;
+			uint64_t before, after;
+			do {
+				before = sequence.load(std::memory_order_acquire);
+				for (size_t i = 0; i < numWords; ++i)
+					words[i] = data[i].load(std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_acquire);
+				after = sequence.load(std::memory_order_relaxed);
+			} while ((before & 1) != 0 || before != after);
+			T value;
+			std::memcpy(&value, words.data(), sizeof(T));
+			return value;
+		}
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,389 @@
+#include "simd.hpp"
+
+#include <cpuinfo.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TIREX_SIMD_AVX2
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+// Only these functions are compiled for AVX2 such that the rest of the library still runs on any x86-64 CPU
+#define TIREX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TIREX_TARGET_AVX2
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define TIREX_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace tirex::utils::simd;
+
+static_assert(sizeof(std::chrono::milliseconds) == sizeof(int64_t));
+
+Isa tirex::utils::simd::isa() noexcept {
+	static const Isa selected = [] {
+		if (!cpuinfo_initialize())
+			return Isa::Scalar;
+#if defined(TIREX_SIMD_AVX2)
+		if (cpuinfo_has_x86_avx2())
+			return Isa::AVX2;
+#elif defined(TIREX_SIMD_NEON)
+		if (cpuinfo_has_arm_neon())
+			return Isa::NEON;
+#endif
+		return Isa::Scalar;
+	}();
+	return selected;
+}
+
+namespace scalar {
+	template <typename T>
+	static MinMax<T> minMax(std::span<const T> values, MinMax<T> result) noexcept {
+		for (const auto& value : values) {
+			result.min = std::min(result.min, value);
+			result.max = std::max(result.max, value);
+		}
+		return result;
+	}
+
+	template <typename T>
+	static T combine(const T& a, const T& b, Pairwise op) noexcept {
+		switch (op) {
+		case Pairwise::Max:
+			return std::max(a, b);
+		case Pairwise::Min:
+			return std::min(a, b);
+		case Pairwise::Mean:
+		default:
+			return (a + b) / 2;
+		}
+	}
+
+	/** @brief Merges the pairs of values from the \p first pair on. */
+	template <typename T>
+	static void pairwise(std::span<const T> values, T* out, Pairwise op, size_t first) noexcept {
+		for (size_t i = first; 2 * i + 1 < values.size(); ++i)
+			out[i] = combine(values[2 * i], values[2 * i + 1], op);
+	}
+
+	/** @brief Computes the deltas from the timestamp at \p first on, which must not be the first timestamp. */
+	static void deltas(std::span<const std::chrono::milliseconds> timepoints, int64_t* out, size_t first) noexcept {
+		for (size_t i = first; i < timepoints.size(); ++i)
+			out[i] = (timepoints[i] - timepoints[i - 1]).count();
+	}
+} // namespace scalar
+
+#if defined(TIREX_SIMD_AVX2)
+namespace avx2 {
+	template <typename T>
+	struct Vec;
+
+	template <>
+	struct Vec<uint32_t> final {
+		using type = __m256i;
+		static constexpr size_t width = 8;
+
+		TIREX_TARGET_AVX2 static type load(const uint32_t* ptr) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+		}
+		TIREX_TARGET_AVX2 static void store(uint32_t* ptr, type vec) noexcept {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), vec);
+		}
+		TIREX_TARGET_AVX2 static type broadcast(uint32_t value) noexcept {
+			return _mm256_set1_epi32(static_cast<int>(value));
+		}
+		TIREX_TARGET_AVX2 static type min(type a, type b) noexcept { return _mm256_min_epu32(a, b); }
+		TIREX_TARGET_AVX2 static type max(type a, type b) noexcept { return _mm256_max_epu32(a, b); }
+		TIREX_TARGET_AVX2 static type mean(type a, type b) noexcept {
+			return _mm256_srli_epi32(_mm256_add_epi32(a, b), 1);
+		}
+		/** @brief Loads 2 * width values and splits them into the ones at even and at odd positions. */
+		TIREX_TARGET_AVX2 static void split(const uint32_t* ptr, type& even, type& odd) noexcept {
+			auto a = _mm256_castsi256_ps(load(ptr));
+			auto b = _mm256_castsi256_ps(load(ptr + width));
+			// Shuffling works within 128-bit lanes, which the permutation puts back in order
+			even = _mm256_permute4x64_epi64(
+					_mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)
+			);
+			odd = _mm256_permute4x64_epi64(
+					_mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)
+			);
+		}
+	};
+
+	template <>
+	struct Vec<uint64_t> final {
+		using type = __m256i;
+		static constexpr size_t width = 4;
+
+		TIREX_TARGET_AVX2 static type load(const uint64_t* ptr) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+		}
+		TIREX_TARGET_AVX2 static void store(uint64_t* ptr, type vec) noexcept {
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), vec);
+		}
+		TIREX_TARGET_AVX2 static type broadcast(uint64_t value) noexcept {
+			return _mm256_set1_epi64x(static_cast<int64_t>(value));
+		}
+		/** @brief Whether a > b, for which AVX2 only has a signed comparison. */
+		TIREX_TARGET_AVX2 static type greater(type a, type b) noexcept {
+			auto sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+			return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+		}
+		TIREX_TARGET_AVX2 static type min(type a, type b) noexcept {
+			return _mm256_blendv_epi8(a, b, greater(a, b));
+		}
+		TIREX_TARGET_AVX2 static type max(type a, type b) noexcept {
+			return _mm256_blendv_epi8(a, b, greater(b, a));
+		}
+		TIREX_TARGET_AVX2 static type mean(type a, type b) noexcept {
+			return _mm256_srli_epi64(_mm256_add_epi64(a, b), 1);
+		}
+		TIREX_TARGET_AVX2 static void split(const uint64_t* ptr, type& even, type& odd) noexcept {
+			auto a = load(ptr), b = load(ptr + width);
+			even = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+			odd = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		}
+	};
+
+	template <>
+	struct Vec<double> final {
+		using type = __m256d;
+		static constexpr size_t width = 4;
+
+		TIREX_TARGET_AVX2 static type load(const double* ptr) noexcept { return _mm256_loadu_pd(ptr); }
+		TIREX_TARGET_AVX2 static void store(double* ptr, type vec) noexcept { _mm256_storeu_pd(ptr, vec); }
+		TIREX_TARGET_AVX2 static type broadcast(double value) noexcept { return _mm256_set1_pd(value); }
+		// The operands are swapped to match std::min and std::max if values compare equal or are NaN
+		TIREX_TARGET_AVX2 static type min(type a, type b) noexcept { return _mm256_min_pd(b, a); }
+		TIREX_TARGET_AVX2 static type max(type a, type b) noexcept { return _mm256_max_pd(b, a); }
+		TIREX_TARGET_AVX2 static type mean(type a, type b) noexcept {
+			return _mm256_mul_pd(_mm256_add_pd(a, b), _mm256_set1_pd(0.5));
+		}
+		TIREX_TARGET_AVX2 static void split(const double* ptr, type& even, type& odd) noexcept {
+			auto a = load(ptr), b = load(ptr + width);
+			even = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+			odd = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		}
+	};
+
+	template <typename T>
+	TIREX_TARGET_AVX2 static MinMax<T> minMax(std::span<const T> values) noexcept {
+		using V = Vec<T>;
+		MinMax<T> result{values[0], values[0]};
+		if (values.size() < 2 * V::width)
+			return scalar::minMax(values, result);
+		// Starting from the first value (instead of the first vector) keeps later NaNs out like std::min does
+		auto lo = V::broadcast(values[0]), hi = lo;
+		size_t i = 0;
+		for (; i + V::width <= values.size(); i += V::width) {
+			auto vec = V::load(values.data() + i);
+			lo = V::min(lo, vec);
+			hi = V::max(hi, vec);
+		}
+		T lows[V::width], highs[V::width];
+		V::store(lows, lo);
+		V::store(highs, hi);
+		result = scalar::minMax(std::span<const T>(lows), result);
+		result = scalar::minMax(std::span<const T>(highs), result);
+		return scalar::minMax(values.subspan(i), result);
+	}
+
+	template <typename T>
+	TIREX_TARGET_AVX2 static void pairwise(std::span<const T> values, T* out, Pairwise op) noexcept {
+		using V = Vec<T>;
+		// Every iteration reads 2 * width values before writing width values, so the values can be merged in place
+		size_t i = 0;
+		for (; 2 * (i + V::width) <= values.size(); i += V::width) {
+			typename V::type even, odd;
+			V::split(values.data() + 2 * i, even, odd);
+			switch (op) {
+			case Pairwise::Max:
+				V::store(out + i, V::max(even, odd));
+				break;
+			case Pairwise::Min:
+				V::store(out + i, V::min(even, odd));
+				break;
+			case Pairwise::Mean:
+				V::store(out + i, V::mean(even, odd));
+				break;
+			}
+		}
+		scalar::pairwise(values, out, op, i);
+	}
+
+	TIREX_TARGET_AVX2 static void deltas(std::span<const std::chrono::milliseconds> timepoints, int64_t* out) noexcept {
+		size_t i = 1;
+		for (; i + 4 <= timepoints.size(); i += 4) {
+			auto cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timepoints.data() + i));
+			auto prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timepoints.data() + i - 1));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi64(cur, prev));
+		}
+		scalar::deltas(timepoints, out, i);
+	}
+} // namespace avx2
+#endif
+
+#if defined(TIREX_SIMD_NEON)
+namespace neon {
+	template <typename T>
+	struct Vec;
+
+	template <>
+	struct Vec<uint32_t> final {
+		using type = uint32x4_t;
+		static constexpr size_t width = 4;
+
+		static type load(const uint32_t* ptr) noexcept { return vld1q_u32(ptr); }
+		static void store(uint32_t* ptr, type vec) noexcept { vst1q_u32(ptr, vec); }
+		static type broadcast(uint32_t value) noexcept { return vdupq_n_u32(value); }
+		static type min(type a, type b) noexcept { return vminq_u32(a, b); }
+		static type max(type a, type b) noexcept { return vmaxq_u32(a, b); }
+		static type mean(type a, type b) noexcept { return vshrq_n_u32(vaddq_u32(a, b), 1); }
+		/** @brief Loads 2 * width values and splits them into the ones at even and at odd positions. */
+		static void split(const uint32_t* ptr, type& even, type& odd) noexcept {
+			auto pairs = vld2q_u32(ptr);
+			even = pairs.val[0];
+			odd = pairs.val[1];
+		}
+	};
+
+	template <>
+	struct Vec<uint64_t> final {
+		using type = uint64x2_t;
+		static constexpr size_t width = 2;
+
+		static type load(const uint64_t* ptr) noexcept { return vld1q_u64(ptr); }
+		static void store(uint64_t* ptr, type vec) noexcept { vst1q_u64(ptr, vec); }
+		static type broadcast(uint64_t value) noexcept { return vdupq_n_u64(value); }
+		static type min(type a, type b) noexcept { return vbslq_u64(vcgtq_u64(a, b), b, a); }
+		static type max(type a, type b) noexcept { return vbslq_u64(vcgtq_u64(b, a), b, a); }
+		static type mean(type a, type b) noexcept { return vshrq_n_u64(vaddq_u64(a, b), 1); }
+		static void split(const uint64_t* ptr, type& even, type& odd) noexcept {
+			auto pairs = vld2q_u64(ptr);
+			even = pairs.val[0];
+			odd = pairs.val[1];
+		}
+	};
+
+	template <>
+	struct Vec<double> final {
+		using type = float64x2_t;
+		static constexpr size_t width = 2;
+
+		static type load(const double* ptr) noexcept { return vld1q_f64(ptr); }
+		static void store(double* ptr, type vec) noexcept { vst1q_f64(ptr, vec); }
+		static type broadcast(double value) noexcept { return vdupq_n_f64(value); }
+		// Selects by comparison (unlike vminq_f64) to match std::min and std::max if values are NaN
+		static type min(type a, type b) noexcept { return vbslq_f64(vcltq_f64(b, a), b, a); }
+		static type max(type a, type b) noexcept { return vbslq_f64(vcltq_f64(a, b), b, a); }
+		static type mean(type a, type b) noexcept { return vmulq_n_f64(vaddq_f64(a, b), 0.5); }
+		static void split(const double* ptr, type& even, type& odd) noexcept {
+			auto pairs = vld2q_f64(ptr);
+			even = pairs.val[0];
+			odd = pairs.val[1];
+		}
+	};
+
+	template <typename T>
+	static MinMax<T> minMax(std::span<const T> values) noexcept {
+		using V = Vec<T>;
+		MinMax<T> result{values[0], values[0]};
+		if (values.size() < 2 * V::width)
+			return scalar::minMax(values, result);
+		// Starting from the first value (instead of the first vector) keeps later NaNs out like std::min does
+		auto lo = V::broadcast(values[0]), hi = lo;
+		size_t i = 0;
+		for (; i + V::width <= values.size(); i += V::width) {
+			auto vec = V::load(values.data() + i);
+			lo = V::min(lo, vec);
+			hi = V::max(hi, vec);
+		}
+		T lows[V::width], highs[V::width];
+		V::store(lows, lo);
+		V::store(highs, hi);
+		result = scalar::minMax(std::span<const T>(lows), result);
+		result = scalar::minMax(std::span<const T>(highs), result);
+		return scalar::minMax(values.subspan(i), result);
+	}
+
+	template <typename T>
+	static void pairwise(std::span<const T> values, T* out, Pairwise op) noexcept {
+		using V = Vec<T>;
+		size_t i = 0;
+		for (; 2 * (i + V::width) <= values.size(); i += V::width) {
+			typename V::type even, odd;
+			V::split(values.data() + 2 * i, even, odd);
+			switch (op) {
+			case Pairwise::Max:
+				V::store(out + i, V::max(even, odd));
+				break;
+			case Pairwise::Min:
+				V::store(out + i, V::min(even, odd));
+				break;
+			case Pairwise::Mean:
+				V::store(out + i, V::mean(even, odd));
+				break;
+			}
+		}
+		scalar::pairwise(values, out, op, i);
+	}
+
+	static void deltas(std::span<const std::chrono::milliseconds> timepoints, int64_t* out) noexcept {
+		const auto* counts = reinterpret_cast<const int64_t*>(timepoints.data());
+		size_t i = 1;
+		for (; i + 2 <= timepoints.size(); i += 2)
+			vst1q_s64(out + i, vsubq_s64(vld1q_s64(counts + i), vld1q_s64(counts + i - 1)));
+		scalar::deltas(timepoints, out, i);
+	}
+} // namespace neon
+#endif
+
+template <Vectorizable T>
+MinMax<T> tirex::utils::simd::minMax(std::span<const T> values) noexcept {
+#if defined(TIREX_SIMD_AVX2)
+	if (isa() == Isa::AVX2)
+		return avx2::minMax(values);
+#elif defined(TIREX_SIMD_NEON)
+	if (isa() == Isa::NEON)
+		return neon::minMax(values);
+#endif
+	return scalar::minMax(values, {values[0], values[0]});
+}
+template MinMax<uint32_t> tirex::utils::simd::minMax(std::span<const uint32_t> values) noexcept;
+template MinMax<uint64_t> tirex::utils::simd::minMax(std::span<const uint64_t> values) noexcept;
+template MinMax<double> tirex::utils::simd::minMax(std::span<const double> values) noexcept;
+
+template <Vectorizable T>
+void tirex::utils::simd::pairwise(std::span<const T> values, T* out, Pairwise op) noexcept {
+#if defined(TIREX_SIMD_AVX2)
+	if (isa() == Isa::AVX2)
+		return avx2::pairwise(values, out, op);
+#elif defined(TIREX_SIMD_NEON)
+	if (isa() == Isa::NEON)
+		return neon::pairwise(values, out, op);
+#endif
+	scalar::pairwise(values, out, op, 0);
+}
+template void tirex::utils::simd::pairwise(std::span<const uint32_t> values, uint32_t* out, Pairwise op) noexcept;
+template void tirex::utils::simd::pairwise(std::span<const uint64_t> values, uint64_t* out, Pairwise op) noexcept;
+template void tirex::utils::simd::pairwise(std::span<const double> values, double* out, Pairwise op) noexcept;
+
+void tirex::utils::simd::deltas(
+		std::span<const std::chrono::milliseconds> timepoints, std::chrono::milliseconds prev, int64_t* out
+) noexcept {
+	if (timepoints.empty())
+		return;
+	out[0] = (timepoints[0] - prev).count();
+#if defined(TIREX_SIMD_AVX2)
+	if (isa() == Isa::AVX2)
+		return avx2::deltas(timepoints, out);
+#elif defined(TIREX_SIMD_NEON)
+	if (isa() == Isa::NEON)
+		return neon::deltas(timepoints, out);
+#endif
+	scalar::deltas(timepoints, out, 1);
+}
@@ -0,0 +1,61 @@
+#ifndef MEASURE_UTILS_SIMD_HPP
+#define MEASURE_UTILS_SIMD_HPP
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Vectorized kernels for the bulk operations on time series (e.g., when they are thinned out or exported).
+ * @details Each kernel has an AVX2 (x86-64) and a NEON (ARM64) implementation next to a scalar one. Which one is used
+ * is selected once at runtime from the CPU's features as reported by cpuinfo, such that a single binary runs on all
+ * CPUs of an architecture. All implementations produce identical results.
+ */
+namespace tirex::utils::simd {
+	enum class Isa { Scalar, AVX2, NEON };
+
+	/** @brief The instruction set that the kernels use on this CPU. */
+	Isa isa() noexcept;
+
+	/** @brief The value types that the kernels are implemented for (the types time series are reported with). */
+	template <typename T>
+	concept Vectorizable = std::same_as<T, uint32_t> || std::same_as<T, uint64_t> || std::same_as<T, double>;
+
+	template <typename T>
+	struct MinMax final {
+		T min;
+		T max;
+	};
+
+	/**
+	 * @brief The smallest and the largest of \p values, which must not be empty. Like std::min and std::max, a NaN
+	 * is only returned if it is the first value.
+	 */
+	template <Vectorizable T>
+	MinMax<T> minMax(std::span<const T> values) noexcept;
+
+	enum class Pairwise { Max, Min, Mean };
+
+	/**
+	 * @brief Merges every two neighboring values into one, i.e., writes `op(values[2i], values[2i + 1])` to `out[i]`
+	 * for all complete pairs. The mean of two values is `(a + b) / 2` as computed by T (i.e., integers wrap around).
+	 *
+	 * @param out Receives `values.size() / 2` values. May be `values.data()` to merge the values in place.
+	 */
+	template <Vectorizable T>
+	void pairwise(std::span<const T> values, T* out, Pairwise op) noexcept;
+
+	/**
+	 * @brief Writes the difference of every timestamp to its predecessor, in milliseconds, to \p out, where the
+	 * predecessor of the first timestamp is \p prev.
+	 *
+	 * @param out Receives `timepoints.size()` values.
+	 */
+	void deltas(
+			std::span<const std::chrono::milliseconds> timepoints, std::chrono::milliseconds prev, int64_t* out
+	) noexcept;
+} // namespace tirex::utils::simd
+
+#endif
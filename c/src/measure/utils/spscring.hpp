@@ -0,0 +1,76 @@
+#ifndef MEASURE_UTILS_SPSCRING_HPP
+#define MEASURE_UTILS_SPSCRING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace tirex::utils {
+	/**
+	 * @brief A bounded, lock-free ring buffer for exactly one producer and one consumer thread.
+	 * @details Neither side ever waits for the other: SPSCRing::push fails (and counts the value as dropped) if the
+	 * ring is full and SPSCRing::pop fails if it is empty. The head and tail indices live on separate cache lines such
+	 * that the producer and consumer do not invalidate each other's cache lines on every operation.
+	 *
+	 * @tparam T The type of the values. Should be cheap to copy.
+	 */
+	template <typename T>
+	class SPSCRing final {
+	private:
+		/** std::hardware_destructive_interference_size is not used since GCC warns that it is not ABI stable **/
+		static constexpr size_t cacheline = 64;
+		const size_t mask;
+		std::unique_ptr<T[]> buffer;
+		alignas(cacheline) std::atomic<size_t> head{0}; /**< The next index to write. Only written by the producer. **/
+		alignas(cacheline) std::atomic<size_t> tail{0}; /**< The next index to read. Only written by the consumer. **/
+		alignas(cacheline) std::atomic<size_t> numDropped{0};
+
+	public:
+		/**
+		 * @param capacity The number of values the ring can hold. It is rounded up to the next power of two.
+		 */
+		explicit SPSCRing(size_t capacity) : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1) {
+			buffer = std::make_unique<T[]>(mask + 1);
+		}
+		SPSCRing(const SPSCRing&) = delete;
+		SPSCRing& operator=(const SPSCRing&) = delete;
+
+		/**
+		 * @brief Appends \p value. May only be called by the producer.
+		 *
+		 * @return false if the ring was full, in which case \p value is dropped.
+		 */
+		bool push(const T& value) noexcept {
+			auto h = head.load(std::memory_order_relaxed);
+			if (h - tail.load(std::memory_order_acquire) > mask) {
+				numDropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			buffer[h & mask] = value;
+			head.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Removes the oldest value and writes it to \p value. May only be called by the consumer.
+		 *
+		 * @return false if the ring was empty.
+		 */
+		bool pop(T& value) noexcept {
+			auto t = tail.load(std::memory_order_relaxed);
+			if (t == head.load(std::memory_order_acquire))
+				return false;
+			value = buffer[t & mask];
+			tail.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		/** @brief The number of values that were dropped since the ring was full. */
+		size_t dropped() const noexcept { return numDropped.load(std::memory_order_relaxed); }
+		size_t capacity() const noexcept { return mask + 1; }
+	};
+} // namespace tirex::utils
+
+#endif
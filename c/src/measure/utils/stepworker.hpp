@@ -0,0 +1,156 @@
+#ifndef MEASURE_UTILS_STEPWORKER_HPP
+#define MEASURE_UTILS_STEPWORKER_HPP
+
+#include "histogram.hpp"
+#include "threadisolation.hpp"
+#include "threadusage.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace tirex::utils {
+	/**
+	 * @brief Runs a task on a dedicated thread whenever it is triggered.
+	 * @details StepWorker::trigger never waits for the task to run. If the task is still running (or was triggered but
+	 * did not start yet), the trigger is dropped and counted as an overrun instead. This way, a slow task never stalls
+	 * the thread that triggers it, nor does it queue up a burst of runs. The task receives the point in time that was
+	 * passed to StepWorker::trigger (e.g., the scheduler's tick), such that tasks that were triggered together can
+	 * agree on a timestamp.
+	 *
+	 * The worker also keeps track of what its task costs (see StepWorker::usage and StepWorker::latency), such that the
+	 * tracker can report its own overhead.
+	 */
+	class StepWorker final {
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/** @brief The resources spent by the task so far. */
+		struct Usage final {
+			/** @brief The CPU time (user and system) the task spent. **/
+			uint64_t cpuNs = 0;
+			/** @brief The reading and writing system calls the task issued (see SyscallCounter). **/
+			uint64_t syscalls = 0;
+		};
+
+	private:
+		std::function<void(clock::time_point)> task;
+		std::mutex mutex;
+		std::condition_variable cv;
+		bool pending = false;
+		clock::time_point tick; /**< The time point passed to the pending trigger. **/
+		bool running = false;
+		bool stopping = false;
+		size_t numOverruns = 0;
+		ThreadIsolation isolation;
+		bool reisolate; /**< Whether the isolation settings still need to be applied to the worker thread. **/
+		Usage totalUsage;
+		LogHistogram<> latencyNs;
+		std::thread thread;
+
+		void run() {
+			SyscallCounter syscalls; // Must be opened on the worker thread to count its system calls
+			std::unique_lock lock(mutex);
+			while (true) {
+				cv.wait(lock, [this] { return pending || stopping; });
+				if (stopping)
+					return;
+				pending = false;
+				running = true;
+				if (reisolate) {
+					// Failures are not reported here since the monitor thread applies (and reports) the same settings
+					isolation.apply();
+					reisolate = false;
+				}
+				auto triggered = tick;
+				lock.unlock();
+				auto startSyscalls = syscalls.read();
+				auto startCpu = threadCpuNs();
+				auto start = clock::now();
+				task(triggered);
+				auto elapsed = clock::now() - start;
+				auto cpu = threadCpuNs() - startCpu;
+				auto numSyscalls = syscalls.delta(startSyscalls, syscalls.read());
+				latencyNs.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+				lock.lock();
+				running = false;
+				totalUsage.cpuNs += cpu;
+				totalUsage.syscalls += numSyscalls;
+			}
+		}
+
+	public:
+		/**
+		 * @param task The task to run when triggered.
+		 * @param isolation The isolation settings to apply to the worker thread.
+		 */
+		explicit StepWorker(std::function<void(clock::time_point)> task, ThreadIsolation isolation = {})
+				: task(std::move(task)), isolation(std::move(isolation)), reisolate(!this->isolation.empty()),
+				  thread(&StepWorker::run, this) {}
+		StepWorker(const StepWorker&) = delete;
+		StepWorker& operator=(const StepWorker&) = delete;
+
+		/**
+		 * @brief Waits for a running task to finish and joins the worker thread. Pending triggers are discarded.
+		 */
+		~StepWorker() {
+			{
+				std::lock_guard lock(mutex);
+				stopping = true;
+			}
+			cv.notify_one();
+			thread.join();
+		}
+
+		/**
+		 * @brief Requests the task to be run on the worker thread.
+		 *
+		 * @param tick Passed to the task.
+		 * @return true if the task was scheduled and false if the request was dropped since the previous run did not
+		 * finish yet.
+		 */
+		bool trigger(clock::time_point tick = clock::now()) {
+			{
+				std::lock_guard lock(mutex);
+				if (pending || running) {
+					++numOverruns;
+					return false;
+				}
+				pending = true;
+				this->tick = tick;
+			}
+			cv.notify_one();
+			return true;
+		}
+
+		/**
+		 * @brief Changes the isolation settings of the worker thread. They are applied before the task runs next.
+		 */
+		void isolate(ThreadIsolation settings) {
+			std::lock_guard lock(mutex);
+			isolation = std::move(settings);
+			reisolate = true;
+		}
+
+		/** @brief The number of triggers that were dropped since the task was still busy. */
+		size_t overruns() {
+			std::lock_guard lock(mutex);
+			return numOverruns;
+		}
+
+		/** @brief The resources the task spent in all runs so far. */
+		Usage usage() {
+			std::lock_guard lock(mutex);
+			return totalUsage;
+		}
+
+		/** @brief The distribution of the (wall clock) time each run of the task took so far. */
+		LogHistogram<>::Snapshot latency() const noexcept { return latencyNs.snapshot(); }
+	};
+} // namespace tirex::utils
+
+#endif
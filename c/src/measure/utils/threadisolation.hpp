@@ -0,0 +1,109 @@
+#ifndef MEASURE_UTILS_THREADISOLATION_HPP
+#define MEASURE_UTILS_THREADISOLATION_HPP
+
+#include <tirex_tracker.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#elif _WIN32
+#define NOGDI // Otherwise we get problems with logging
+#include <windows.h>
+#endif
+
+namespace tirex::utils {
+	/**
+	 * @brief Describes how a thread is kept from interfering with the tracked workload, i.e., which cores it may run
+	 * on, how it is scheduled, and how precisely its timers fire.
+	 * @details The settings can only be applied by the thread itself (see ThreadIsolation::apply) since, e.g., the
+	 * timer slack can not be changed for other threads on Linux.
+	 */
+	struct ThreadIsolation final {
+		/** @brief The cores the thread may run on. If empty, the thread is not pinned. **/
+		std::vector<size_t> cpus;
+		tirexSchedPolicy policy = TIREX_SCHED_DEFAULT;
+		/** @brief The static priority to use with TIREX_SCHED_FIFO. **/
+		int priority = 0;
+		/** @brief By how much the kernel may delay the thread's timers to coalesce wakeups. Kept if not set. **/
+		std::optional<std::chrono::nanoseconds> timerSlack;
+
+		/** @brief Whether the settings do not change anything, i.e., the thread runs as any other. */
+		bool empty() const noexcept { return cpus.empty() && policy == TIREX_SCHED_DEFAULT && !timerSlack; }
+		bool operator==(const ThreadIsolation&) const = default;
+
+		/**
+		 * @brief Applies the settings to the calling thread.
+		 *
+		 * @return The names of the settings that could not be applied (e.g., since TIREX_SCHED_FIFO requires the
+		 * `CAP_SYS_NICE` capability or since the platform does not support them).
+		 */
+		std::vector<std::string> apply() const noexcept {
+			std::vector<std::string> failed;
+#if __linux__
+			if (!cpus.empty()) {
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				for (auto cpu : cpus)
+					CPU_SET(cpu, &set);
+				if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+					failed.emplace_back("cpus");
+			}
+			if (policy != TIREX_SCHED_DEFAULT) {
+				auto linuxPolicy = (policy == TIREX_SCHED_FIFO) ? SCHED_FIFO : SCHED_IDLE;
+				sched_param param{.sched_priority = (policy == TIREX_SCHED_FIFO) ? priority : 0};
+				if (pthread_setschedparam(pthread_self(), linuxPolicy, &param) != 0)
+					failed.emplace_back("policy");
+			}
+			if (timerSlack && prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(timerSlack->count())) != 0)
+				failed.emplace_back("timerSlackNs");
+#elif _WIN32
+			if (!cpus.empty()) {
+				DWORD_PTR mask = 0;
+				for (auto cpu : cpus)
+					mask |= (cpu < sizeof(mask) * 8) ? (DWORD_PTR{1} << cpu) : 0;
+				if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0)
+					failed.emplace_back("cpus");
+			}
+			if (policy != TIREX_SCHED_DEFAULT) {
+				auto prio = (policy == TIREX_SCHED_FIFO) ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_IDLE;
+				if (!SetThreadPriority(GetCurrentThread(), prio))
+					failed.emplace_back("policy");
+			}
+			if (timerSlack) // Windows does not offer per-thread timer slack
+				failed.emplace_back("timerSlackNs");
+#else
+			if (!cpus.empty())
+				failed.emplace_back("cpus");
+			if (policy != TIREX_SCHED_DEFAULT)
+				failed.emplace_back("policy");
+			if (timerSlack)
+				failed.emplace_back("timerSlackNs");
+#endif
+			return failed;
+		}
+
+		/**
+		 * @brief Describes the settings as a JSON object (e.g., to report them alongside the measurement).
+		 */
+		nlohmann::json toJson() const {
+			static constexpr const char* policyNames[]{"default", "idle", "fifo"};
+			auto json = nlohmann::json{{"cpus", cpus}, {"policy", policyNames[policy]}};
+			if (policy == TIREX_SCHED_FIFO)
+				json["priority"] = priority;
+			if (timerSlack)
+				json["timerSlackNs"] = timerSlack->count();
+			return json;
+		}
+	};
+} // namespace tirex::utils
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef MEASURE_UTILS_THREADUSAGE_HPP
+#define MEASURE_UTILS_THREADUSAGE_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if __linux__
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#elif __APPLE__
+#include <mach/mach.h>
+#elif _WIN32
+#define NOGDI // Otherwise we get problems with logging
+#include <windows.h>
+#endif
+
+namespace tirex::utils {
+	/**
+	 * @brief Reads the user and system CPU time that was spent by the calling thread in nanoseconds.
+	 */
+	inline void readThreadTimes(uint64_t& userNs, uint64_t& systemNs) noexcept {
+#if __linux__
+		struct rusage usage;
+		getrusage(RUSAGE_THREAD, &usage);
+		userNs = (usage.ru_utime.tv_sec * 1000000ull + usage.ru_utime.tv_usec) * 1000;
+		systemNs = (usage.ru_stime.tv_sec * 1000000ull + usage.ru_stime.tv_usec) * 1000;
+#elif __APPLE__
+		thread_basic_info_data_t info;
+		mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+		auto thread = mach_thread_self();
+		thread_info(thread, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>(&info), &count);
+		mach_port_deallocate(mach_task_self(), thread);
+		userNs = (info.user_time.seconds * 1000000ull + info.user_time.microseconds) * 1000;
+		systemNs = (info.system_time.seconds * 1000000ull + info.system_time.microseconds) * 1000;
+#elif _WIN32
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime);
+		// FILETIMEs are given in 100ns steps
+		userNs = ((static_cast<uint64_t>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime) * 100;
+		systemNs = ((static_cast<uint64_t>(kernelTime.dwHighDateTime) << 32) | kernelTime.dwLowDateTime) * 100;
+#else
+		userNs = systemNs = 0;
+#endif
+	}
+
+	/** @brief Returns the CPU time (user and system) that was spent by the calling thread in nanoseconds. */
+	inline uint64_t threadCpuNs() noexcept {
+		uint64_t userNs, systemNs;
+		readThreadTimes(userNs, systemNs);
+		return userNs + systemNs;
+	}
+
+	/**
+	 * @brief Counts the reading and writing system calls of the thread that constructed the counter.
+	 * @details Linux accounts these per thread in `/proc/thread-self/io` (`syscr` and `syscw`), which is the only
+	 * portable way to count system calls without tracing the thread. The file is kept open such that reading the
+	 * counter costs a single pread. Since that pread is itself counted, the difference of two reads is one too large
+	 * (see SyscallCounter::delta). Other platforms do not offer such a counter and always report 0.
+	 */
+	class SyscallCounter final {
+	public:
+#if __linux__
+		static constexpr bool supported = true;
+
+	private:
+		int fd = -1;
+
+	public:
+		SyscallCounter() noexcept : fd(open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC)) {}
+		SyscallCounter(const SyscallCounter&) = delete;
+		~SyscallCounter() {
+			if (fd >= 0)
+				close(fd);
+		}
+		SyscallCounter& operator=(const SyscallCounter&) = delete;
+
+		uint64_t read() const noexcept {
+			char buf[256];
+			auto len = (fd >= 0) ? pread(fd, buf, sizeof(buf) - 1, 0) : -1;
+			if (len <= 0)
+				return 0;
+			buf[len] = '\0';
+			uint64_t total = 0;
+			for (auto key : {"syscr:", "syscw:"}) {
+				if (auto pos = std::strstr(buf, key); pos != nullptr)
+					total += std::strtoull(pos + std::strlen(key), nullptr, 10);
+			}
+			return total;
+		}
+		uint64_t delta(uint64_t from, uint64_t to) const noexcept { return (to > from) ? to - from - 1 : 0; }
+#else
+		static constexpr bool supported = false;
+
+		uint64_t read() const noexcept { return 0; }
+		uint64_t delta(uint64_t, uint64_t) const noexcept { return 0; }
+#endif
+	};
+} // namespace tirex::utils
+
+#endif
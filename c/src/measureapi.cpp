@@ -1,70 +1,212 @@
 #include <tirex_tracker.h>
 
 #include "logging.hpp"
+#include "measure/samplestream.hpp"
+#include "measure/sampler.hpp"
 #include "measure/stats/provider.hpp"
 #include "measure/utils/rangeutils.hpp"
+#include "trackingconf.hpp"
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstring>
-#include <future>
+#include <filesystem>
 #include <iostream>
+#include <memory>
 #include <sstream>
-#include <thread>
+#include <string>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+/**
+ * @brief Converts \p stats into a JSON object that maps the (numeric) measures to their values.
+ */
+static nlohmann::json toJson(tirex::Stats&& stats) {
+	auto json = nlohmann::json::object();
+	for (auto& [measure, value] : stats) {
+		auto key = std::to_string(static_cast<int>(measure));
+		std::visit(
+				[&]<typename T>(T& val) {
+					if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, nlohmann::json>) {
+						json[key] = std::move(val);
+					} else if constexpr (requires { val.get().timeseries(); }) {
+						const auto& timeseries = val.get();
+						if (timeseries.size() > 0) {
+							json[key] = {
+									{"max", timeseries.maxValue()},
+									{"min", timeseries.minValue()},
+									{"avg", timeseries.avgValue()}
+							};
+							if (const auto* moments = timeseries.moments(); moments != nullptr && moments->duration > 0)
+								json[key]["variance"] = moments->variance();
+						}
+					}
+					// Temporary files are not reported since they would be deleted once the span's stats are gone
+				},
+				value
+		);
+	}
+	return json;
+}
+
 struct tirexMeasureHandle_st final {
-	size_t pollIntervalMs;
-	const std::vector<std::unique_ptr<tirex::StatsProvider>> providers;
-	std::thread monitorthread;
-	std::promise<void> signal;
+	/**
+	 * @brief A nested region of the measurement with its own windows on the measurement's providers.
+	 */
+	struct Span final {
+		std::string name;
+		std::vector<std::unique_ptr<tirex::Window>> windows; /**< The i-th window belongs to the i-th provider. **/
+		nlohmann::json children = nlohmann::json::array();
+	};
 
+	const std::set<tirexMeasure> measures;
+	const std::chrono::steady_clock::time_point starttime = std::chrono::steady_clock::now();
+	const std::shared_ptr<tirex::Sampler> sampler = tirex::Sampler::acquire();
+	tirex::Sampler::Subscription subscription{.epoch = starttime, .windows = {}};
+	std::unique_ptr<tirex::SampleLog> log; /**< Receives every sample if the tracking configuration set a log. **/
+	std::unique_ptr<tirex::SampleTable> table; /**< Receives every sample if the configuration set a table. **/
+	std::unique_ptr<tirex::SampleStream> stream;
+	size_t droppedSamples = 0; /**< The samples dropped by previous streams. **/
+	std::vector<Span> openSpans; /**< The spans that were begun but not ended yet (innermost last). **/
+	nlohmann::json spans = nlohmann::json::array(); /**< The ended top-level spans. **/
+
+	explicit tirexMeasureHandle_st(std::set<tirexMeasure> measures) noexcept : measures(std::move(measures)) {}
 	tirexMeasureHandle_st(tirexMeasureHandle_st& other) = delete;
 
-	explicit tirexMeasureHandle_st(
-			std::vector<std::unique_ptr<tirex::StatsProvider>>&& _providers, size_t pollIntervalMs
-	) noexcept
-			: pollIntervalMs(pollIntervalMs), providers(std::move(_providers)) {
-		// Start measuring
-		tirex::log::info("measure", "Start Measuring");
-		for (auto& provider : providers)
-			provider->start();
+	void setSampleCallback(tirexSampleCallback callback, void* userdata) {
+		if (stream != nullptr) {
+			for (auto& entry : subscription.windows)
+				entry.provider->attachSink(*entry.window, nullptr);
+			droppedSamples += stream->dropped();
+			stream.reset();
+		}
+		// The log is not affected since the windows append to it directly
+		if (callback != nullptr || table != nullptr) {
+			stream = std::make_unique<tirex::SampleStream>(
+					callback, userdata, table.get(), starttime, subscription.windows.size()
+			);
+			for (size_t i = 0; i < subscription.windows.size(); ++i)
+				subscription.windows[i].provider->attachSink(*subscription.windows[i].window, &stream->ring(i));
+		}
+	}
 
-		monitorthread = std::thread(tirexMeasureHandle_st::monitorThread, this);
+	/**
+	 * @brief Creates the sample log if \p conf requests one. This must be called before subscribing such that the
+	 * windows append every sample to the log from the start.
+	 */
+	void openLog(const tirexTrackingConf& conf) {
+		if (conf.sampleLog.empty())
+			return;
+		// The log stores wall-clock time such that the samples can be related to other logs later on
+		auto epoch = std::chrono::system_clock::now() -
+					 std::chrono::duration_cast<std::chrono::system_clock::duration>(
+							 std::chrono::steady_clock::now() - starttime
+					 );
+		log = tirex::SampleLog::create(conf.sampleLog, epoch);
+		if (log == nullptr) {
+			tirex::log::warn("measure", "Could not create the sample log {}", conf.sampleLog.string());
+			tirex::abort(tirexLogLevel::WARN, "The sample log could not be created");
+		}
+		subscription.log = log.get();
 	}
 
-	tirex::Stats stop() {
-		signal.set_value();
-		monitorthread.join();
+	/**
+	 * @brief Creates the sample table if \p conf requests one and starts streaming samples to it.
+	 */
+	void openTable(const tirexTrackingConf& conf) {
+		if (!conf.sampleTable.empty()) {
+			std::vector<tirexMeasure> columns;
+			for (auto& entry : subscription.windows) {
+				for (auto measure : entry.window->sampledMeasures())
+					columns.push_back(measure);
+			}
+			table = tirex::SampleTable::create(conf.sampleTable, columns, subscription.windows.size());
+			if (table == nullptr) {
+				tirex::log::warn("measure", "Could not create the sample table {}", conf.sampleTable.string());
+				tirex::abort(tirexLogLevel::WARN, "The sample table could not be created");
+			}
+		}
+		if (table != nullptr)
+			setSampleCallback(nullptr, nullptr);
+	}
+
+	void beginSpan(std::string name) {
+		Span span{.name = std::move(name)};
+		// Spans only report aggregates such that they stay cheap even if there are many of them
+		for (auto& entry : subscription.windows)
+			span.windows.emplace_back(entry.provider->openWindow(measures, starttime, false));
+		openSpans.emplace_back(std::move(span));
+	}
+
+	void endSpan() {
+		auto span = std::move(openSpans.back());
+		openSpans.pop_back();
+		tirex::Stats stats{};
+		for (size_t i = 0; i < span.windows.size(); ++i) {
+			subscription.windows[i].provider->closeWindow(*span.windows[i]);
+			stats.merge(span.windows[i]->getStats());
+		}
+		auto& parent = openSpans.empty() ? spans : openSpans.back().children;
+		parent.push_back(
+				{{"name", std::move(span.name)},
+				 {"measures", toJson(std::move(stats))},
+				 {"children", std::move(span.children)}}
+		);
+	}
 
-		// Stop measuring
-		// Uncomment once range support can be assumed
-		// for (auto& provider : providers | std::views::reverse)
-		//	provider->stop();
-		for (auto it = providers.rbegin(); it != providers.rend(); ++it)
-			(*it)->stop();
+	tirex::Stats stop() {
+		if (!openSpans.empty()) {
+			tirex::log::warn("measure", "{} spans were not ended before the measurement was stopped", openSpans.size());
+			while (!openSpans.empty())
+				endSpan();
+		}
+		sampler->unsubscribe(subscription);
+		if (stream != nullptr) {
+			droppedSamples += stream->dropped();
+			stream.reset(); // The windows are closed, so nothing is pushed to the stream anymore
+		}
+		log.reset(); // Nor appended to the log
+		table.reset();
 
 		// Collect statistics and print them
 		tirex::Stats stats{};
-		for (auto& provider : providers)
-			stats.merge(std::move(provider->getStats()));
+		for (auto& entry : subscription.windows)
+			stats.merge(std::move(entry.window->getStats()));
+		if (measures.contains(TIREX_TRACKER_DROPPED_SAMPLES))
+			stats.insert_or_assign(TIREX_TRACKER_DROPPED_SAMPLES, std::to_string(droppedSamples));
+		if (measures.contains(TIREX_TRACKER_SPANS))
+			stats.insert_or_assign(TIREX_TRACKER_SPANS, std::move(spans));
+		if (measures.contains(TIREX_TRACKER_MEMORY_KB)) {
+			size_t bytes = 0;
+			for (auto& entry : subscription.windows)
+				bytes += entry.window->memoryUsage();
+			stats.insert_or_assign(TIREX_TRACKER_MEMORY_KB, std::to_string((bytes + 1023) / 1024));
+		}
+		if (measures.contains(TIREX_TRACKER_ISOLATION))
+			stats.insert_or_assign(TIREX_TRACKER_ISOLATION, sampler->isolationInfo());
 		return stats;
 	}
 
-	static void monitorThread(tirexMeasureHandle_st* self) {
-		auto future = self->signal.get_future();
-		std::chrono::milliseconds intervall{self->pollIntervalMs};
-		do {
-			for (auto& provider : self->providers)
-				provider->step();
-		} while (future.wait_for(intervall) != std::future_status::ready);
+	tirex::Stats peek() const {
+		tirex::Stats stats{};
+		for (auto& entry : subscription.windows)
+			stats.merge(entry.window->peekStats());
+		if (measures.contains(TIREX_TRACKER_DROPPED_SAMPLES)) {
+			auto dropped = droppedSamples + ((stream != nullptr) ? stream->dropped() : 0);
+			stats.insert_or_assign(TIREX_TRACKER_DROPPED_SAMPLES, std::to_string(dropped));
+		}
+		if (measures.contains(TIREX_TRACKER_ISOLATION))
+			stats.insert_or_assign(TIREX_TRACKER_ISOLATION, sampler->isolationInfo());
+		return stats;
 	}
 };
 
-static tirexError
-initProviders(const tirexMeasureConf* measures, std::vector<std::unique_ptr<tirex::StatsProvider>>& providers) {
+static std::set<tirexMeasure> collectMeasures(const tirexMeasureConf* measures) {
 	std::set<tirexMeasure> tirexset;
 	for (auto conf = measures; conf->source != tirexMeasure::TIREX_MEASURE_INVALID; ++conf) {
-		auto [it, inserted] = tirexset.insert(conf->source); /** \todo implement conf->aggregate support **/
+		auto [it, inserted] = tirexset.insert(conf->source);
 		if (!inserted) {
 			tirex::log::warn(
 					"tracker", "The measure {} was requested more than once", static_cast<signed>(conf->source)
@@ -72,31 +214,196 @@ initProviders(const tirexMeasureConf* measures, std::vector<std::unique_ptr<tire
 			tirex::abort(tirexLogLevel::WARN, "A measure was requested multiple times");
 		}
 	}
-	auto unmatched = tirex::initProviders(tirexset, providers);
+	return tirexset;
+}
+
+/**
+ * @brief Returns a copy of \p conf (or the default configuration if it is NULL) that additionally holds the
+ * aggregations requested by \p measures (see tirexMeasureConf::aggregate).
+ */
+static tirexTrackingConf withAggregates(const tirexMeasureConf* measures, const tirexTrackingConf* conf) {
+	auto result = (conf != nullptr) ? *conf : tirexTrackingConf{};
+	for (auto measure = measures; measure->source != tirexMeasure::TIREX_MEASURE_INVALID; ++measure) {
+		switch (measure->aggregate) {
+		case TIREX_AGG_MAX:
+		case TIREX_AGG_MIN:
+		case TIREX_AGG_MEAN:
+			result.series[measure->source].aggregate = measure->aggregate;
+			break;
+		default: // Keeps the default aggregation
+			break;
+		}
+	}
+	return result;
+}
+
+static void checkUnmatched(const std::set<tirexMeasure>& unmatched) {
 	if (!unmatched.empty()) {
 		tirex::log::warn("tracker", "Not all requested measures are associated with a data provider");
 		tirex::log::warn("tracker", "Unmatched: {}", tirex::utils::join(unmatched));
 		tirex::abort(tirexLogLevel::WARN, "An unsupported measure was requested");
 	}
+}
+
+struct tirexContext_st final {
+	const std::set<tirexMeasure> measures;
+	const tirexTrackingConf conf;
+	const std::shared_ptr<tirex::Sampler> sampler = tirex::Sampler::acquire();
+	/** @brief Keeps the context's providers running until the context is freed. **/
+	tirex::Sampler::Subscription retained;
+	tirex::Stats info;
+
+	tirexContext_st(std::set<tirexMeasure> measures, tirexTrackingConf conf)
+			: measures(std::move(measures)), conf(std::move(conf)) {}
+	tirexContext_st(const tirexContext_st&) = delete;
+	~tirexContext_st() { sampler->unsubscribe(retained); }
+};
+
+/**
+ * @brief Copies the cached \p info such that the copy can be handed out as a result. Temporary files are copied as
+ * well since the result deletes them once it is freed.
+ */
+static tirex::Stats copyInfo(const tirex::Stats& info) {
+	static std::atomic<size_t> numCopies{0};
+	tirex::Stats copy{};
+	for (const auto& [measure, value] : info) {
+		std::visit(
+				[&]<typename T>(const T& val) {
+					if constexpr (std::is_same_v<T, tirex::TmpFile>) {
+						std::filesystem::path path{val.path.string() + "-" + std::to_string(++numCopies)};
+						std::filesystem::copy_file(val.path, path, std::filesystem::copy_options::overwrite_existing);
+						copy.insert_or_assign(measure, tirex::TmpFile{std::move(path)});
+					} else {
+						copy.insert_or_assign(measure, val);
+					}
+				},
+				value
+		);
+	}
+	return copy;
+}
+
+static tirexError startTracking(
+		std::set<tirexMeasure> measures, const tirexTrackingConf& conf, tirexMeasureHandle** handle
+) {
+	tirex::log::info("measure", "Start Measuring");
+	auto measure = new tirexMeasureHandle{std::move(measures)};
+	measure->openLog(conf);
+	checkUnmatched(measure->sampler->subscribe(measure->measures, conf, measure->subscription));
+	measure->openTable(conf);
+	*handle = measure;
 	return TIREX_SUCCESS;
 }
 
+static std::vector<tirex::StatsProvider*> pointersOf(const tirex::ProviderList& providers) {
+	std::vector<tirex::StatsProvider*> pointers;
+	for (auto& [_, provider] : providers)
+		pointers.push_back(provider.get());
+	return pointers;
+}
+
 tirexError tirexFetchInfo(const tirexMeasureConf* measures, tirexResult** result) {
-	std::vector<std::unique_ptr<tirex::StatsProvider>> providers;
-	if (tirexError err; (err = initProviders(measures, providers)) != TIREX_SUCCESS)
-		return err;
-	tirex::Stats stats{};
-	for (auto& provider : providers)
-		stats.merge(provider->getInfo());
-	*result = createMsrResultFromStats(std::move(stats));
+	auto requested = collectMeasures(measures);
+	tirex::ProviderList providers;
+	checkUnmatched(tirex::initProviders(requested, providers));
+	*result = createMsrResultFromStats(tirex::collectInfo(pointersOf(providers), requested));
 	return TIREX_SUCCESS;
 }
 
 tirexError tirexStartTracking(const tirexMeasureConf* measures, size_t pollIntervalMs, tirexMeasureHandle** handle) {
-	std::vector<std::unique_ptr<tirex::StatsProvider>> providers;
-	if (tirexError err; (err = initProviders(measures, providers)) != TIREX_SUCCESS)
-		return err;
-	*handle = new tirexMeasureHandle{std::move(providers), pollIntervalMs};
+	return tirexStartTrackingUs(measures, pollIntervalMs * 1000, handle);
+}
+
+tirexError tirexStartTrackingUs(const tirexMeasureConf* measures, size_t pollIntervalUs, tirexMeasureHandle** handle) {
+	tirexTrackingConf conf{.pollInterval = std::chrono::microseconds{pollIntervalUs}};
+	return tirexStartTrackingWithConf(measures, &conf, handle);
+}
+
+tirexError tirexStartTrackingWithConf(
+		const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexMeasureHandle** handle
+) {
+	return startTracking(collectMeasures(measures), withAggregates(measures, conf), handle);
+}
+
+tirexError tirexStartTrackingWithInfo(
+		const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexResult** info, tirexMeasureHandle** handle
+) {
+	if (measures == nullptr || info == nullptr || handle == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	auto requested = collectMeasures(measures);
+	tirex::ProviderList providers;
+	tirex::initProviders(requested, providers); // Unmatched measures are reported when the measurement is started
+	// The information is collected before the sampler starts stepping the providers since getInfo may not run alongside
+	// step()
+	*info = createMsrResultFromStats(tirex::collectInfo(pointersOf(providers), requested));
+
+	// Hand the providers to the sampler such that the measurement does not initialize them again
+	auto sampler = tirex::Sampler::acquire();
+	tirex::Sampler::Subscription adopted;
+	sampler->retain(std::move(providers), adopted);
+	auto err = startTracking(requested, withAggregates(measures, conf), handle);
+	sampler->unsubscribe(adopted); // The measurement keeps the providers it needs running
+	return err;
+}
+
+tirexError tirexContextCreate(const tirexMeasureConf* measures, const tirexTrackingConf* conf, tirexContext** context) {
+	if (measures == nullptr || context == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	auto ctx = new tirexContext{collectMeasures(measures), withAggregates(measures, conf)};
+	tirex::ProviderList providers;
+	checkUnmatched(tirex::initProviders(ctx->measures, providers));
+	ctx->info = tirex::collectInfo(pointersOf(providers), ctx->measures);
+	ctx->sampler->retain(std::move(providers), ctx->retained);
+	*context = ctx;
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexContextFetchInfo(const tirexContext* context, tirexResult** result) {
+	if (context == nullptr || result == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	*result = createMsrResultFromStats(copyInfo(context->info));
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexContextStartTracking(const tirexContext* context, tirexMeasureHandle** handle) {
+	if (context == nullptr || handle == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	return startTracking(context->measures, context->conf, handle);
+}
+
+void tirexContextFree(tirexContext* context) { delete context; }
+
+tirexError tirexPeekTracking(const tirexMeasureHandle* measure, tirexResult** result) {
+	if (measure == nullptr || result == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	*result = createMsrResultFromStats(measure->peek());
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexSetSampleCallback(tirexMeasureHandle* measure, tirexSampleCallback callback, void* userdata) {
+	if (measure == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	measure->setSampleCallback(callback, userdata);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexSampleLogReplay(const char* path, tirexSampleCallback callback, void* userdata) {
+	if (path == nullptr || callback == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	return tirex::SampleLog::replay(path, callback, userdata) ? TIREX_SUCCESS : TIREX_INVALID_ARGUMENT;
+}
+
+tirexError tirexSpanBegin(tirexMeasureHandle* measure, const char* name) {
+	if (measure == nullptr || name == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	measure->beginSpan(name);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexSpanEnd(tirexMeasureHandle* measure) {
+	if (measure == nullptr || measure->openSpans.empty())
+		return TIREX_INVALID_ARGUMENT;
+	measure->endSpan();
 	return TIREX_SUCCESS;
 }
 
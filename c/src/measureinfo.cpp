@@ -248,8 +248,62 @@ static const tirexMeasureInfo measureInfos[]{
 		/*[TIREX_CPU_TEMPERATURE_CELSIUS] = */
 		{.description = "The CPU package temperature in degree Celsius tracked over the measured period.",
 		 .datatype = tirexResultType::TIREX_STRING,
-		 .example = "{\"max\": 62, \"min\": 48, \"avg\": 55, \"timeseries\": {\"timestamps\": [\"108ms\"], \"values\": "
-					"[55]}}"}
+		 .example = "{\"max\": 62.5, \"min\": 48, \"avg\": 55.125, \"timeseries\": {\"timestamps\": [\"108ms\"], "
+					"\"values\": [55.125]}}"},
+		/*[TIREX_TRACKER_JITTER_US] = */
+		{.description = "How late (in microseconds) the tracker's monitor thread woke up with respect to its sampling "
+						"deadlines. Large values indicate that the sampled timeseries are not equidistant.",
+		 .datatype = tirexResultType::TIREX_STRING,
+		 .example = "{\"max\": 412, \"min\": 51, \"avg\": 87, \"timeseries\": {\"timestamps\": [\"100ms\"], \"values\": "
+					"[87]}}"},
+		/*[TIREX_TRACKER_MISSED_DEADLINES] = */
+		{.description = "The number of sampling deadlines that the tracker's monitor thread skipped because it overran "
+						"them (e.g., since collecting the measures took longer than the poll interval).",
+		 .datatype = tirexResultType::TIREX_INTEGER,
+		 .example = "0"},
+		/*[TIREX_TRACKER_STEP_OVERRUNS] = */
+		{.description = "The number of steps per data provider that were dropped since the provider was still busy "
+						"taking its previous sample (e.g., because of a blocking driver call).",
+		 .datatype = tirexResultType::TIREX_STRING,
+		 .example = "{\"gpu\": 3, \"system\": 0}"},
+		/*[TIREX_TRACKER_DROPPED_SAMPLES] = */
+		{.description = "The number of samples that were dropped instead of being passed to the sample callback since "
+						"the callback did not keep up with the sampling.",
+		 .datatype = tirexResultType::TIREX_INTEGER,
+		 .example = "0"},
+		/*[TIREX_TRACKER_SPANS] = */
+		{.description = "The tree of spans that were recorded via tirexSpanBegin and tirexSpanEnd, each with the "
+						"measures (keyed by their numeric value) that were collected within the span.",
+		 .datatype = tirexResultType::TIREX_STRING,
+		 .example = "[{\"name\": \"retrieve\", \"measures\": {\"3\": \"5123\"}, \"children\": []}]"},
+		/*[TIREX_TRACKER_CPU_TIME_US] = */
+		{.description = "The CPU time (user and system, in microseconds) that the tracker's own threads (the monitor "
+						"thread and the threads polling the data providers) spent during the measurement.",
+		 .datatype = tirexResultType::TIREX_INTEGER,
+		 .example = "1830"},
+		/*[TIREX_TRACKER_STEP_LATENCY_US] = */
+		{.description = "The distribution of the time (in microseconds) each data provider took to take a sample, as "
+						"the count, mean, min, max, and quantiles per provider.",
+		 .datatype = tirexResultType::TIREX_STRING,
+		 .example = "{\"system\": {\"count\": 50, \"mean\": 61.2, \"min\": 48.0, \"max\": 140.0, \"p50\": 59.5, "
+					"\"p90\": 71.5, \"p99\": 140.0}}"},
+		/*[TIREX_TRACKER_SYSCALLS_PER_TICK] = */
+		{.description = "The average number of reading and writing system calls (as accounted in /proc/thread-self/io) "
+						"that the data providers issued per sampling tick. Only available on Linux.",
+		 .datatype = tirexResultType::TIREX_FLOATING,
+		 .example = "14.5"},
+		/*[TIREX_TRACKER_MEMORY_KB] = */
+		{.description = "The memory (in KiB) that the tracker held for the samples of the measurement (i.e., its time "
+						"series) when it was stopped.",
+		 .datatype = tirexResultType::TIREX_INTEGER,
+		 .example = "12"},
+		/*[TIREX_TRACKER_ISOLATION] = */
+		{.description = "The isolation settings (cores, scheduling policy, and timer slack) of the tracker's threads "
+						"that were in effect during the measurement, together with the settings that could not be "
+						"applied.",
+		 .datatype = tirexResultType::TIREX_STRING,
+		 .example = "{\"cpus\": [0, 1], \"policy\": \"fifo\", \"priority\": 10, \"timerSlackNs\": 1000, "
+					"\"failed\": []}"}
 };
 static_assert((sizeof(measureInfos) / sizeof(*measureInfos)) == TIREX_MEASURE_COUNT);
 
@@ -25,16 +25,20 @@ overloaded(Ts...) -> overloaded<Ts...>;
 struct tirexResult_st {
 public:
 	using ValueType = std::vector<std::pair<tirexMeasure, std::variant<std::string, tirex::TmpFile>>>;
+
+private:
 	ValueType value;
 
 public:
 	explicit tirexResult_st(ValueType&& val) : value(std::move(val)) {}
+
+	const ValueType& entries() const { return value; }
 };
 
 tirexError tirexResultEntryGetByIndex(const tirexResult* result, size_t index, tirexResultEntry* entry) {
-	if (result == nullptr || index >= result->value.size())
+	if (result == nullptr || index >= result->entries().size())
 		return tirexError::TIREX_INVALID_ARGUMENT;
-	const auto& [source, value] = result->value.at(index);
+	const auto& [source, value] = result->entries().at(index);
 	std::visit(
 			overloaded{
 					[&](const std::string& str) {
@@ -60,7 +64,7 @@ tirexError tirexResultEntryGetByIndex(const tirexResult* result, size_t index, t
 tirexError tirexResultEntryNum(const tirexResult* result, size_t* num) {
 	if (result == nullptr)
 		return tirexError::TIREX_INVALID_ARGUMENT;
-	*num = result->value.size();
+	*num = result->entries().size();
 	return tirexError::TIREX_SUCCESS;
 }
 
@@ -68,16 +72,25 @@ void tirexResultFree(tirexResult* result) { delete result; }
 
 template <typename T>
 static std::string toYAML(const tirex::TimeSeries<T>& timeseries) {
-	const auto& [timestamps, values] = timeseries.timeseries();
-	static_assert(std::is_same_v<decltype(timestamps), const std::vector<std::chrono::milliseconds>&>);
+	const auto& [timestamps, values] = tirex::ts::downsample(timeseries.timeseries(), tirex::maxExportedPoints);
+	static_assert(std::is_same_v<std::remove_cvref_t<decltype(timestamps)>, std::vector<std::chrono::milliseconds>>);
+	std::string quantiles;
+	if (const auto* sketch = timeseries.sketch(); sketch != nullptr && sketch->count() > 0)
+		quantiles = _fmt::format(
+				"\"p50\": {}, \"p90\": {}, \"p99\": {}, ", sketch->quantile(0.5), sketch->quantile(0.9),
+				sketch->quantile(0.99)
+		);
+	std::string variance;
+	if (const auto* moments = timeseries.moments(); moments != nullptr && moments->duration > 0)
+		variance = _fmt::format("\"variance\": {}, ", moments->variance());
 	return _fmt::format(
-			"{{\"max\": {}, \"min\": {}, \"avg\": {}, \"timeseries\": {{\"timestamps\": [\"{}\"], \"values\": [{}]}}}}",
-			timeseries.maxValue(), timeseries.minValue(), timeseries.avgValue(),
+			"{{\"max\": {}, \"min\": {}, \"avg\": {}, {}{}\"timeseries\": {{\"timestamps\": [\"{}\"], \"values\": [{}]}}}}",
+			timeseries.maxValue(), timeseries.minValue(), timeseries.avgValue(), variance, quantiles,
 			tirex::utils::join(timestamps, "\", \""), tirex::utils::join(values, ", ")
 	);
 }
 
-extern tirexResult_st* tirex::createMsrResultFromStats(tirex::Stats&& stats) {
+static tirexResult_st::ValueType toResultValue(tirex::Stats&& stats) {
 	tirexResult_st::ValueType result;
 	for (auto it = std::make_move_iterator(stats.begin()), end = std::make_move_iterator(stats.end()); it != end;
 		 ++it) {
@@ -85,13 +98,17 @@ extern tirexResult_st* tirex::createMsrResultFromStats(tirex::Stats&& stats) {
 				overloaded{
 						[&](const std::string& str) { result.emplace_back((*it).first, std::move(str)); },
 						[&](tirex::TmpFile&& file) { result.emplace_back((*it).first, std::move(file)); },
-						[&](const tirex::TimeSeries<unsigned>& timeseries) {
-							result.emplace_back((*it).first, toYAML(timeseries));
+						[&]<typename T>(tirex::SeriesRef<T> timeseries) {
+							result.emplace_back((*it).first, toYAML(timeseries.get()));
 						},
 						[&](const nlohmann::json& json) { result.emplace_back(it->first, std::move(json.dump())); }
 				},
 				std::move((*it).second)
 		);
 	}
-	return new tirexResult_st(std::move(result));
-}
\ No newline at end of file
+	return result;
+}
+
+extern tirexResult_st* tirex::createMsrResultFromStats(tirex::Stats&& stats) {
+	return new tirexResult_st(toResultValue(std::move(stats)));
+}
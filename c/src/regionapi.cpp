@@ -0,0 +1,53 @@
+#include <tirex_tracker.h>
+
+#include "abort.hpp"
+#include "logging.hpp"
+#include "measure/region.hpp"
+#include "measure/utils/rangeutils.hpp"
+
+#include <set>
+
+struct tirexRegion_st final {
+	tirex::Region region;
+
+	explicit tirexRegion_st(std::set<tirexMeasure> measures) : region(std::move(measures)) {}
+};
+
+tirexError tirexRegionCreate(const tirexMeasureConf* measures, tirexRegion** region) {
+	if (measures == nullptr || region == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	std::set<tirexMeasure> requested;
+	std::set<tirexMeasure> unsupported;
+	for (auto conf = measures; conf->source != tirexMeasure::TIREX_MEASURE_INVALID; ++conf)
+		(tirex::Region::supportedMeasures.contains(conf->source) ? requested : unsupported).insert(conf->source);
+	if (!unsupported.empty()) {
+		tirex::log::warn("region", "Regions only support elapsed time and CPU energy measures");
+		tirex::log::warn("region", "Unsupported: {}", tirex::utils::join(unsupported));
+		tirex::abort(tirexLogLevel::WARN, "An unsupported measure was requested for a region");
+	}
+	*region = new tirexRegion{std::move(requested)};
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexRegionEnter(const tirexRegion* region, tirexRegionScope* scope) {
+	if (region == nullptr || scope == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	region->region.enter(*scope);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexRegionExit(tirexRegion* region, const tirexRegionScope* scope) {
+	if (region == nullptr || scope == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	region->region.exit(*scope);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexRegionGetResult(const tirexRegion* region, tirexResult** result) {
+	if (region == nullptr || result == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	*result = createMsrResultFromStats(region->region.getStats());
+	return TIREX_SUCCESS;
+}
+
+void tirexRegionFree(tirexRegion* region) { delete region; }
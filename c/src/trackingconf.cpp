@@ -0,0 +1,150 @@
+#include "trackingconf.hpp"
+
+#include "logging.hpp"
+#include "measure/stats/provider.hpp"
+
+tirexError tirexTrackingConfCreate(tirexTrackingConf** conf) {
+	if (conf == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	*conf = new tirexTrackingConf{};
+	return TIREX_SUCCESS;
+}
+
+void tirexTrackingConfFree(tirexTrackingConf* conf) { delete conf; }
+
+tirexError tirexTrackingConfSetPollInterval(tirexTrackingConf* conf, size_t pollIntervalUs) {
+	if (conf == nullptr || pollIntervalUs == 0)
+		return TIREX_INVALID_ARGUMENT;
+	conf->pollInterval = std::chrono::microseconds{pollIntervalUs};
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetProviderInterval(tirexTrackingConf* conf, const char* provider, size_t pollIntervalUs) {
+	if (conf == nullptr || provider == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	if (!tirex::providers.contains(provider)) {
+		tirex::log::warn("tracker", "Can not set the poll interval of the unknown provider {}", provider);
+		return TIREX_INVALID_ARGUMENT;
+	}
+	conf->providerIntervals.insert_or_assign(provider, std::chrono::microseconds{pollIntervalUs});
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetCpuAffinity(tirexTrackingConf* conf, const size_t* cpus, size_t numCpus) {
+	if (conf == nullptr || (cpus == nullptr && numCpus > 0))
+		return TIREX_INVALID_ARGUMENT;
+#if __linux__
+	for (size_t i = 0; i < numCpus; ++i) {
+		if (cpus[i] >= CPU_SETSIZE) {
+			tirex::log::warn("tracker", "Can not pin the tracker to core {} since it exceeds CPU_SETSIZE", cpus[i]);
+			return TIREX_INVALID_ARGUMENT;
+		}
+	}
+#endif
+	conf->isolation.cpus.assign(cpus, cpus + numCpus);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetSchedPolicy(tirexTrackingConf* conf, tirexSchedPolicy policy, int priority) {
+	if (conf == nullptr || policy < TIREX_SCHED_DEFAULT || policy > TIREX_SCHED_FIFO)
+		return TIREX_INVALID_ARGUMENT;
+#if __linux__
+	auto minPriority = sched_get_priority_min(SCHED_FIFO), maxPriority = sched_get_priority_max(SCHED_FIFO);
+	auto valid = (policy == TIREX_SCHED_FIFO) ? (priority >= minPriority && priority <= maxPriority) : priority == 0;
+#else
+	auto valid = (policy == TIREX_SCHED_FIFO) || priority == 0;
+#endif
+	if (!valid) {
+		tirex::log::warn("tracker", "The priority {} is not valid for the requested scheduling policy", priority);
+		return TIREX_INVALID_ARGUMENT;
+	}
+	conf->isolation.policy = policy;
+	conf->isolation.priority = priority;
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetTimerSlack(tirexTrackingConf* conf, size_t timerSlackNs) {
+	if (conf == nullptr || timerSlackNs == 0)
+		return TIREX_INVALID_ARGUMENT;
+	conf->isolation.timerSlack = std::chrono::nanoseconds{timerSlackNs};
+	return TIREX_SUCCESS;
+}
+
+tirexError
+tirexTrackingConfSetAdaptive(tirexTrackingConf* conf, size_t minIntervalUs, size_t maxIntervalUs, double tolerance) {
+	if (conf == nullptr || minIntervalUs == 0 || maxIntervalUs < minIntervalUs || !(tolerance >= 0))
+		return TIREX_INVALID_ARGUMENT;
+	auto triggers = conf->adaptive ? std::move(conf->adaptive->triggers) : decltype(conf->adaptive->triggers){};
+	conf->adaptive = tirex::utils::AdaptiveRate::Config{
+			.minInterval = std::chrono::microseconds{minIntervalUs},
+			.maxInterval = std::chrono::microseconds{maxIntervalUs},
+			.tolerance = tolerance,
+			.triggers = std::move(triggers)
+	};
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfAddTrigger(
+		tirexTrackingConf* conf, tirexMeasure measure, tirexTriggerCondition condition, double threshold, size_t holdUs
+) {
+	if (conf == nullptr || measure < 0 || measure >= TIREX_MEASURE_COUNT || condition < TIREX_TRIGGER_ABOVE ||
+		condition > TIREX_TRIGGER_RISE)
+		return TIREX_INVALID_ARGUMENT;
+	if (!conf->adaptive) {
+		tirex::log::warn("tracker", "Triggers require adaptive sampling, call tirexTrackingConfSetAdaptive first");
+		return TIREX_INVALID_ARGUMENT;
+	}
+	conf->adaptive->triggers.push_back(
+			{.measure = measure,
+			 .condition = condition,
+			 .threshold = threshold,
+			 .hold = std::chrono::microseconds{holdUs}}
+	);
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetSampleLog(tirexTrackingConf* conf, const char* path) {
+	if (conf == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	conf->sampleLog = (path != nullptr) ? std::filesystem::path{path} : std::filesystem::path{};
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetSampleTable(tirexTrackingConf* conf, const char* path) {
+	if (conf == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	conf->sampleTable = (path != nullptr) ? std::filesystem::path{path} : std::filesystem::path{};
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetSeries(
+		tirexTrackingConf* conf, tirexMeasure measure, size_t batchIntervalMs, size_t maxPoints,
+		tirexSeriesStorage storage
+) {
+	if (conf == nullptr || measure < 0 || measure >= TIREX_MEASURE_COUNT || storage < TIREX_SERIES_COMPRESSED ||
+		storage > TIREX_SERIES_NONE)
+		return TIREX_INVALID_ARGUMENT;
+	if (maxPoints < 8) {
+		tirex::log::warn("tracker", "A time series must keep at least 8 points but {} were requested", maxPoints);
+		return TIREX_INVALID_ARGUMENT;
+	}
+	auto& series = conf->series[measure];
+	series.batchInterval = std::chrono::milliseconds{batchIntervalMs};
+	series.maxPoints = maxPoints;
+	series.storage = storage;
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetSeriesPriority(tirexTrackingConf* conf, tirexMeasure measure, unsigned priority) {
+	if (conf == nullptr || measure < 0 || measure >= TIREX_MEASURE_COUNT)
+		return TIREX_INVALID_ARGUMENT;
+	conf->series[measure].priority = priority;
+	return TIREX_SUCCESS;
+}
+
+tirexError tirexTrackingConfSetMemoryBudget(tirexTrackingConf* conf, size_t maxBytes) {
+	if (conf == nullptr)
+		return TIREX_INVALID_ARGUMENT;
+	conf->memoryBudget = maxBytes;
+	return TIREX_SUCCESS;
+}
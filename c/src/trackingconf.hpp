@@ -0,0 +1,53 @@
+#ifndef TRACKINGCONF_HPP
+#define TRACKINGCONF_HPP
+
+#include <tirex_tracker.h>
+
+#include "measure/stats/provider.hpp"
+#include "measure/utils/adaptiverate.hpp"
+#include "measure/utils/threadisolation.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Holds the configuration of how a measurement is carried out (as opposed to what is measured, which is
+ * configured via tirexMeasureConf).
+ */
+struct tirexTrackingConf_st final {
+	/** @brief The poll interval of all providers that do not have an individual interval. **/
+	std::chrono::microseconds pollInterval{std::chrono::milliseconds{100}};
+	/** @brief Individual poll intervals by provider name (as listed in tirex::providers). **/
+	std::map<std::string, std::chrono::microseconds, std::less<>> providerIntervals;
+	/** @brief How the tracker's threads are kept from interfering with the workload. **/
+	tirex::utils::ThreadIsolation isolation;
+	/** @brief How the poll intervals adapt to the samples (see tirexTrackingConfSetAdaptive). Fixed if not set. **/
+	std::optional<tirex::utils::AdaptiveRate::Config> adaptive;
+	/** @brief The file that every sample is written to (see tirexTrackingConfSetSampleLog). None if empty. **/
+	std::filesystem::path sampleLog;
+	/** @brief The file that the row-aligned samples are written to (see tirexTrackingConfSetSampleTable). **/
+	std::filesystem::path sampleTable;
+	/**
+	 * @brief How the time series of individual measures are recorded (see tirexTrackingConfSetSeries), including the
+	 * aggregations requested via tirexMeasureConf.
+	 */
+	tirex::SeriesConfs series;
+	/** @brief The bytes that a measurement's time series may take (see tirexTrackingConfSetMemoryBudget). **/
+	size_t memoryBudget = 0;
+
+	/**
+	 * @brief Returns the poll interval that should be used for the provider with the given name.
+	 */
+	std::chrono::microseconds intervalFor(std::string_view provider) const {
+		if (auto it = providerIntervals.find(provider); it != providerIntervals.end())
+			return it->second;
+		return pollInterval;
+	}
+};
+
+#endif
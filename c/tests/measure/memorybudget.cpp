@@ -0,0 +1,49 @@
+#include <measure/memorybudget.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using tirex::MemoryBudget;
+
+TEST_CASE("MemoryBudget", "[Priority]") {
+	MemoryBudget budget(1000);
+	auto& low = budget.add(0);
+	auto& large = budget.add(1);
+	auto& small = budget.add(1);
+	budget.update(large, 600);
+	budget.update(small, 300);
+	CHECK(budget.used() == 900);
+	CHECK(low.request == MemoryBudget::Request::None);
+
+	// The lowest priority is reduced first even though it is the smallest series
+	budget.update(low, 200);
+	CHECK(low.request == MemoryBudget::Request::Shrink);
+	CHECK(large.request == MemoryBudget::Request::None);
+	// Higher priorities are spared while the lowest did not act yet
+	budget.update(small, 400);
+	CHECK(large.request == MemoryBudget::Request::None);
+
+	// Once the lowest priority is gone, the largest series of the next one is picked
+	low.request = MemoryBudget::Request::None;
+	budget.remove(low);
+	CHECK(budget.used() == 1000);
+	budget.update(small, 500);
+	CHECK(large.request == MemoryBudget::Request::Shrink);
+	CHECK(small.request == MemoryBudget::Request::None);
+}
+
+TEST_CASE("MemoryBudget", "[Drop]") {
+	MemoryBudget budget(100);
+	auto& a = budget.add(0);
+	auto& b = budget.add(0);
+	a.exhausted = true;
+	budget.update(a, 80);
+	budget.update(b, 40);
+	CHECK(b.request == MemoryBudget::Request::Shrink); // Shrinking is preferred over dropping
+	b.request = MemoryBudget::Request::None;
+	b.exhausted = true;
+	budget.update(b, 30);
+	CHECK(a.request == MemoryBudget::Request::Drop); // Neither can shrink, so the larger one is dropped
+	CHECK(b.request == MemoryBudget::Request::None);
+	budget.remove(a);
+	CHECK(budget.used() == 30);
+}
@@ -0,0 +1,105 @@
+#include <measure/samplelog.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#if __unix__ || __APPLE__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using tirex::SampleLog;
+
+static std::vector<tirexSample> replay(const std::filesystem::path& path) {
+	std::vector<tirexSample> samples;
+	auto collect = +[](const tirexSample* sample, void* userdata) {
+		static_cast<std::vector<tirexSample>*>(userdata)->push_back(*sample);
+	};
+	REQUIRE(SampleLog::replay(path, collect, &samples));
+	return samples;
+}
+
+static tirexSample makeSample(size_t i) {
+	return {.source = TIREX_RAM_USED_PROCESS_KB, .timestampUs = i * 100, .type = TIREX_INTEGER, .value = i % 1000};
+}
+
+TEST_CASE("SampleLog", "[Replay]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-samplelog-replay.log";
+	const size_t num = SampleLog::chunkRecords + 10; // Forces the log to grow
+	{
+		auto log = SampleLog::create(path, std::chrono::system_clock::now());
+		REQUIRE(log != nullptr);
+		for (size_t i = 0; i < num; ++i)
+			REQUIRE(log->append(makeSample(i)));
+		CHECK(replay(path).empty()); // Nothing was committed yet
+		log->commit();
+		CHECK(replay(path).size() == num);
+		log->append(makeSample(num));
+	}
+	// Closing the log commits the remaining records and trims the file
+	auto samples = replay(path);
+	REQUIRE(samples.size() == num + 1);
+	for (size_t i = 0; i < samples.size(); ++i) {
+		CHECK(samples[i].source == TIREX_RAM_USED_PROCESS_KB);
+		CHECK(samples[i].timestampUs == i * 100);
+		CHECK(samples[i].value == i % 1000);
+	}
+	CHECK(std::filesystem::file_size(path) == sizeof(SampleLog::Header) + (num + 1) * sizeof(SampleLog::Record));
+
+	std::ofstream(path) << "not a sample log";
+	CHECK_FALSE(SampleLog::replay(path, +[](const tirexSample*, void*) {}, nullptr));
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("SampleLog", "[Types]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-samplelog-types.log";
+	{
+		auto log = SampleLog::create(path, std::chrono::system_clock::now());
+		REQUIRE(log != nullptr);
+		log->append(
+				{.source = TIREX_RAM_USED_PROCESS_KB, .timestampUs = 0, .type = TIREX_INTEGER, .value = 1ull << 40}
+		);
+		tirexSample temperature{.source = TIREX_CPU_TEMPERATURE_CELSIUS, .timestampUs = 10, .type = TIREX_FLOATING};
+		temperature.floating = 45.312;
+		log->append(temperature);
+	}
+	// Neither the 64-bit value nor the fractional one is truncated
+	auto samples = replay(path);
+	REQUIRE(samples.size() == 2);
+	CHECK(samples[0].type == TIREX_INTEGER);
+	CHECK(samples[0].value == 1ull << 40);
+	CHECK(samples[1].type == TIREX_FLOATING);
+	CHECK(samples[1].floating == 45.312);
+	std::filesystem::remove(path);
+}
+
+#if __unix__ || __APPLE__
+TEST_CASE("SampleLog", "[Crash]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-samplelog-crash.log";
+	auto pid = fork();
+	REQUIRE(pid >= 0);
+	if (pid == 0) {
+		// The child is killed without closing the log
+		auto log = SampleLog::create(path, std::chrono::system_clock::now());
+		for (size_t i = 0; i < 100; ++i)
+			log->append(makeSample(i));
+		log->commit();
+		log->append(makeSample(100));
+		kill(getpid(), SIGKILL);
+	}
+	int status;
+	REQUIRE(waitpid(pid, &status, 0) == pid);
+	REQUIRE(WIFSIGNALED(status));
+	auto samples = replay(path);
+	REQUIRE(samples.size() == 100);
+	CHECK(samples.back().timestampUs == 9900);
+	SampleLog::Header header;
+	std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+	CHECK((header.flags & SampleLog::closedFlag) == 0);
+	std::filesystem::remove(path);
+}
+#endif
@@ -0,0 +1,56 @@
+#include <measure/sampletable.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using Catch::Matchers::RangeEquals;
+
+using tirex::SampleTable;
+
+static std::vector<std::string> readLines(const std::filesystem::path& path) {
+	std::vector<std::string> lines;
+	std::ifstream in(path);
+	for (std::string line; std::getline(in, line);)
+		lines.push_back(line);
+	return lines;
+}
+
+static tirexSample makeSample(tirexMeasure measure, uint64_t timestampUs, uint64_t value) {
+	return {.source = measure, .timestampUs = timestampUs, .type = TIREX_INTEGER, .value = value};
+}
+
+TEST_CASE("SampleTable", "[Rows]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-sampletable-rows.csv";
+	{
+		// Ring 0 samples RAM and CPU every 10us, ring 1 samples the jitter every 20us
+		auto table = SampleTable::create(
+				path, {TIREX_RAM_USED_PROCESS_KB, TIREX_CPU_USED_PROCESS_PERCENT, TIREX_TRACKER_JITTER_US}, 2
+		);
+		REQUIRE(table != nullptr);
+		for (uint64_t ts : {0, 10, 20}) {
+			table->add(0, makeSample(TIREX_RAM_USED_PROCESS_KB, ts, 100 + ts));
+			table->add(0, makeSample(TIREX_CPU_USED_PROCESS_PERCENT, ts, ts));
+		}
+		table->add(1, makeSample(TIREX_TRACKER_JITTER_US, 0, 5));
+		table->commit();
+		// Ring 1 may still deliver more samples of its first tick and any of the later ones
+		CHECK(readLines(path).size() == 1);
+		table->add(1, makeSample(TIREX_TRACKER_JITTER_US, 20, 7));
+		table->add(1, makeSample(TIREX_TIME_START, 20, 1)); // Not a column
+		table->commit();
+		CHECK(readLines(path).size() == 3); // Both rings moved on to 20us
+
+	}
+	// The columns are ordered by the measures' values
+	auto header = "timestamp_us," + std::to_string(TIREX_CPU_USED_PROCESS_PERCENT) + "," +
+				  std::to_string(TIREX_RAM_USED_PROCESS_KB) + "," + std::to_string(TIREX_TRACKER_JITTER_US);
+	CHECK_THAT(
+			readLines(path), RangeEquals(std::vector<std::string>{header, "0,0,100,5", "10,10,110,", "20,20,120,7"})
+	);
+	std::filesystem::remove(path);
+}
@@ -33,7 +33,7 @@ TEST_CASE("Git Stats", "[Archive]") {
 					{tirexMeasure::TIREX_GIT_UNCOMMITTED_CHANGES, tirexMeasure::TIREX_GIT_UNCHECKED_FILES,
 					 tirexMeasure::TIREX_GIT_ARCHIVE_PATH, tirexMeasure::TIREX_GIT_ROOT}
 			);
-			auto info = stats.getInfo();
+			auto info = stats.getInfo(GitStats::measures);
 
 			{ // Check Git Root
 				REQUIRE(info.find(tirexMeasure::TIREX_GIT_ROOT) != info.end());
@@ -0,0 +1,111 @@
+#include <measure/stats/provider.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+using namespace tirex;
+
+/**
+ * @brief A provider whose samples are pushed by the test instead of being taken in StatsProvider::step.
+ */
+class PushProvider final : public StatsProvider {
+protected:
+	std::map<tirexMeasure, SampledMeasure> sampledMeasures() const override {
+		return {{TIREX_CPU_TEMPERATURE_CELSIUS, {TIREX_AGG_MEAN, SampleType::Double}},
+				{TIREX_RAM_USED_PROCESS_KB, {TIREX_AGG_MAX, SampleType::UInt64}}};
+	}
+
+public:
+	std::set<tirexMeasure> providedMeasures() noexcept override {
+		return {TIREX_CPU_TEMPERATURE_CELSIUS, TIREX_RAM_USED_PROCESS_KB};
+	}
+
+	template <typename T>
+	void push(tirexMeasure measure, T value, clock::time_point timestamp) {
+		record(measure, value, timestamp);
+	}
+	using StatsProvider::isEnabled;
+};
+
+TEST_CASE("StatsProvider", "[SampleTypes]") {
+	PushProvider provider;
+	provider.requestMeasures(provider.providedMeasures());
+	auto epoch = StatsProvider::clock::now();
+	SeriesConfs series{{TIREX_CPU_TEMPERATURE_CELSIUS, {.batchInterval = std::chrono::milliseconds{0}}}};
+	auto window = provider.openWindow(provider.providedMeasures(), epoch, true, series);
+	provider.push(TIREX_CPU_TEMPERATURE_CELSIUS, 45.25, epoch);
+	provider.push(TIREX_CPU_TEMPERATURE_CELSIUS, 46.5, epoch + std::chrono::milliseconds{10});
+	provider.push(TIREX_CPU_TEMPERATURE_CELSIUS, 47, epoch + std::chrono::milliseconds{20}); // Converted to a double
+	provider.push(TIREX_RAM_USED_PROCESS_KB, uint64_t{1} << 33, epoch);
+	provider.closeWindow(*window);
+
+	auto stats = window->getStats();
+	CHECK(std::holds_alternative<SeriesRef<double>>(stats.at(TIREX_CPU_TEMPERATURE_CELSIUS)));
+	CHECK(std::holds_alternative<SeriesRef<uint64_t>>(stats.at(TIREX_RAM_USED_PROCESS_KB)));
+	auto result = createMsrResultFromStats(std::move(stats));
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		std::string_view value{static_cast<const char*>(entry.value)};
+		if (entry.source == TIREX_CPU_TEMPERATURE_CELSIUS) {
+			// Neither the points nor the aggregates are truncated to integers
+			CHECK(value.find("\"max\": 47,") != std::string_view::npos);
+			CHECK(value.find("\"min\": 45.25,") != std::string_view::npos);
+			CHECK(value.find("\"values\": [45.25, 46.5, 47]") != std::string_view::npos);
+		} else {
+			CHECK(value.find("\"max\": 8589934592,") != std::string_view::npos);
+		}
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("StatsProvider", "[TimeWeighted]") {
+	PushProvider provider;
+	provider.requestMeasures(provider.providedMeasures());
+	auto epoch = StatsProvider::clock::now();
+	SeriesConfs series{{TIREX_CPU_TEMPERATURE_CELSIUS, {.storage = TIREX_SERIES_NONE}}};
+	auto window = provider.openWindow(provider.providedMeasures(), epoch, true, series);
+	// A short spike does not count as much as the values that held for most of the time
+	for (auto [value, ms] : {std::pair{10, 0}, {100, 90}, {10, 100}}) {
+		provider.push(TIREX_CPU_TEMPERATURE_CELSIUS, value, epoch + std::chrono::milliseconds{ms});
+		provider.push(TIREX_RAM_USED_PROCESS_KB, value, epoch + std::chrono::milliseconds{ms});
+	}
+	provider.closeWindow(*window);
+
+	// Measures without a time series report the running aggregates
+	auto summary = std::get<nlohmann::json>(window->peekStats().at(TIREX_CPU_TEMPERATURE_CELSIUS));
+	CHECK(summary["avg"] == 19);
+	CHECK(summary["variance"] == 729);
+
+	auto stats = window->getStats();
+	REQUIRE(std::holds_alternative<SeriesRef<uint64_t>>(stats.at(TIREX_RAM_USED_PROCESS_KB)));
+	auto result = createMsrResultFromStats(std::move(stats));
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		if (entry.source == TIREX_RAM_USED_PROCESS_KB) {
+			std::string_view value{static_cast<const char*>(entry.value)};
+			CHECK(value.find("\"avg\": 19, \"variance\": 729,") != std::string_view::npos);
+		}
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("StatsProvider", "[Enabled]") {
+	PushProvider provider;
+	provider.requestMeasures({TIREX_RAM_USED_PROCESS_KB, TIREX_GPU_USED_SYSTEM_PERCENT});
+	CHECK(provider.enabledOf(provider.providedMeasures()) == std::set{TIREX_RAM_USED_PROCESS_KB});
+	CHECK(provider.isEnabled(TIREX_RAM_USED_PROCESS_KB));
+	CHECK_FALSE(provider.isEnabled(TIREX_CPU_TEMPERATURE_CELSIUS));
+	CHECK_FALSE(provider.isEnabled(TIREX_GPU_USED_SYSTEM_PERCENT)); // Not provided
+	// The sampler narrows the measures once the subscriptions that requested them are gone
+	provider.requestMeasures({TIREX_CPU_TEMPERATURE_CELSIUS});
+	CHECK_FALSE(provider.isEnabled(TIREX_RAM_USED_PROCESS_KB));
+	CHECK(provider.isEnabled(TIREX_CPU_TEMPERATURE_CELSIUS));
+}
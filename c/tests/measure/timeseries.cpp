@@ -93,4 +93,245 @@ TEST_CASE("Timeseries", "[Limit]") {
 		REQUIRE(timeseries.size() == 3);
 		CHECK_THAT(std::get<1>(timeseries.timeseries()), RangeEquals(std::vector{3, 5, 6}));
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Timeseries", "[Flat]") {
+	// A pipeline that is composed at compile time behaves exactly like its type-erased counterpart
+	auto compare = []<typename Agg>(tirexAggregateFn agg) {
+		auto starttime = std::chrono::steady_clock::now();
+		auto dynamic = store<unsigned>(starttime) | Limit(8, agg) | Batched(10ms, agg, 4);
+		auto composed = erase(flat<unsigned>(starttime) | LimitBy<Agg>{8} | BatchedBy<Agg>{10ms, 4});
+		for (unsigned i = 0; i < 100; ++i) {
+			dynamic.addValue((i * 7) % 13, std::chrono::milliseconds{i * 3});
+			composed.addValue((i * 7) % 13, std::chrono::milliseconds{i * 3});
+		}
+		CHECK_THAT(std::get<0>(composed.timeseries()), RangeEquals(std::get<0>(dynamic.timeseries())));
+		CHECK_THAT(std::get<1>(composed.timeseries()), RangeEquals(std::get<1>(dynamic.timeseries())));
+		CHECK(composed.maxValue() == dynamic.maxValue());
+		CHECK(composed.minValue() == dynamic.minValue());
+		CHECK(composed.avgValue() == dynamic.avgValue());
+	};
+	compare.operator()<agg::Max>(TIREX_AGG_MAX);
+	compare.operator()<agg::Min>(TIREX_AGG_MIN);
+	compare.operator()<agg::Mean>(TIREX_AGG_MEAN);
+
+	auto last = agg::visit(TIREX_AGG_NO, []<typename Agg>() {
+		return erase(flat<unsigned>(std::chrono::steady_clock::now()) | LimitBy<Agg>{4});
+	});
+	for (unsigned i = 0; i < 5; ++i)
+		last.addValue(i, std::chrono::milliseconds{i});
+	CHECK_THAT(std::get<1>(last.timeseries()), RangeEquals(std::vector{1, 3, 4}));
+}
+
+TEST_CASE("Timeseries", "[Compressed]") {
+	// Compressed time series store exactly the same points as uncompressed ones
+	auto compare = []<typename T>(auto&& valueOf) {
+		auto starttime = std::chrono::steady_clock::now();
+		auto plain = store<T>(starttime) | Limit(64, TIREX_AGG_MAX) | Batched(10ms, TIREX_AGG_MAX, 16);
+		auto packed = compressed<T>(starttime) | Limit(64, TIREX_AGG_MAX) | Batched(10ms, TIREX_AGG_MAX, 16);
+		for (unsigned i = 0; i < 1000; ++i) {
+			auto timestamp = std::chrono::milliseconds{i * 3 + (i % 7 == 0 ? 5000 : 0)};
+			plain.addValue(valueOf(i), timestamp);
+			packed.addValue(valueOf(i), timestamp);
+		}
+		REQUIRE(packed.size() == plain.size());
+		CHECK_THAT(std::get<0>(packed.timeseries()), RangeEquals(std::get<0>(plain.timeseries())));
+		CHECK_THAT(std::get<1>(packed.timeseries()), RangeEquals(std::get<1>(plain.timeseries())));
+		CHECK(packed.maxValue() == plain.maxValue());
+		CHECK(packed.minValue() == plain.minValue());
+		CHECK(packed.avgValue() == plain.avgValue());
+	};
+	compare.operator()<unsigned>([](unsigned i) { return (i * 7919) % 1000; });
+	compare.operator()<uint64_t>([](unsigned i) { return (i % 2 == 0) ? uint64_t{i} : ~uint64_t{0} - i; });
+	compare.operator()<double>([](unsigned i) { return (i % 3 == 0) ? 1.5 : -static_cast<double>(i) / 7.0; });
+
+	// An hour of samples every 10ms takes a few bytes per point
+	auto packed = erase(flatCompressed<double>(std::chrono::steady_clock::now()));
+	const size_t num = 360000;
+	for (size_t i = 0; i < num; ++i)
+		packed.addValue(42.0 + (i / 1000) * 0.5, std::chrono::milliseconds{i * 10});
+	REQUIRE(packed.size() == num);
+	CHECK(packed.memoryUsage() < num);
+	CHECK(std::get<0>(packed.timeseries()).back() == std::chrono::milliseconds{(num - 1) * 10});
+	CHECK(std::get<1>(packed.timeseries()).back() == 42.0 + 359 * 0.5);
+}
+
+TEST_CASE("Timeseries", "[Downsample]") {
+	auto starttime = std::chrono::steady_clock::now();
+	auto dynamic = compressed<unsigned>(starttime) | Downsample{64};
+	auto composed = erase(flat<unsigned>(starttime) | Downsample{64});
+	for (unsigned i = 0; i < 10000; ++i) {
+		auto value = (i == 5003) ? 1000 : i % 10 + 1;
+		dynamic.addValue(value, std::chrono::milliseconds{i});
+		composed.addValue(value, std::chrono::milliseconds{i});
+		REQUIRE(dynamic.size() <= 64);
+	}
+	CHECK(dynamic.size() > 32);
+	const auto& [timepoints, values] = dynamic.timeseries();
+	CHECK(std::is_sorted(timepoints.begin(), timepoints.end()));
+	CHECK(timepoints.back() > 9500ms); // Within the bucket that is currently filled
+	// The spike survives and so does the range of the remaining values
+	CHECK(std::ranges::count(values, 1000u) == 1);
+	CHECK(std::ranges::count(values, 1u) > 10);
+	CHECK(std::ranges::count(values, 10u) > 10);
+	CHECK(dynamic.maxValue() == 1000);
+	CHECK(dynamic.minValue() == 1);
+	CHECK(dynamic.avgValue() == 5);
+	CHECK_THAT(std::get<0>(composed.timeseries()), RangeEquals(timepoints));
+	CHECK_THAT(std::get<1>(composed.timeseries()), RangeEquals(values));
+
+	// Downsampling on export keeps the spike as well
+	std::vector<std::chrono::milliseconds> exportTimepoints;
+	std::vector<unsigned> exportValues;
+	for (unsigned i = 0; i < 1000; ++i) {
+		exportTimepoints.emplace_back(i);
+		exportValues.emplace_back((i == 501) ? 1000 : 5);
+	}
+	auto [downTimepoints, downValues] = downsample(std::tuple{exportTimepoints, exportValues}, 100);
+	CHECK(downTimepoints.size() <= 100);
+	CHECK(std::ranges::count(downValues, 1000u) == 1);
+	CHECK(std::is_sorted(downTimepoints.begin(), downTimepoints.end()));
+	auto [sameTimepoints, _] = downsample(std::tuple{exportTimepoints, exportValues}, 1000);
+	CHECK(sameTimepoints.size() == 1000);
+
+	// Shrinking merges the buckets like the downsampling does and keeps at most half as many points from then on
+	auto before = composed.size();
+	composed.shrink();
+	CHECK(composed.size() <= before / 2 + 2);
+	CHECK(std::ranges::count(std::get<1>(composed.timeseries()), 1000u) == 1);
+	for (unsigned i = 10000; i < 20000; ++i) {
+		composed.addValue(i % 10 + 1, std::chrono::milliseconds{i});
+		REQUIRE(composed.size() <= 32);
+	}
+	CHECK(composed.maxValue() == 1000);
+}
+
+TEST_CASE("Timeseries", "[Quantiles]") {
+	// The quantiles cover all values, not only the ones that are kept
+	auto starttime = std::chrono::steady_clock::now();
+	auto dynamic = store<unsigned>(starttime) | Downsample{16} | Quantiles{};
+	auto composed = erase(flatCompressed<unsigned>(starttime) | Downsample{16} | Quantiles{});
+	for (unsigned i = 1; i <= 1000; ++i) {
+		dynamic.addValue(i, std::chrono::milliseconds{i});
+		composed.addValue(i, std::chrono::milliseconds{i});
+	}
+	REQUIRE(dynamic.sketch() != nullptr);
+	REQUIRE(composed.sketch() != nullptr);
+	CHECK(dynamic.sketch()->count() == 1000);
+	CHECK(std::abs(dynamic.sketch()->quantile(0.5) - 500) <= 5);
+	CHECK(std::abs(dynamic.sketch()->quantile(0.99) - 990) <= 10);
+	CHECK(composed.sketch()->quantile(0.9) == dynamic.sketch()->quantile(0.9));
+	CHECK(store<unsigned>().sketch() == nullptr);
+}
+
+TEST_CASE("Timeseries", "[Rollup]") {
+	auto starttime = std::chrono::steady_clock::now();
+	std::vector<Resolution> resolutions{{10ms, 10}, {100ms, 10}, {1000ms, 4}};
+	auto timeseries = rollup<unsigned>(starttime, resolutions, TIREX_AGG_MAX);
+	auto composed = erase(flatRollup<unsigned>(starttime, resolutions, TIREX_AGG_MAX));
+	// Values 0, 1, 2, ... every 5ms, i.e., two per slot of the finest ring
+	for (unsigned i = 0; i < 400; ++i) {
+		timeseries.addValue(i, std::chrono::milliseconds{i * 5});
+		composed.addValue(i, std::chrono::milliseconds{i * 5});
+	}
+	// The finest ring covers the last 100ms, the next ring the 1s before, and the coarsest ring everything older
+	const auto& [timepoints, values] = timeseries.timeseries();
+	REQUIRE(timeseries.size() == timepoints.size());
+	CHECK(timepoints.size() <= 24);
+	CHECK(std::is_sorted(timepoints.begin(), timepoints.end()));
+	CHECK(timepoints.front() == 0ms);
+	CHECK_THAT(
+			std::vector(timepoints.end() - 10, timepoints.end()),
+			RangeEquals(std::vector{1900ms, 1910ms, 1920ms, 1930ms, 1940ms, 1950ms, 1960ms, 1970ms, 1980ms, 1990ms})
+	);
+	CHECK_THAT(std::vector(values.end() - 3, values.end()), RangeEquals(std::vector<unsigned>{395, 397, 399}));
+	CHECK(timepoints[timepoints.size() - 11] == 1800ms);
+	CHECK(values[values.size() - 11] == 379);
+	CHECK(timeseries.maxValue() == 399);
+	CHECK(timeseries.avgValue() == 199);
+	CHECK_THAT(std::get<0>(composed.timeseries()), RangeEquals(timepoints));
+	CHECK_THAT(std::get<1>(composed.timeseries()), RangeEquals(values));
+
+	// The coarsest ring coarsens instead of dropping the oldest slots, so the start remains covered
+	for (unsigned i = 400; i < 4000; ++i)
+		timeseries.addValue(i, std::chrono::milliseconds{i * 5});
+	CHECK(timeseries.size() <= 24);
+	CHECK(std::get<0>(timeseries.timeseries()).front() == 0ms);
+	CHECK(std::get<1>(timeseries.timeseries()).front() > 0);
+
+	// The mean of a slot considers the latest value even if it was updated
+	auto mean = rollup<unsigned>(starttime, {{10ms, 4}});
+	mean.addValue(2, 0ms);
+	mean.addValue(3, 1ms);
+	mean.updateLast(6);
+	CHECK_THAT(std::get<1>(mean.timeseries()), RangeEquals(std::vector<unsigned>{4}));
+}
+
+TEST_CASE("Timeseries", "[Rate]") {
+	auto starttime = std::chrono::steady_clock::now();
+	auto dynamic = store<uint64_t>(starttime) | Rate{};
+	auto composed = erase(flat<uint64_t>(starttime) | Rate{});
+	for (auto* timeseries : {&dynamic, &composed}) {
+		timeseries->addValue(0, 0ms); // Has no predecessor and thus no rate
+		timeseries->addValue(1000, 100ms);
+		timeseries->addValue(3000, 200ms);
+		timeseries->addValue(3500, 200ms); // Updates the previous value
+		timeseries->addValue(3500, 400ms);
+		timeseries->addValue(500, 500ms); // The counter was reset
+		const auto& [timepoints, values] = timeseries->timeseries();
+		CHECK_THAT(timepoints, RangeEquals(std::vector{100ms, 200ms, 400ms, 500ms}));
+		CHECK_THAT(values, RangeEquals(std::vector<uint64_t>{10000, 25000, 0, 5000}));
+	}
+	auto perMinute = store<uint64_t>(starttime) | Rate{1min};
+	perMinute.addValue(0, 0ms);
+	perMinute.addValue(10, 1s);
+	CHECK_THAT(std::get<1>(perMinute.timeseries()), RangeEquals(std::vector<uint64_t>{600}));
+}
+
+TEST_CASE("Timeseries", "[Integrate]") {
+	// Watts into joules
+	auto timeseries = store<double>() | Integrate{};
+	timeseries.addValue(10, 0ms);
+	timeseries.addValue(10, 1000ms);
+	timeseries.addValue(20, 2000ms);
+	timeseries.addValue(10, 2500ms);
+	timeseries.updateLast(20);
+	const auto& [timepoints, values] = timeseries.timeseries();
+	CHECK_THAT(timepoints, RangeEquals(std::vector{0ms, 1000ms, 2000ms, 2500ms}));
+	CHECK_THAT(values, RangeEquals(std::vector<double>{0, 10, 25, 35}));
+}
+
+TEST_CASE("Timeseries", "[Ewma]") {
+	// The average does not depend on how often the values arrive
+	auto sparse = store<double>() | Ewma{100ms};
+	auto dense = erase(flat<double>(std::chrono::steady_clock::now()) | Ewma{100ms});
+	sparse.addValue(0, 0ms);
+	dense.addValue(0, 0ms);
+	sparse.addValue(8, 100ms);
+	dense.addValue(8, 100ms);
+	dense.addValue(8, 200ms);
+	sparse.addValue(8, 300ms);
+	dense.addValue(8, 300ms);
+	CHECK_THAT(std::get<1>(sparse.timeseries()), RangeEquals(std::vector<double>{0, 4, 7}));
+	CHECK_THAT(std::get<1>(dense.timeseries()), RangeEquals(std::vector<double>{0, 4, 6, 7}));
+}
+
+TEST_CASE("Timeseries", "[TimeWeighted]") {
+	auto starttime = std::chrono::steady_clock::now();
+	auto dynamic = store<double>(starttime) | TimeWeighted{};
+	auto composed = erase(flatCompressed<double>(starttime) | TimeWeighted{});
+	for (auto* timeseries : {&dynamic, &composed}) {
+		timeseries->addValue(10, 0ms);
+		CHECK(timeseries->avgValue() == 10); // A single value has not held for any time
+		// A short spike in between densely sampled values does not dominate the mean
+		timeseries->addValue(100, 10ms);
+		timeseries->addValue(10, 20ms);
+		timeseries->addValue(10, 1000ms);
+		REQUIRE(timeseries->moments() != nullptr);
+		CHECK(timeseries->moments()->duration == 1000);
+		CHECK(std::abs(timeseries->avgValue() - 10.9) < 1e-9);
+		CHECK(std::abs(timeseries->moments()->variance() - 80.19) < 1e-9);
+		CHECK(timeseries->maxValue() == 100);
+		CHECK(std::get<1>(timeseries->timeseries()).size() == 4);
+	}
+	CHECK(store<double>().moments() == nullptr);
+}
@@ -0,0 +1,91 @@
+#include <measure/utils/adaptiverate.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+using tirex::utils::AdaptiveRate;
+
+static void configure(AdaptiveRate& rate, std::vector<AdaptiveRate::Trigger> triggers = {}) {
+	rate.configure({.minInterval = 10ms, .maxInterval = 800ms, .tolerance = 0.05, .triggers = std::move(triggers)});
+	rate.setBase(100ms);
+}
+
+TEST_CASE("AdaptiveRate", "[Disabled]") {
+	AdaptiveRate rate;
+	rate.setBase(100ms);
+	CHECK(!rate.enabled());
+	rate.configure({.minInterval = 10ms, .maxInterval = 50ms, .tolerance = 0.05, .triggers = {}});
+	CHECK(rate.enabled());
+	CHECK(rate.interval() == 50ms); // The base interval is clamped to the bounds
+	rate.setBase(0us);
+	CHECK(!rate.enabled());
+}
+
+TEST_CASE("AdaptiveRate", "[Stable]") {
+	AdaptiveRate rate;
+	configure(rate);
+	auto now = AdaptiveRate::clock::now();
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1000}}, now);
+	CHECK(rate.interval() == 100ms); // Nothing to compare to yet
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1010}}, now += 100ms);
+	CHECK(rate.interval() == 200ms);
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1000}}, now += 200ms);
+	CHECK(rate.interval() == 400ms);
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1000}}, now += 400ms);
+	CHECK(rate.interval() == 800ms);
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1000}}, now += 800ms);
+	CHECK(rate.interval() == 800ms); // Bounded by the maximum
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 2000}}, now += 800ms);
+	CHECK(rate.interval() == 100ms); // Back to the base interval once the samples change
+}
+
+TEST_CASE("AdaptiveRate", "[Triggers]") {
+	AdaptiveRate::Trigger rise{
+			.measure = TIREX_RAM_USED_PROCESS_KB, .condition = TIREX_TRIGGER_RISE, .threshold = 1000, .hold = 50ms
+	};
+	AdaptiveRate::Trigger idle{
+			.measure = TIREX_CPU_USED_PROCESS_PERCENT, .condition = TIREX_TRIGGER_BELOW, .threshold = 10, .hold = 0ms
+	};
+	AdaptiveRate rate;
+	configure(rate, {rise, idle});
+	auto now = AdaptiveRate::clock::now();
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1000}, {TIREX_CPU_USED_PROCESS_PERCENT, 90}}, now);
+	// Grows by 500KB/s, which does not fire the trigger
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 1050}, {TIREX_CPU_USED_PROCESS_PERCENT, 90}}, now += 100ms);
+	CHECK(rate.interval() == 200ms);
+	// Grows by 5000KB/s
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 2050}, {TIREX_CPU_USED_PROCESS_PERCENT, 90}}, now += 200ms);
+	CHECK(rate.interval() == 10ms);
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 2050}, {TIREX_CPU_USED_PROCESS_PERCENT, 90}}, now += 10ms);
+	CHECK(rate.interval() == 10ms); // The hold time did not pass yet
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 2050}, {TIREX_CPU_USED_PROCESS_PERCENT, 90}}, now += 50ms);
+	CHECK(rate.interval() == 200ms);
+	rate.observe({{TIREX_RAM_USED_PROCESS_KB, 2050}, {TIREX_CPU_USED_PROCESS_PERCENT, 5}}, now += 200ms);
+	CHECK(rate.interval() == 10ms);
+}
+
+TEST_CASE("AdaptiveRate", "[Merge]") {
+	AdaptiveRate::Trigger rise{
+			.measure = TIREX_RAM_USED_PROCESS_KB, .condition = TIREX_TRIGGER_RISE, .threshold = 1000, .hold = 50ms
+	};
+	AdaptiveRate::Trigger idle{
+			.measure = TIREX_CPU_USED_PROCESS_PERCENT, .condition = TIREX_TRIGGER_BELOW, .threshold = 10, .hold = 0ms
+	};
+	auto merged = AdaptiveRate::merge(
+			{{.minInterval = 10ms, .maxInterval = 800ms, .tolerance = 0.05, .triggers = {rise}},
+			 {.minInterval = 50ms, .maxInterval = 200ms, .tolerance = 0.1, .triggers = {rise, idle}}}
+	);
+	CHECK(merged.minInterval == 10ms);
+	CHECK(merged.maxInterval == 200ms);
+	CHECK(merged.tolerance == 0.05);
+	CHECK(merged.triggers == std::vector<AdaptiveRate::Trigger>{rise, idle});
+
+	AdaptiveRate rate;
+	rate.configure(merged);
+	rate.setBase(100ms);
+	CHECK(rate.enabled());
+	rate.disable();
+	CHECK(!rate.enabled());
+	CHECK(rate.interval() == 100ms);
+}
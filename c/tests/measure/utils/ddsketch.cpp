@@ -0,0 +1,63 @@
+#include <measure/utils/ddsketch.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+using tirex::utils::DDSketch;
+
+/** @brief Whether \p value deviates from \p expected by at most the relative error of a DDSketch with 1% accuracy. */
+static bool withinError(double value, double expected) {
+	return std::abs(value - expected) <= std::abs(expected) * 0.01 + 1e-9;
+}
+
+TEST_CASE("DDSketch", "[Empty]") {
+	DDSketch sketch;
+	CHECK(sketch.count() == 0);
+	CHECK(sketch.quantile(0.5) == 0.0);
+}
+
+TEST_CASE("DDSketch", "[RelativeError]") {
+	DDSketch sketch;
+	for (int i = 1; i <= 100000; ++i)
+		sketch.add(i);
+	CHECK(sketch.count() == 100000);
+	CHECK(sketch.quantile(0.0) == 1.0);
+	CHECK(sketch.quantile(1.0) == 100000.0);
+	CHECK(withinError(sketch.quantile(0.5), 50000));
+	CHECK(withinError(sketch.quantile(0.9), 90000));
+	CHECK(withinError(sketch.quantile(0.99), 99000));
+	CHECK(sketch.memoryUsage() < 8 * 1024);
+
+	// Negative values and zeros are ordered before the positive ones
+	DDSketch mixed;
+	for (int i = -50; i <= 49; ++i)
+		mixed.add(i * 10);
+	CHECK(mixed.quantile(0.0) == -500.0);
+	CHECK(withinError(mixed.quantile(0.25), -260));
+	CHECK(mixed.quantile(0.51) == 0.0);
+	CHECK(withinError(mixed.quantile(0.75), 240));
+}
+
+TEST_CASE("DDSketch", "[Merge]") {
+	DDSketch all, low, high;
+	for (int i = 1; i <= 1000; ++i) {
+		all.add(i);
+		(i <= 500 ? low : high).add(i);
+	}
+	low.merge(high);
+	CHECK(low.count() == all.count());
+	for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 1.0})
+		CHECK(low.quantile(q) == all.quantile(q));
+}
+
+TEST_CASE("DDSketch", "[Bounded]") {
+	// Only the lowest quantiles lose accuracy once the bins are merged
+	DDSketch sketch(0.01, 64);
+	for (int i = 0; i < 20; ++i)
+		sketch.add(std::pow(10.0, i % 10));
+	CHECK(sketch.memoryUsage() <= 64 * sizeof(uint64_t));
+	CHECK(sketch.quantile(1.0) == 1e9);
+	CHECK(withinError(sketch.quantile(0.95), 1e9));
+	CHECK(sketch.quantile(0.0) == 1.0);
+}
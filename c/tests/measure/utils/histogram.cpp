@@ -0,0 +1,65 @@
+#include <measure/utils/histogram.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+
+/** @brief Whether \p value deviates from \p expected by at most the relative error guaranteed by LogHistogram<4>. */
+static bool withinError(double value, double expected) { return std::abs(value - expected) <= expected / 16; }
+
+TEST_CASE("LogHistogram", "[Empty]") {
+	tirex::utils::LogHistogram<> histogram;
+	CHECK(histogram.count() == 0);
+	CHECK(histogram.min() == 0);
+	CHECK(histogram.max() == 0);
+	CHECK(histogram.mean() == 0.0);
+	CHECK(histogram.quantile(0.5) == 0.0);
+}
+
+TEST_CASE("LogHistogram", "[Small]") {
+	// Values below 2^SubBits are exact
+	tirex::utils::LogHistogram<> histogram;
+	for (uint64_t i = 1; i <= 9; ++i)
+		histogram.record(i);
+	CHECK(histogram.count() == 9);
+	CHECK(histogram.sum() == 45);
+	CHECK(histogram.min() == 1);
+	CHECK(histogram.max() == 9);
+	CHECK(histogram.mean() == 5.0);
+	CHECK(histogram.quantile(0.0) == 1.0);
+	CHECK(histogram.quantile(0.5) == 5.0);
+	CHECK(histogram.quantile(1.0) == 9.0);
+}
+
+TEST_CASE("LogHistogram", "[RelativeError]") {
+	tirex::utils::LogHistogram<> histogram;
+	for (uint64_t i = 1; i <= 100000; ++i)
+		histogram.record(i * 1000);
+	CHECK(histogram.count() == 100000);
+	CHECK(histogram.min() == 1000);
+	CHECK(histogram.max() == 100000000);
+	CHECK(withinError(histogram.quantile(0.5), 50000000));
+	CHECK(withinError(histogram.quantile(0.9), 90000000));
+	CHECK(withinError(histogram.quantile(0.99), 99000000));
+	CHECK(histogram.quantile(1.0) == 100000000.0);
+
+	histogram.record(UINT64_MAX); // The largest value still has a bucket
+	CHECK(histogram.max() == UINT64_MAX);
+}
+
+TEST_CASE("LogHistogram", "[Since]") {
+	tirex::utils::LogHistogram<> histogram;
+	for (uint64_t i = 1; i <= 1000; ++i)
+		histogram.record(i);
+	auto before = histogram.snapshot();
+	for (uint64_t i = 2000; i <= 3000; ++i)
+		histogram.record(i);
+	auto diff = histogram.snapshot().since(before);
+	CHECK(diff.count == 1001);
+	CHECK(diff.sum == 2502500);
+	CHECK(diff.min >= 1000); // Only bounded by the bucket since the overall minimum did not change
+	CHECK(diff.min <= 2000);
+	CHECK(diff.max == 3000);
+	CHECK(withinError(diff.quantile(0.5), 2500));
+	CHECK(histogram.snapshot().since(histogram.snapshot()).count == 0);
+}
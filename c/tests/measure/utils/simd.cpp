@@ -0,0 +1,69 @@
+#include <measure/utils/simd.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_range_equals.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using Catch::Matchers::RangeEquals;
+
+namespace simd = tirex::utils::simd;
+
+template <typename T>
+static std::vector<T> randomValues(size_t num, std::mt19937_64& rng) {
+	std::vector<T> values(num);
+	for (auto& value : values) // Large values such that the means overflow for integers
+		value = static_cast<T>(rng() >> ((sizeof(T) == 4) ? 32 : 0));
+	return values;
+}
+
+// The sizes cover vectors that do not fill a single register, that fill several, and a remainder of each length
+TEMPLATE_TEST_CASE("SIMD", "[MinMax]", uint32_t, uint64_t, double) {
+	std::mt19937_64 rng(42);
+	for (size_t num = 1; num < 70; ++num) {
+		auto values = randomValues<TestType>(num, rng);
+		auto [min, max] = simd::minMax(std::span<const TestType>(values));
+		CHECK(min == *std::min_element(values.begin(), values.end()));
+		CHECK(max == *std::max_element(values.begin(), values.end()));
+	}
+}
+
+TEMPLATE_TEST_CASE("SIMD", "[Pairwise]", uint32_t, uint64_t, double) {
+	std::mt19937_64 rng(42);
+	for (size_t num = 0; num < 70; ++num) {
+		auto values = randomValues<TestType>(num, rng);
+		std::vector<TestType> max, min, mean;
+		for (size_t i = 0; i + 1 < num; i += 2) {
+			max.push_back(std::max(values[i], values[i + 1]));
+			min.push_back(std::min(values[i], values[i + 1]));
+			mean.push_back((values[i] + values[i + 1]) / 2);
+		}
+		std::vector<TestType> out(num / 2);
+		simd::pairwise(std::span<const TestType>(values), out.data(), simd::Pairwise::Max);
+		CHECK_THAT(out, RangeEquals(max));
+		simd::pairwise(std::span<const TestType>(values), out.data(), simd::Pairwise::Min);
+		CHECK_THAT(out, RangeEquals(min));
+		// In place
+		simd::pairwise(std::span<const TestType>(values), values.data(), simd::Pairwise::Mean);
+		CHECK_THAT(std::vector(values.begin(), values.begin() + static_cast<ptrdiff_t>(num / 2)), RangeEquals(mean));
+	}
+}
+
+TEST_CASE("SIMD", "[Deltas]") {
+	std::vector<std::chrono::milliseconds> timepoints;
+	std::vector<int64_t> expected;
+	for (int64_t i = 0, time = 100; i < 37; ++i) {
+		auto delta = (i % 5 == 0) ? -3 : i;
+		time += delta;
+		timepoints.emplace_back(time);
+		expected.push_back((i == 0) ? time - 90 : delta);
+	}
+	std::vector<int64_t> out(timepoints.size());
+	simd::deltas(timepoints, std::chrono::milliseconds{90}, out.data());
+	CHECK_THAT(out, RangeEquals(expected));
+}
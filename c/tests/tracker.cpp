@@ -3,7 +3,15 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
 
 #include <iostream>
 
@@ -29,4 +37,519 @@ TEST_CASE("Tracker", "[Archive]") {
 		tirexResultFree(result);
 		CHECK_FALSE(std::filesystem::exists(static_cast<const char*>(entry.value)));
 	}
-}
\ No newline at end of file
+}
+TEST_CASE("Tracker", "[Jitter]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_TRACKER_MISSED_DEADLINES, TIREX_AGG_NO}, tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingUs(conf, 5000, &handle) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		CHECK((entry.source == TIREX_TRACKER_JITTER_US || entry.source == TIREX_TRACKER_MISSED_DEADLINES));
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[ProviderInterval]") {
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	CHECK(tirexTrackingConfSetPollInterval(trackingConf, 0) == tirexError::TIREX_INVALID_ARGUMENT);
+	CHECK(tirexTrackingConfSetProviderInterval(trackingConf, "nonexistent", 1000) ==
+		  tirexError::TIREX_INVALID_ARGUMENT);
+	REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 5000) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetProviderInterval(trackingConf, "tracker", 1000) == tirexError::TIREX_SUCCESS);
+
+	tirexMeasureConf conf[]{{TIREX_TRACKER_MISSED_DEADLINES, TIREX_AGG_NO}, tirexNullConf};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	CHECK(entrynum == 1);
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[Series]") {
+	for (auto storage : {TIREX_SERIES_COMPRESSED, TIREX_SERIES_PLAIN, TIREX_SERIES_ROLLUP, TIREX_SERIES_NONE}) {
+		tirexTrackingConf* trackingConf;
+		REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+		CHECK(tirexTrackingConfSetSeries(trackingConf, TIREX_TRACKER_JITTER_US, 0, 4, storage) ==
+			  tirexError::TIREX_INVALID_ARGUMENT);
+		REQUIRE(tirexTrackingConfSetSeries(trackingConf, TIREX_TRACKER_JITTER_US, 0, 64, storage) ==
+				tirexError::TIREX_SUCCESS);
+		REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 1000) == tirexError::TIREX_SUCCESS);
+
+		tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MEAN}, tirexNullConf};
+		tirexMeasureHandle* handle;
+		REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+		tirexTrackingConfFree(trackingConf);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		tirexResult* result;
+		REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+		size_t entrynum;
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+		REQUIRE(entrynum == 1);
+		REQUIRE(tirexResultEntryGetByIndex(result, 0, &entry) == tirexError::TIREX_SUCCESS);
+		// Without a stored time series, only the aggregates are reported
+		std::string_view value{static_cast<const char*>(entry.value)};
+		CHECK((value.find("timeseries") == std::string_view::npos) == (storage == TIREX_SERIES_NONE));
+		tirexResultFree(result);
+	}
+}
+
+TEST_CASE("Tracker", "[MemoryBudget]") {
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 1000) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetSeriesPriority(trackingConf, TIREX_TRACKER_JITTER_US, 1) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetMemoryBudget(trackingConf, 1) == tirexError::TIREX_SUCCESS);
+
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	// The series does not fit into the budget, so it was dropped but its aggregates are still reported
+	size_t entrynum;
+	tirexResultEntry entry;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 1);
+	REQUIRE(tirexResultEntryGetByIndex(result, 0, &entry) == tirexError::TIREX_SUCCESS);
+	std::string_view value{static_cast<const char*>(entry.value)};
+	CHECK(value.find("timeseries") == std::string_view::npos);
+	CHECK(value.find("max") != std::string_view::npos);
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[AdaptiveOverlapping]") {
+	// The monitor thread takes a jitter sample whenever it polls the tracker's provider, which both handles share
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	std::array<tirexTrackingConf*, 2> trackingConfs;
+	std::array<size_t, 2> maxIntervalUs{2000, 100000};
+	std::array<tirexMeasureHandle*, 2> handles;
+	for (size_t i = 0; i < 2; ++i) {
+		REQUIRE(tirexTrackingConfCreate(&trackingConfs[i]) == tirexError::TIREX_SUCCESS);
+		REQUIRE(tirexTrackingConfSetPollInterval(trackingConfs[i], 1000) == tirexError::TIREX_SUCCESS);
+		REQUIRE(tirexTrackingConfSetAdaptive(trackingConfs[i], maxIntervalUs[i] / 2, maxIntervalUs[i], 0.01) ==
+				tirexError::TIREX_SUCCESS);
+		REQUIRE(tirexStartTrackingWithConf(conf, trackingConfs[i], &handles[i]) == tirexError::TIREX_SUCCESS);
+		tirexTrackingConfFree(trackingConfs[i]);
+	}
+	std::atomic<size_t> numSamples = 0;
+	auto count = +[](const tirexSample*, void* userdata) { ++*static_cast<std::atomic<size_t>*>(userdata); };
+	REQUIRE(tirexSetSampleCallback(handles[0], count, &numSamples) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	// The second handle's bounds (50 to 100ms) must not override the first one's (at most 2ms)
+	CHECK(numSamples > 10);
+	for (auto handle : handles) {
+		tirexResult* result;
+		REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+		tirexResultFree(result);
+	}
+}
+
+TEST_CASE("Tracker", "[Overlapping]") {
+	tirexMeasureConf outerConf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	tirexMeasureConf innerConf[]{{TIREX_TRACKER_MISSED_DEADLINES, TIREX_AGG_NO}, tirexNullConf};
+	tirexMeasureHandle* outer;
+	tirexMeasureHandle* inner;
+	REQUIRE(tirexStartTrackingUs(outerConf, 5000, &outer) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexStartTrackingUs(innerConf, 1000, &inner) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	tirexResult* outerResult;
+	tirexResult* innerResult;
+	REQUIRE(tirexStopTracking(outer, &outerResult) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	REQUIRE(tirexStopTracking(inner, &innerResult) == tirexError::TIREX_SUCCESS);
+
+	// Each handle only reports the measures it requested although both share the same provider
+	for (auto [result, measure] : {std::pair{outerResult, TIREX_TRACKER_JITTER_US},
+								   std::pair{innerResult, TIREX_TRACKER_MISSED_DEADLINES}}) {
+		size_t entrynum;
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+		REQUIRE(entrynum == 1);
+		REQUIRE(tirexResultEntryGetByIndex(result, 0, &entry) == tirexError::TIREX_SUCCESS);
+		CHECK(entry.source == measure);
+		tirexResultFree(result);
+	}
+}
+
+TEST_CASE("Tracker", "[Peek]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_TRACKER_MISSED_DEADLINES, TIREX_AGG_NO}, tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingUs(conf, 1000, &handle) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	for (int i = 0; i < 2; ++i) {
+		tirexResult* result;
+		REQUIRE(tirexPeekTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+		size_t entrynum;
+		REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+		CHECK(entrynum == 2);
+		for (size_t j = 0; j < entrynum; ++j) {
+			tirexResultEntry entry;
+			REQUIRE(tirexResultEntryGetByIndex(result, j, &entry) == tirexError::TIREX_SUCCESS);
+			// Peeking only reports the aggregates and not the time series
+			if (entry.source == TIREX_TRACKER_JITTER_US) {
+				std::string_view value{static_cast<const char*>(entry.value)};
+				CHECK(value.find("timeseries") == std::string_view::npos);
+			}
+		}
+		tirexResultFree(result);
+	}
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[SampleCallback]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_TRACKER_DROPPED_SAMPLES, TIREX_AGG_NO}, tirexNullConf
+	};
+	struct {
+		std::atomic<size_t> jitter = 0;
+		std::atomic<size_t> other = 0;
+	} numSamples;
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingUs(conf, 1000, &handle) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexSetSampleCallback(
+					handle,
+					+[](const tirexSample* sample, void* userdata) {
+						// The callback runs on another thread, so the checks are done afterwards
+						auto counts = static_cast<decltype(numSamples)*>(userdata);
+						++((sample->source == TIREX_TRACKER_JITTER_US) ? counts->jitter : counts->other);
+					},
+					&numSamples
+			) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+	// All samples are delivered by the time tirexStopTracking returns
+	CHECK(numSamples.jitter > 0);
+	CHECK(numSamples.other == 0);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		if (entry.source == TIREX_TRACKER_DROPPED_SAMPLES)
+			CHECK(std::string_view{static_cast<const char*>(entry.value)} == "0");
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[SampleLog]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-tracker-test.samplelog";
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 1000) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetSampleLog(trackingConf, path.string().c_str()) == tirexError::TIREX_SUCCESS);
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	auto count = +[](const tirexSample* sample, void* userdata) {
+		CHECK(sample->source == TIREX_TRACKER_JITTER_US);
+		++*static_cast<size_t*>(userdata);
+	};
+	size_t streamed = 0, logged = 0;
+
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	REQUIRE(tirexSetSampleCallback(handle, count, &streamed) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	// The log is readable while the measurement is still running and holds the samples committed by the past ticks
+	CHECK(tirexSampleLogReplay(path.string().c_str(), count, &logged) == tirexError::TIREX_SUCCESS);
+	CHECK(logged > 0);
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+	tirexResultFree(result);
+
+	logged = 0;
+	REQUIRE(tirexSampleLogReplay(path.string().c_str(), count, &logged) == tirexError::TIREX_SUCCESS);
+	CHECK(logged > 0);
+	CHECK(logged >= streamed); // The log also contains the samples taken before the callback was set
+	std::filesystem::remove(path);
+	CHECK(tirexSampleLogReplay(path.string().c_str(), count, &logged) == tirexError::TIREX_INVALID_ARGUMENT);
+}
+
+TEST_CASE("Tracker", "[SampleLogSlowCallback]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-tracker-slow.samplelog";
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 1000) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetSampleLog(trackingConf, path.string().c_str()) == tirexError::TIREX_SUCCESS);
+	// Every sample becomes a point of the series, which is short enough to be reported in full
+	REQUIRE(tirexTrackingConfSetSeries(trackingConf, TIREX_TRACKER_JITTER_US, 0, 4096, TIREX_SERIES_PLAIN) ==
+			tirexError::TIREX_SUCCESS);
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	auto slow = +[](const tirexSample*, void* userdata) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		++*static_cast<size_t*>(userdata);
+	};
+	size_t streamed = 0, logged = 0;
+
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	REQUIRE(tirexSetSampleCallback(handle, slow, &streamed) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	// Replacing the callback waits for the slow callback to catch up while the samples keep being recorded
+	REQUIRE(tirexSetSampleCallback(handle, slow, &streamed) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	tirexResultEntry entry;
+	REQUIRE(tirexResultEntryGetByIndex(result, 0, &entry) == tirexError::TIREX_SUCCESS);
+	std::string_view value{static_cast<const char*>(entry.value)};
+	auto values = value.substr(value.find("\"values\": ["));
+	auto recorded = std::count(values.begin(), values.end(), ',') + 1;
+	REQUIRE(recorded < 300); // Otherwise, the reported series would be downsampled
+	tirexResultFree(result);
+
+	auto count = +[](const tirexSample*, void* userdata) { ++*static_cast<size_t*>(userdata); };
+	REQUIRE(tirexSampleLogReplay(path.string().c_str(), count, &logged) == tirexError::TIREX_SUCCESS);
+	CHECK(logged == static_cast<size_t>(recorded));
+	CHECK(streamed <= logged);
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Tracker", "[SampleTable]") {
+	auto path = std::filesystem::temp_directory_path() / "tirex-tracker-test.csv";
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetPollInterval(trackingConf, 2000) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetSampleTable(trackingConf, path.string().c_str()) == tirexError::TIREX_SUCCESS);
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_RAM_USED_PROCESS_KB, TIREX_AGG_MAX}, tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+	tirexResultFree(result);
+
+	std::ifstream in(path);
+	std::string line;
+	REQUIRE(std::getline(in, line));
+	CHECK(line == "timestamp_us," + std::to_string(TIREX_RAM_USED_PROCESS_KB) + "," +
+						  std::to_string(TIREX_TRACKER_JITTER_US));
+	size_t rows = 0, complete = 0;
+	long long previous = -1;
+	while (std::getline(in, line)) {
+		++rows;
+		auto timestamp = std::stoll(line.substr(0, line.find(',')));
+		CHECK(timestamp > previous); // Each tick is a single row
+		previous = timestamp;
+		// Both providers are polled in the same ticks, so their samples share the timestamps
+		complete += (line.find(",,") == std::string::npos && line.back() != ',') ? 1 : 0;
+	}
+	CHECK(rows > 0);
+	CHECK(complete > 0);
+	in.close();
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("Tracker", "[Spans]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_TRACKER_SPANS, TIREX_AGG_NO}, tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingUs(conf, 1000, &handle) == tirexError::TIREX_SUCCESS);
+	CHECK(tirexSpanEnd(handle) == tirexError::TIREX_INVALID_ARGUMENT);
+	REQUIRE(tirexSpanBegin(handle, "outer") == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexSpanBegin(handle, "inner") == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	REQUIRE(tirexSpanEnd(handle) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexSpanEnd(handle) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexSpanBegin(handle, "unterminated") == tirexError::TIREX_SUCCESS);
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		if (entry.source == TIREX_TRACKER_SPANS) {
+			std::string_view spans{static_cast<const char*>(entry.value)};
+			CHECK(spans.starts_with(R"([{"children":[{"children":[],"measures":{"52":)"));
+			CHECK(spans.find(R"("name":"unterminated")") != std::string_view::npos);
+		}
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[Overhead]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX},
+			{TIREX_TRACKER_CPU_TIME_US, TIREX_AGG_NO},
+			{TIREX_TRACKER_STEP_LATENCY_US, TIREX_AGG_NO},
+			{TIREX_TRACKER_SYSCALLS_PER_TICK, TIREX_AGG_NO},
+			{TIREX_TRACKER_MEMORY_KB, TIREX_AGG_NO},
+			tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingUs(conf, 1000, &handle) == tirexError::TIREX_SUCCESS);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+#if __linux__
+	CHECK(entrynum == 5);
+#else
+	CHECK(entrynum == 4); // The system calls can only be counted on Linux
+#endif
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		if (entry.source == TIREX_TRACKER_STEP_LATENCY_US) {
+			std::string_view latencies{static_cast<const char*>(entry.value)};
+			CHECK(latencies.starts_with(R"({"tracker":{"count":)"));
+		} else if (entry.source == TIREX_TRACKER_MEMORY_KB) {
+			CHECK(std::string_view{static_cast<const char*>(entry.value)} != "0"); // The jitter's time series
+		}
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[Isolation]") {
+	tirexTrackingConf* trackingConf;
+	REQUIRE(tirexTrackingConfCreate(&trackingConf) == tirexError::TIREX_SUCCESS);
+	CHECK(tirexTrackingConfSetSchedPolicy(trackingConf, TIREX_SCHED_IDLE, 5) == tirexError::TIREX_INVALID_ARGUMENT);
+	CHECK(tirexTrackingConfSetTimerSlack(trackingConf, 0) == tirexError::TIREX_INVALID_ARGUMENT);
+	size_t cpus[]{0};
+	REQUIRE(tirexTrackingConfSetCpuAffinity(trackingConf, cpus, 1) == tirexError::TIREX_SUCCESS);
+	// Unlike TIREX_SCHED_FIFO, switching to TIREX_SCHED_IDLE does not require any privileges
+	REQUIRE(tirexTrackingConfSetSchedPolicy(trackingConf, TIREX_SCHED_IDLE, 0) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexTrackingConfSetTimerSlack(trackingConf, 1000) == tirexError::TIREX_SUCCESS);
+
+	tirexMeasureConf conf[]{
+			{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, {TIREX_TRACKER_ISOLATION, TIREX_AGG_NO}, tirexNullConf
+	};
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithConf(conf, trackingConf, &handle) == tirexError::TIREX_SUCCESS);
+	tirexTrackingConfFree(trackingConf);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		if (entry.source == TIREX_TRACKER_ISOLATION) {
+			std::string_view isolation{static_cast<const char*>(entry.value)};
+			CHECK(isolation.starts_with(R"({"cpus":[0],)"));
+			CHECK(isolation.find(R"("policy":"idle")") != std::string_view::npos);
+		}
+	}
+	tirexResultFree(result);
+}
+
+TEST_CASE("Tracker", "[Region]") {
+	tirexMeasureConf conf[]{
+			{TIREX_TIME_ELAPSED_WALL_CLOCK_MS, TIREX_AGG_NO}, {TIREX_TIME_ELAPSED_USER_MS, TIREX_AGG_NO}, tirexNullConf
+	};
+	tirexRegion* region;
+	REQUIRE(tirexRegionCreate(conf, &region) == tirexError::TIREX_SUCCESS);
+	auto work = [region] {
+		for (int i = 0; i < 1000; ++i) {
+			tirexRegionScope scope;
+			REQUIRE(tirexRegionEnter(region, &scope) == tirexError::TIREX_SUCCESS);
+			REQUIRE(tirexRegionExit(region, &scope) == tirexError::TIREX_SUCCESS);
+		}
+	};
+	std::thread other(work);
+	work();
+	other.join();
+
+	tirexResult* result;
+	REQUIRE(tirexRegionGetResult(region, &result) == tirexError::TIREX_SUCCESS);
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	REQUIRE(entrynum == 2);
+	for (size_t i = 0; i < entrynum; ++i) {
+		tirexResultEntry entry;
+		REQUIRE(tirexResultEntryGetByIndex(result, i, &entry) == tirexError::TIREX_SUCCESS);
+		std::string_view value{static_cast<const char*>(entry.value)};
+		CHECK(value.starts_with(R"({"count":2000,"max":)"));
+		CHECK(value.find(R"("p99":)") != std::string_view::npos);
+	}
+	tirexResultFree(result);
+	tirexRegionFree(region);
+}
+
+TEST_CASE("Tracker", "[Context]") {
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	tirexContext* context;
+	REQUIRE(tirexContextCreate(conf, nullptr, &context) == tirexError::TIREX_SUCCESS);
+	tirexResult* info;
+	REQUIRE(tirexContextFetchInfo(context, &info) == tirexError::TIREX_SUCCESS);
+	tirexResultFree(info);
+
+	// Many measurements (also concurrent ones) can be started from the same context
+	tirexMeasureHandle* outer;
+	REQUIRE(tirexContextStartTracking(context, &outer) == tirexError::TIREX_SUCCESS);
+	for (int i = 0; i < 3; ++i) {
+		tirexMeasureHandle* handle;
+		REQUIRE(tirexContextStartTracking(context, &handle) == tirexError::TIREX_SUCCESS);
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		tirexResult* result;
+		REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+		size_t entrynum;
+		REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+		CHECK(entrynum == 1);
+		tirexResultFree(result);
+	}
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(outer, &result) == tirexError::TIREX_SUCCESS);
+	tirexResultFree(result);
+	tirexContextFree(context);
+}
+
+TEST_CASE("Tracker", "[WithInfo]") {
+	tirexMeasureConf conf[]{{TIREX_TRACKER_JITTER_US, TIREX_AGG_MAX}, tirexNullConf};
+	tirexResult* info;
+	tirexMeasureHandle* handle;
+	REQUIRE(tirexStartTrackingWithInfo(conf, nullptr, &info, &handle) == tirexError::TIREX_SUCCESS);
+	// The info is complete once the measurement is started
+	size_t entrynum;
+	REQUIRE(tirexResultEntryNum(info, &entrynum) == tirexError::TIREX_SUCCESS);
+	CHECK(entrynum == 0);
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	tirexResult* result;
+	REQUIRE(tirexStopTracking(handle, &result) == tirexError::TIREX_SUCCESS);
+	REQUIRE(tirexResultEntryNum(result, &entrynum) == tirexError::TIREX_SUCCESS);
+	CHECK(entrynum == 1);
+	tirexResultFree(result);
+	tirexResultFree(info);
+}
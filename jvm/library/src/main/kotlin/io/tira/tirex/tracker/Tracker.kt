@@ -80,6 +80,16 @@ enum class Measure(val value: Int) {
     GIT_UNCHECKED_FILES(43), //
     GIT_ROOT(46), //
     GIT_ARCHIVE_PATH(47), //
+    TRACKER_JITTER_US(52), //
+    TRACKER_MISSED_DEADLINES(53), //
+    TRACKER_STEP_OVERRUNS(54), //
+    TRACKER_DROPPED_SAMPLES(55), //
+    TRACKER_SPANS(56), //
+    TRACKER_CPU_TIME_US(57), //
+    TRACKER_STEP_LATENCY_US(58), //
+    TRACKER_SYSCALLS_PER_TICK(59), //
+    TRACKER_MEMORY_KB(60), //
+    TRACKER_ISOLATION(61), //
     JAVA_VERSION(2001),
     JAVA_VERSION_DATE(2002), //
     JAVA_VENDOR(2003), //
@@ -118,7 +128,7 @@ private const val INVALID_MEASURE = -1
 val ALL_MEASURES = Measure.entries.toSet()
 
 enum class Aggregation(val value: Int) {
-    NO(1 shl 0), MAX(1 shl 1), MIN(1 shl 2), MEAN(1 shl 3);
+    NO(1 shl 1), MAX(1 shl 2), MIN(1 shl 3), MEAN(1 shl 4);
 
     companion object {
         internal fun fromValue(value: Int): Aggregation {
@@ -475,6 +485,13 @@ private interface TrackerLibrary : Library {
         measures: Array<NativeMeasureConfiguration>, pollIntervalMs: LibCAPI.size_t, handle: Pointer
     ): Int
 
+    fun tirexStartTrackingWithInfo(
+        measures: Array<NativeMeasureConfiguration>, conf: Pointer, info: Pointer, handle: Pointer
+    ): Int
+
+    fun tirexTrackingConfCreate(conf: Pointer): Int
+    fun tirexTrackingConfFree(conf: Pointer)
+    fun tirexTrackingConfSetPollInterval(conf: Pointer, pollIntervalUs: LibCAPI.size_t): Int
     fun tirexStopTracking(handle: Pointer, result: Pointer): Int
     fun tirexSetLogCallback(callback: NativeLogCallback)
     fun tirexDataProviderGetAll(buffer: Array<NativeProviderInfo>?, bufferSize: LibCAPI.size_t): LibCAPI.size_t
@@ -637,19 +654,24 @@ class TrackingHandle private constructor(
             // Prepare the measure configurations.
             val configArray = prepareMeasureConfigurations(remainingMeasures)
 
-            // Get other info, first, before starting the tracking.
-            val fetchInfoResult: Pointer = usePointer { resultPointer ->
-                val errorInt = LIBRARY.tirexFetchInfo(configArray, resultPointer)
-                handleError(errorInt)
-                resultPointer.getPointer(0)
+            // Get other info and start the tracking (using the same provider instances for both).
+            val conf = usePointer { confPointer ->
+                handleError(LIBRARY.tirexTrackingConfCreate(confPointer))
+                confPointer.getPointer(0)
             }
-
-            // Start the tracking.
-            val trackingHandle = usePointer { measurementHandlePointer ->
-                val errorInt =
-                    LIBRARY.tirexStartTracking(configArray, LibCAPI.size_t(pollIntervalMillis), measurementHandlePointer)
-                handleError(errorInt)
-                measurementHandlePointer.getPointer(0)
+            val (fetchInfoResult, trackingHandle) = try {
+                handleError(LIBRARY.tirexTrackingConfSetPollInterval(conf, LibCAPI.size_t(pollIntervalMillis * 1000)))
+                usePointer { resultPointer ->
+                    usePointer { measurementHandlePointer ->
+                        val errorInt = LIBRARY.tirexStartTrackingWithInfo(
+                            configArray, conf, resultPointer, measurementHandlePointer
+                        )
+                        handleError(errorInt)
+                        resultPointer.getPointer(0) to measurementHandlePointer.getPointer(0)
+                    }
+                }
+            } finally {
+                LIBRARY.tirexTrackingConfFree(conf)
             }
 
             return TrackingHandle(
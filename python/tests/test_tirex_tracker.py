@@ -1,4 +1,5 @@
 from faulthandler import enable as faulthandler_enable
+from json import loads
 from pathlib import Path
 from tempfile import TemporaryDirectory
 from time import sleep
@@ -10,6 +11,7 @@ from tirex_tracker import (
     Measure,
     ResultEntry,
     ResultType,
+    TrackingContext,
     fetch_info,
     measure_infos,
     provider_infos,
@@ -18,6 +20,7 @@ from tirex_tracker import (
     stop_tracking,
     track,
     tracked,
+    tracked_region,
     tracking,
 )
 
@@ -162,6 +165,36 @@ def test_measure_using_function_decorator() -> None:
     assert time_elapsed > 0.0
 
 
+def test_measure_using_context() -> None:
+    with TrackingContext([Measure.TIME_ELAPSED_WALL_CLOCK_MS, Measure.PYTHON_VERSION]) as context:
+        for _ in range(3):
+            with tracking(context=context) as actual:
+                sleep(0.01)
+            assert Measure.TIME_ELAPSED_WALL_CLOCK_MS in actual
+            assert Measure.PYTHON_VERSION in actual
+            assert float(actual[Measure.TIME_ELAPSED_WALL_CLOCK_MS].value) > 0.0
+
+
+def test_measure_using_region_decorator() -> None:
+    @tracked_region([Measure.TIME_ELAPSED_WALL_CLOCK_MS])
+    def sleep_briefly() -> None:
+        sleep(0.001)
+
+    for _ in range(100):
+        sleep_briefly()
+
+    actual = sleep_briefly.results  # type: ignore
+
+    assert isinstance(actual, Mapping)
+    assert Measure.TIME_ELAPSED_WALL_CLOCK_MS in actual
+    result_entry = actual[Measure.TIME_ELAPSED_WALL_CLOCK_MS]
+    assert result_entry.value is not None
+    summary = loads(result_entry.value)
+    assert summary["count"] == 100
+    assert summary["min"] >= 1.0
+    assert summary["min"] <= summary["p50"] <= summary["p99"] <= summary["max"]
+
+
 def test_tracking_export_ir_metadata() -> None:
     with TemporaryDirectory() as tmp_dir:
         tmp_dir_path = Path(tmp_dir)
@@ -2,6 +2,7 @@ from __future__ import annotations
 
 import zipfile
 from collections import defaultdict
+from contextlib import contextmanager
 from ctypes import CFUNCTYPE, c_char_p, c_int, c_size_t, pointer
 from dataclasses import dataclass
 from enum import Enum
@@ -56,9 +57,13 @@ from ._utils.library import (
     ResultEntry,
     _MeasureConfiguration,
     _MeasureInfo,
+    _Context,
     _ProviderInfo,
+    _Region,
+    _RegionScope,
     _Result,
     _ResultEntry,
+    _TrackingConfiguration,
     _TrackingHandle,
     provider_version,
 )
@@ -311,6 +316,53 @@ def fetch_info(
     }
 
 
+@contextmanager
+def _tracking_configuration(poll_intervall_ms: int) -> Iterator["Pointer[_TrackingConfiguration]"]:
+    conf_pointer = pointer(pointer(_TrackingConfiguration()))
+    _handle_error(_LIBRARY.tirexTrackingConfCreate(conf_pointer))
+    try:
+        _handle_error(_LIBRARY.tirexTrackingConfSetPollInterval(conf_pointer.contents, poll_intervall_ms * 1000))
+        yield conf_pointer.contents
+    finally:
+        _LIBRARY.tirexTrackingConfFree(conf_pointer.contents)
+
+
+class TrackingContext(ContextManager["TrackingContext"]):
+    """
+    Initializes the data providers once and keeps them initialized for many measurements (e.g., one per batch), such
+    that starting a measurement does not have to initialize them again. The static information (e.g., about the git
+    repository, the hardware, or the installed Python packages) is collected once as well. Pass the context to
+    `tracking` (or `TrackingHandle.start`) to use it.
+    """
+
+    measures: Collection[Measure]
+    _python_info: Mapping[Measure, ResultEntry]
+    _context: "Pointer[_Context]"
+
+    def __init__(self, measures: Iterable[Measure] = ALL_MEASURES, poll_intervall_ms: int = 100) -> None:
+        self.measures = tuple(measures)
+        self._python_info, native_measures = _get_python_info(measures=self.measures)
+        configs_array = _prepare_measure_configurations(native_measures)
+
+        with _tracking_configuration(poll_intervall_ms) as conf:
+            context_pointer = pointer(pointer(_Context()))
+            error_int = _LIBRARY.tirexContextCreate(configs_array, conf, context_pointer)
+            _handle_error(error_int)
+        self._context = context_pointer.contents
+
+    def close(self) -> None:
+        """Deinitializes the data providers. Measurements must not be started from the context anymore."""
+        if hasattr(self, "_context"):
+            _LIBRARY.tirexContextFree(self._context)
+            del self._context
+
+    def __del__(self) -> None:
+        self.close()
+
+    def __exit__(self, exc_type, exc_value, traceback) -> None:
+        self.close()
+
+
 @dataclass(frozen=True)
 class TrackingHandle(ContextManager["TrackingHandle"], Mapping[Measure, ResultEntry]):
     _fetch_info_result: "Pointer[_Result]"
@@ -333,26 +385,39 @@ class TrackingHandle(ContextManager["TrackingHandle"], Mapping[Measure, ResultEn
         system_description: Optional[str] = None,
         export_file_path: Optional[PathLike] = None,
         export_format: Optional[ExportFormat] = None,
+        context: Optional[TrackingContext] = None,
     ) -> Self:
+        # A context determines the measures and the poll interval.
+        if context is not None:
+            measures = context.measures
+
         # Get Python info first, and then strip Python measures from the list.
-        python_info, measures = _get_python_info(measures=measures, export_file_path=export_file_path)
+        if context is not None and export_file_path is None:
+            python_info = context._python_info
+            measures = {measure for measure in measures if measure not in _PYTHON_MEASURES}
+        else:
+            python_info, measures = _get_python_info(measures=measures, export_file_path=export_file_path)
 
         # Prepare the measure configurations.
         configs_array = _prepare_measure_configurations(measures)
 
-        # Get other info, first, before starting the tracking.
-        result_pointer = pointer(pointer(_Result()))
-        error_int = _LIBRARY.tirexFetchInfo(configs_array, result_pointer)
-        _handle_error(error_int)
-        fetch_info_result = result_pointer.contents
-
         # Instate the error handler
         error_handle = _init_error_handling()
 
-        # Start the tracking.
+        # Get other info and start the tracking (using the same provider instances for both).
+        result_pointer = pointer(pointer(_Result()))
         tracking_handle_pointer = pointer(pointer(_TrackingHandle()))
-        error_int = _LIBRARY.tirexStartTracking(configs_array, poll_intervall_ms, tracking_handle_pointer)
+        if context is not None:
+            error_int = _LIBRARY.tirexContextFetchInfo(context._context, result_pointer)
+            _handle_error(error_int)
+            error_int = _LIBRARY.tirexContextStartTracking(context._context, tracking_handle_pointer)
+        else:
+            with _tracking_configuration(poll_intervall_ms) as conf:
+                error_int = _LIBRARY.tirexStartTrackingWithInfo(
+                    configs_array, conf, result_pointer, tracking_handle_pointer
+                )
         _handle_error(error_int)
+        fetch_info_result = result_pointer.contents
         tracking_handle = tracking_handle_pointer.contents
 
         return cls(
@@ -596,6 +661,7 @@ def tracking(
     system_description: Optional[str] = None,
     export_file_path: Optional[PathLike] = None,
     export_format: Optional[ExportFormat] = None,
+    context: Optional[TrackingContext] = None,
 ) -> TrackingHandle:
     return TrackingHandle.start(
         measures=measures,
@@ -604,6 +670,7 @@ def tracking(
         system_description=system_description,
         export_file_path=None if export_file_path is None else Path(export_file_path),
         export_format=export_format,
+        context=context,
     )
 
 
@@ -707,6 +774,107 @@ def tracked(
         return decorator
 
 
+REGION_MEASURES: Collection[Measure] = (
+    Measure.TIME_ELAPSED_WALL_CLOCK_MS,
+    Measure.TIME_ELAPSED_USER_MS,
+    Measure.TIME_ELAPSED_SYSTEM_MS,
+)
+"""
+The measures that are accumulated by `tracked_region` per default. `Measure.CPU_ENERGY_SYSTEM_JOULES` is supported as
+well (on Linux with RAPL) but must be requested explicitly.
+"""
+
+
+class RegionHandle(Mapping[Measure, ResultEntry]):
+    """
+    Accumulates the elapsed time (and optionally CPU energy) of all calls of a code region without starting any data
+    providers or threads. Each measure maps to a JSON object with the number of calls (`count`) and the `mean`, `min`,
+    `max`, `p50`, `p90`, and `p99` of the per-call values. The results are read anew on every access.
+    """
+
+    _region: "Pointer[_Region]"
+
+    def __init__(self, measures: Iterable[Measure] = REGION_MEASURES) -> None:
+        configs_array = _prepare_measure_configurations(measures)
+        region_pointer = pointer(pointer(_Region()))
+        error_int = _LIBRARY.tirexRegionCreate(configs_array, region_pointer)
+        _handle_error(error_int)
+        self._region = region_pointer.contents
+
+    def __del__(self) -> None:
+        if hasattr(self, "_region"):
+            _LIBRARY.tirexRegionFree(self._region)
+
+    def enter(self) -> _RegionScope:
+        scope = _RegionScope()
+        _LIBRARY.tirexRegionEnter(self._region, pointer(scope))
+        return scope
+
+    def exit(self, scope: _RegionScope) -> None:
+        _LIBRARY.tirexRegionExit(self._region, pointer(scope))
+
+    @property
+    def results(self) -> Mapping[Measure, ResultEntry]:
+        result_pointer = pointer(pointer(_Result()))
+        error_int = _LIBRARY.tirexRegionGetResult(self._region, result_pointer)
+        _handle_error(error_int)
+        return _parse_results(result_pointer.contents)
+
+    def __len__(self) -> int:
+        return len(self.results)
+
+    def __iter__(self) -> Iterator[Measure]:
+        return iter(self.results)
+
+    def __getitem__(self, key) -> ResultEntry:
+        return self.results[key]
+
+
+@overload
+def tracked_region(f_or_measures: Callable[P, T]) -> Union[Callable[P, T], ResultsAccessor]:
+    pass
+
+
+@overload
+def tracked_region(
+    f_or_measures: Iterable[Measure] = REGION_MEASURES,
+) -> Callable[[Callable[P, T]], Union[Callable[P, T], ResultsAccessor]]:
+    pass
+
+
+def tracked_region(
+    f_or_measures: Union[Callable[P, T], Iterable[Measure]] = REGION_MEASURES,
+) -> Union[
+    Union[Callable[P, T], ResultsAccessor],
+    Callable[[Callable[P, T]], Union[Callable[P, T], ResultsAccessor]],
+]:
+    """
+    A lightweight alternative to `tracked` for functions that are called very often. Instead of a full measurement per
+    call, the calls are accumulated into one `RegionHandle`, which is available as the `results` of the decorated
+    function.
+    """
+
+    def decorator(f: Callable[P, T], measures: Iterable[Measure]) -> Union[Callable[P, T], ResultsAccessor]:
+        region = RegionHandle(measures)
+
+        @wraps(f)
+        def wrapper(*args, **kwds):
+            scope = region.enter()
+            try:
+                return f(*args, **kwds)
+            finally:
+                region.exit(scope)
+
+        results_wrapper = cast(Union[Callable[P, T], ResultsAccessor], wrapper)
+        results_wrapper.results = region  # type: ignore
+        return results_wrapper
+
+    if callable(f_or_measures):
+        return decorator(f_or_measures, REGION_MEASURES)
+    measures = f_or_measures
+    return lambda f: decorator(f, measures)
+
+
 def clear_metadata_register() -> None:
     global _REGISTERED_METADATA
     _REGISTERED_METADATA = {}
@@ -61,6 +61,16 @@ class Measure(IntEnum):
     GIT_ROOT = 46
     GIT_ARCHIVE_PATH = 47
     DEVCONTAINER_CONF_PATHS = 50
+    TRACKER_JITTER_US = 52
+    TRACKER_MISSED_DEADLINES = 53
+    TRACKER_STEP_OVERRUNS = 54
+    TRACKER_DROPPED_SAMPLES = 55
+    TRACKER_SPANS = 56
+    TRACKER_CPU_TIME_US = 57
+    TRACKER_STEP_LATENCY_US = 58
+    TRACKER_SYSCALLS_PER_TICK = 59
+    TRACKER_MEMORY_KB = 60
+    TRACKER_ISOLATION = 61
     PYTHON_VERSION = 1000
     # 1001 was used in previous versions of the library.
     # 1002 was used in previous versions of the library.
@@ -83,10 +93,10 @@ ALL_MEASURES = set(Measure)
 
 
 class Aggregation(IntEnum):
-    NO = 1 << 0
-    MAX = 1 << 1
-    MIN = 1 << 2
-    MEAN = 1 << 3
+    NO = 1 << 1
+    MAX = 1 << 2
+    MIN = 1 << 3
+    MEAN = 1 << 4
 
 
 INVALID_AGGREGATION = -1
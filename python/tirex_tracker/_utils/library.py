@@ -1,6 +1,6 @@
 import platform as _platform_module
 import sys
-from ctypes import CDLL, POINTER, Structure, c_char_p, c_int, c_size_t, c_void_p, cdll
+from ctypes import CDLL, POINTER, Structure, c_char_p, c_int, c_size_t, c_uint64, c_void_p, cdll
 from importlib import resources
 from json import dumps
 from pathlib import Path
@@ -21,6 +21,27 @@ class _TrackingHandle(Structure):
     _fields_ = []
 
 
+class _TrackingConfiguration(Structure):
+    _fields_ = []
+
+
+class _Context(Structure):
+    _fields_ = []
+
+
+class _Region(Structure):
+    _fields_ = []
+
+
+class _RegionScope(Structure):
+    _fields_ = [
+        ("wallNs", c_uint64),
+        ("userNs", c_uint64),
+        ("systemNs", c_uint64),
+        ("energyUj", c_uint64),
+    ]
+
+
 class MeasureConfiguration(NamedTuple):
     measure: Measure
     aggregation: Aggregation
@@ -153,11 +174,34 @@ class _TirexTrackerLibrary(CDLL):
     tirexResultFree: Callable[["Pointer[_Result]"], None]
     tirexFetchInfo: Callable[["Array[_MeasureConfiguration]", "Pointer[Pointer[_Result]]"], int]
     tirexStartTracking: Callable[["Array[_MeasureConfiguration]", int, "Pointer[Pointer[_TrackingHandle]]"], int]
+    tirexStartTrackingWithInfo: Callable[
+        [
+            "Array[_MeasureConfiguration]",
+            "Pointer[_TrackingConfiguration]",
+            "Pointer[Pointer[_Result]]",
+            "Pointer[Pointer[_TrackingHandle]]",
+        ],
+        int,
+    ]
     tirexStopTracking: Callable[["Pointer[_TrackingHandle]", "Pointer[Pointer[_Result]]"], int]
     tirexSetLogCallback: Callable[["Optional[CFunctionType]"], None]
     tirexDataProviderGetAll: Callable[["Array[_ProviderInfo]", int], int]
     tirexMeasureInfoGet: Callable[[int, "Pointer[Pointer[_MeasureInfo]]"], int]
     tirexResultExportIrMetadata: Callable[["Pointer[_Result]", "Pointer[_Result]", c_char_p], int]
+    tirexTrackingConfCreate: Callable[["Pointer[Pointer[_TrackingConfiguration]]"], int]
+    tirexTrackingConfFree: Callable[["Pointer[_TrackingConfiguration]"], None]
+    tirexTrackingConfSetPollInterval: Callable[["Pointer[_TrackingConfiguration]", int], int]
+    tirexContextCreate: Callable[
+        ["Array[_MeasureConfiguration]", "Pointer[_TrackingConfiguration]", "Pointer[Pointer[_Context]]"], int
+    ]
+    tirexContextFetchInfo: Callable[["Pointer[_Context]", "Pointer[Pointer[_Result]]"], int]
+    tirexContextStartTracking: Callable[["Pointer[_Context]", "Pointer[Pointer[_TrackingHandle]]"], int]
+    tirexContextFree: Callable[["Pointer[_Context]"], None]
+    tirexRegionCreate: Callable[["Array[_MeasureConfiguration]", "Pointer[Pointer[_Region]]"], int]
+    tirexRegionEnter: Callable[["Pointer[_Region]", "Pointer[_RegionScope]"], int]
+    tirexRegionExit: Callable[["Pointer[_Region]", "Pointer[_RegionScope]"], int]
+    tirexRegionGetResult: Callable[["Pointer[_Region]", "Pointer[Pointer[_Result]]"], int]
+    tirexRegionFree: Callable[["Pointer[_Region]"], None]
 
 
 def __get_library() -> ContextManager[Path]:
@@ -209,6 +253,13 @@ def _load_library() -> _TirexTrackerLibrary:
         POINTER(POINTER(_TrackingHandle)),
     ]
     library.tirexStartTracking.restype = c_int
+    library.tirexStartTrackingWithInfo.argtypes = [
+        POINTER(_MeasureConfiguration),
+        POINTER(_TrackingConfiguration),
+        POINTER(POINTER(_Result)),
+        POINTER(POINTER(_TrackingHandle)),
+    ]
+    library.tirexStartTrackingWithInfo.restype = c_int
     library.tirexStopTracking.argtypes = [
         POINTER(_TrackingHandle),
         POINTER(POINTER(_Result)),
@@ -226,6 +277,46 @@ def _load_library() -> _TirexTrackerLibrary:
         c_char_p,
     ]
     library.tirexResultExportIrMetadata.restype = c_int
+    library.tirexTrackingConfCreate.argtypes = [POINTER(POINTER(_TrackingConfiguration))]
+    library.tirexTrackingConfCreate.restype = c_int
+    library.tirexTrackingConfFree.argtypes = [POINTER(_TrackingConfiguration)]
+    library.tirexTrackingConfFree.restype = c_void_p
+    library.tirexTrackingConfSetPollInterval.argtypes = [POINTER(_TrackingConfiguration), c_size_t]
+    library.tirexTrackingConfSetPollInterval.restype = c_int
+    library.tirexContextCreate.argtypes = [
+        POINTER(_MeasureConfiguration),
+        POINTER(_TrackingConfiguration),
+        POINTER(POINTER(_Context)),
+    ]
+    library.tirexContextCreate.restype = c_int
+    library.tirexContextFetchInfo.argtypes = [
+        POINTER(_Context),
+        POINTER(POINTER(_Result)),
+    ]
+    library.tirexContextFetchInfo.restype = c_int
+    library.tirexContextStartTracking.argtypes = [
+        POINTER(_Context),
+        POINTER(POINTER(_TrackingHandle)),
+    ]
+    library.tirexContextStartTracking.restype = c_int
+    library.tirexContextFree.argtypes = [POINTER(_Context)]
+    library.tirexContextFree.restype = c_void_p
+    library.tirexRegionCreate.argtypes = [
+        POINTER(_MeasureConfiguration),
+        POINTER(POINTER(_Region)),
+    ]
+    library.tirexRegionCreate.restype = c_int
+    library.tirexRegionEnter.argtypes = [POINTER(_Region), POINTER(_RegionScope)]
+    library.tirexRegionEnter.restype = c_int
+    library.tirexRegionExit.argtypes = [POINTER(_Region), POINTER(_RegionScope)]
+    library.tirexRegionExit.restype = c_int
+    library.tirexRegionGetResult.argtypes = [
+        POINTER(_Region),
+        POINTER(POINTER(_Result)),
+    ]
+    library.tirexRegionGetResult.restype = c_int
+    library.tirexRegionFree.argtypes = [POINTER(_Region)]
+    library.tirexRegionFree.restype = c_void_p
     library.tirexSetAbortLevel.argtypes = [c_int]
     library.tirexSetAbortCallback.argtypes = [c_void_p]
     return cast(_TirexTrackerLibrary, library)
@@ -7,7 +7,7 @@ if is_pyterrier_installed():
     from pyterrier import Transformer
     from pyterrier.model import IterDict
 
-    from . import ExportFormat, PathLike, tracking
+    from . import ExportFormat, PathLike, TrackingContext, tracking
     from ._utils.constants import ALL_MEASURES, Measure
     from ._utils.library import ResultEntry
 
@@ -19,6 +19,7 @@ if is_pyterrier_installed():
         system_description: Final[Optional[str]]
         export_file_path: Final[Optional[PathLike]]
         export_format: Final[Optional[ExportFormat]]
+        _context: Final[TrackingContext]
         _results: Mapping[Measure, ResultEntry]
 
         def __init__(
@@ -39,6 +40,8 @@ if is_pyterrier_installed():
             self.system_description = system_description
             self.export_file_path = export_file_path
             self.export_format = export_format
+            # Initialize the providers once instead of for every batch
+            self._context = TrackingContext(measures=measures, poll_intervall_ms=poll_interval_ms)
 
         @property
         def results(self) -> Mapping[Measure, ResultEntry]:
@@ -52,6 +55,7 @@ if is_pyterrier_installed():
                 system_description=self.system_description,
                 export_file_path=self.export_file_path,
                 export_format=self.export_format,
+                context=self._context,
             ) as tracking_results:
                 results = self.transformer.transform(inp)
             self._results = tracking_results
@@ -65,6 +69,7 @@ if is_pyterrier_installed():
                 system_description=self.system_description,
                 export_file_path=self.export_file_path,
                 export_format=self.export_format,
+                context=self._context,
             ) as tracking_results:
                 results = self.transformer.transform_iter(inp)
             self._results = tracking_results
@@ -83,6 +88,7 @@ if is_pyterrier_installed():
                 system_description=self.system_description,
                 export_file_path=self.export_file_path,
                 export_format=self.export_format,
+                context=self._context,
             ) as tracking_results:
                 results = self.transformer.transform_gen(input, batch_size=batch_size, output_topics=output_topics)
             self._results = tracking_results